@@ -64,4 +64,9 @@ uint32_t reverse_bits_32(uint32_t data) {
     return result;
 }
 
+uint64_t reverse_bits_64(uint64_t data) {
+    return ((uint64_t)reverse_bits_32((uint32_t)data) << 32)
+           | reverse_bits_32((uint32_t)(data >> 32));
+}
+
 /* ----------------------------- end of file -------------------------------- */
@@ -33,8 +33,59 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
 #include "crc/crc16.h"
 #include "crc/bit_utils.h"
+#include "crc/crc_clmul.h"
+#include "crc_batch.h"
+#include "crc_cpu.h"
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Carry-less multiply folding constants of a polynomial.
+ */
+typedef struct {
+    uint16_t poly;       /*!< The polynomial */
+    uint64_t fold[2][4]; /*!< `crc_clmul_consts`, MSB-first then reflected */
+} crc16_fold_consts_t;
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           CRC16 residues, indexed by model.
+ */
+static const uint16_t crc16_residue_table[CRC16_NONE_MODEL] = {
+    0x0000, // CRC16_IBM_MODEL
+    0x4FFE, // CRC16_MAXIM_MODEL
+    0x4FFE, // CRC16_USB_MODEL
+    0x0000, // CRC16_MODBUS_MODEL
+    0x0000, // CRC16_CCITT_MODEL
+    0x0000, // CRC16_CCITT_FALSE_MODEL (big-endian trailer)
+    0x0F47, // CRC16_X25_MODEL
+    0x0000, // CRC16_XMODEM_MODEL (big-endian trailer)
+    0x993A, // CRC16_DNP_MODEL
+};
+
+/**
+ * \brief           Folding constants of the CRC16 polynomials of the models.
+ */
+static const crc16_fold_consts_t crc16_fold_consts[] = {
+    {0x8005,
+     {{0x0000000000001446, 0x0000000000008107, 0x0000000000001666,
+       0x0000000000000106},
+      {0xC450000000000000, 0x8101000000000000, 0xCCD0000000000000,
+       0xC100000000000000}}},
+    {0x1021,
+     {{0x0000000000008832, 0x00000000000013FC, 0x000000000000650B,
+       0x000000000000AEFC},
+      {0x9822000000000000, 0x7F90000000000000, 0xA95D000000000000,
+       0x7EEA000000000000}}},
+    {0x3D65,
+     {{0x000000000000D11C, 0x000000000000831E, 0x0000000000007660,
+       0x0000000000001EF8},
+      {0x7116000000000000, 0xF182000000000000, 0x0CDC000000000000,
+       0x3EF0000000000000}}},
+};
 
 /* Public functions --------------------------------------------------------- */
 void crc16_init(crc16_ctx_t* ctx, crc16_param_model_e model) {
@@ -125,6 +176,10 @@ void crc16_init(crc16_ctx_t* ctx, crc16_param_model_e model) {
 
 void crc16_update(crc16_ctx_t* ctx, const uint8_t* buf, uint32_t len) {
     uint16_t crc = ctx->init;
+    uint32_t done = crc16_fold(ctx->poly, ctx->ref_in, &crc, buf, len);
+
+    buf += done;
+    len -= done;
 
     for (uint32_t i = 0; i < len; i++) {
         uint16_t data = buf[i];
@@ -195,4 +250,129 @@ bool crc16_verify_buf(crc16_param_model_e model, const uint8_t* buf,
     return (stored_crc == calculated_crc);
 }
 
+uint16_t crc16_residue(crc16_param_model_e model) {
+    if ((uint32_t)model >= CRC16_NONE_MODEL) {
+        return 0;
+    }
+
+    return crc16_residue_table[model];
+}
+
+void crc16_verify_stream_init(crc16_stream_t* stream,
+                              crc16_param_model_e model) {
+    crc16_init(&stream->ctx, model);
+    stream->residue = crc16_residue(model);
+    stream->use_residue = stream->ctx.ref_in && stream->ctx.ref_out;
+    memset(stream->tail, 0, sizeof(stream->tail));
+    stream->len = 0;
+}
+
+void crc16_verify_stream_update(crc16_stream_t* stream, const uint8_t* buf,
+                                uint32_t len) {
+    if (stream->use_residue) {
+        crc16_update(&stream->ctx, buf, len);
+        stream->len += len;
+        return;
+    }
+
+    // Hold the last bytes back from the CRC: they may be the trailer
+    uint32_t held = stream->len < sizeof(stream->tail) ? stream->len
+                                                       : sizeof(stream->tail);
+    uint32_t total = held + len;
+    uint32_t keep = total < sizeof(stream->tail) ? total : sizeof(stream->tail);
+    uint8_t tail[sizeof(stream->tail)];
+
+    for (uint32_t i = 0; i < keep; i++) {
+        uint32_t idx = total - keep + i;
+        tail[i] = idx < held ? stream->tail[idx] : buf[idx - held];
+    }
+
+    uint32_t flush = total - keep;
+    uint32_t from_tail = flush < held ? flush : held;
+    crc16_update(&stream->ctx, stream->tail, from_tail);
+    crc16_update(&stream->ctx, buf, flush - from_tail);
+
+    memcpy(stream->tail, tail, keep);
+    stream->len += len;
+}
+
+bool crc16_verify_stream(const crc16_stream_t* stream) {
+    if (stream->len <= sizeof(uint16_t)) {
+        return false; // Not enough bytes for data and CRC
+    }
+
+    crc16_ctx_t ctx = stream->ctx; // crc16_final overwrites the running value
+
+    if (stream->use_residue) {
+        return (crc16_final(&ctx) == stream->residue);
+    }
+
+    uint16_t stored_crc = ((uint16_t)stream->tail[1] << 8) | stream->tail[0];
+    return (stored_crc == crc16_final(&ctx));
+}
+
+uint32_t crc16_verify_bufs(crc16_param_model_e model,
+                           const uint8_t* const bufs[], const uint32_t lens[],
+                           uint32_t n, uint64_t* ok_bitmap) {
+    crc_batch_model_t batch;
+
+    crc16_batch_model(&batch, model);
+
+    return crc_batch_verify(&batch, bufs, lens, n, ok_bitmap);
+}
+
+void crc16_pack_bufs(crc16_param_model_e model, uint8_t* const bufs[],
+                     const uint32_t lens[], uint32_t n) {
+    crc_batch_model_t batch;
+
+    crc16_batch_model(&batch, model);
+    crc_batch_pack(&batch, bufs, lens, n);
+}
+
+void crc16_batch_model(crc_batch_model_t* batch, crc16_param_model_e model) {
+    crc16_ctx_t ctx;
+
+    crc16_init(&ctx, model);
+    batch->init = ctx.init;
+    batch->xor_out = ctx.xor_out;
+    batch->poly = ctx.poly;
+    batch->width = 16;
+    batch->ref_in = ctx.ref_in;
+    batch->ref_out = ctx.ref_out;
+}
+
+uint32_t crc16_fold(uint16_t poly, bool ref_in, uint16_t* crc,
+                    const uint8_t* buf, uint32_t len) {
+    const crc16_fold_consts_t* consts = NULL;
+
+    if (len < CRC_CLMUL_MIN || !crc_cpu_has_clmul()) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < sizeof(crc16_fold_consts)
+                                 / sizeof(crc16_fold_consts[0]); i++) {
+        if (crc16_fold_consts[i].poly == poly) {
+            consts = &crc16_fold_consts[i];
+            break;
+        }
+    }
+    if (consts == NULL) {
+        return 0;
+    }
+
+    // The register runs MSB-first over bit-reversed bytes when the input is
+    // reflected, which is the reflected register read backwards
+    uint64_t reg = ref_in ? reverse_bits_16(*crc) : (uint64_t)*crc << 48;
+    crc16_ctx_t rem_ctx = {0};
+    uint8_t rem[16];
+    uint32_t done = crc_clmul_fold(consts->fold[ref_in], ref_in, reg, buf, len,
+                                   rem);
+
+    rem_ctx.poly = poly;
+    rem_ctx.ref_in = ref_in;
+    crc16_update(&rem_ctx, rem, sizeof(rem));
+    *crc = rem_ctx.init;
+
+    return done;
+}
+
 /* ----------------------------- end of file -------------------------------- */
@@ -33,8 +33,19 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <stddef.h>
 #include "crc/crc16_lookup.h"
 #include "crc/bit_utils.h"
+#if CRC16_LOOKUP_SLICE_MAX
+#include "crc_once.h"
+#endif
+#include "crc_batch.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of polynomials with built-in tables.
+ */
+#define CRC16_LOOKUP_POLYS 3
 
 /* Private variables -------------------------------------------------------- */
 /**
@@ -68,6 +79,55 @@ static const uint16_t crc16_poly_0x3D65_table[16] = {
     0xD64D, 0xEB28, 0xAC87, 0x91E2, 0x23D9, 0x1EBC, 0x5913, 0x6476,
 };
 
+/**
+ * \brief           Polynomials with built-in tables.
+ */
+static const uint16_t crc16_lookup_poly[CRC16_LOOKUP_POLYS] = {
+    0x8005,
+    0x1021,
+    0x3D65,
+};
+
+/**
+ * \brief           Nibble tables of `crc16_lookup_poly`.
+ */
+static const uint16_t* const crc16_nibble_table[CRC16_LOOKUP_POLYS] = {
+    crc16_poly_0x8005_table,
+    crc16_poly_0x1021_table,
+    crc16_poly_0x3D65_table,
+};
+
+#if CRC16_LOOKUP_SLICE_MAX
+/**
+ * \brief           Slicing tables by polynomial, then MSB-first or reflected.
+ *
+ * Table `k` holds the register after a byte followed by `k` zero bytes; a tier
+ * of `n` tables uses the first `n`.
+ */
+static uint16_t crc16_slice_table[CRC16_LOOKUP_POLYS][2]
+                                 [CRC16_LOOKUP_SLICE_MAX][256];
+
+/**
+ * \brief           Guard of the slicing tables build.
+ */
+static crc_once_t crc16_slice_once = CRC_ONCE_INIT;
+#endif
+
+#if CRC16_LOOKUP_SLICE > CRC16_LOOKUP_SLICE_MAX
+#error "CRC16_LOOKUP_SLICE exceeds CRC16_LOOKUP_SLICE_MAX"
+#endif
+
+/* Private function prototypes ---------------------------------------------- */
+static uint16_t lookup_slice_update(const crc16_lookup_ctx_t* ctx,
+                                    uint16_t crc, const uint8_t* buf,
+                                    uint32_t len);
+static inline uint16_t lookup_slice_run(const uint16_t* table, uint32_t n,
+                                        bool ref_in, uint16_t crc,
+                                        const uint8_t* buf, uint32_t len);
+#if CRC16_LOOKUP_SLICE_MAX
+static void lookup_slice_build(void);
+#endif
+
 /* Public functions --------------------------------------------------------- */
 void crc16_lookup_init(crc16_lookup_ctx_t* ctx,
                        crc16_lookup_param_model_e model) {
@@ -174,6 +234,38 @@ void crc16_lookup_init(crc16_lookup_ctx_t* ctx,
         ctx->table = NULL;
         break;
     }
+
+#if CRC16_LOOKUP_SLICE
+    // Move from the built-in nibble table to the default tier
+    crc16_lookup_set_tier(ctx, (crc_tier_e)CRC16_LOOKUP_SLICE);
+#endif
+}
+
+bool crc16_lookup_set_tier(crc16_lookup_ctx_t* ctx, crc_tier_e tier) {
+    if (ctx->table == NULL || !crc_tier_is_valid(tier)
+        || (uint32_t)tier > CRC16_LOOKUP_SLICE_MAX) {
+        return false;
+    }
+
+    for (uint32_t p = 0; p < CRC16_LOOKUP_POLYS; p++) {
+        if (crc16_lookup_poly[p] != ctx->poly) {
+            continue;
+        }
+
+        if (tier == CRC_TIER_NIBBLE) {
+            ctx->table = (uint16_t*)crc16_nibble_table[p];
+            ctx->table_len = 16;
+            return true;
+        }
+#if CRC16_LOOKUP_SLICE_MAX
+        crc_once(&crc16_slice_once, lookup_slice_build);
+        ctx->table = &crc16_slice_table[p][ctx->ref_in][0][0];
+        ctx->table_len = (uint16_t)(tier * 256);
+        return true;
+#endif
+    }
+
+    return false;
 }
 
 void crc16_lookup_update(crc16_lookup_ctx_t* ctx, const uint8_t* buf,
@@ -183,6 +275,15 @@ void crc16_lookup_update(crc16_lookup_ctx_t* ctx, const uint8_t* buf,
     }
 
     uint16_t crc = ctx->init;
+    uint32_t done = crc16_fold(ctx->poly, ctx->ref_in, &crc, buf, len);
+
+    buf += done;
+    len -= done;
+    if (ctx->table_len >= 256) {
+        ctx->init = lookup_slice_update(ctx, crc, buf, len);
+        return;
+    }
+
     for (uint32_t i = 0; i < len; i++) {
         uint8_t data = buf[i];
 
@@ -298,4 +399,116 @@ void crc16_generate_table(uint16_t polynomial, uint16_t table[],
     }
 }
 
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Run the register over a buffer with the slicing tables.
+ *
+ * The context register is MSB-first over bit-reversed bytes when the input is
+ * reflected; the reflected tables run it reflected instead, so that the bytes
+ * are taken as they are.
+ *
+ * \param[in]       ctx: Pointer to the CRC16 context
+ * \param[in]       crc: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static uint16_t lookup_slice_update(const crc16_lookup_ctx_t* ctx,
+                                    uint16_t crc, const uint8_t* buf,
+                                    uint32_t len) {
+    // Constant step sizes let the compiler unroll the step
+    switch (ctx->table_len / 256) {
+    case 1:
+        return lookup_slice_run(ctx->table, 1, ctx->ref_in, crc, buf, len);
+    case 4:
+        return lookup_slice_run(ctx->table, 4, ctx->ref_in, crc, buf, len);
+    case 8:
+        return lookup_slice_run(ctx->table, 8, ctx->ref_in, crc, buf, len);
+    case 16:
+        return lookup_slice_run(ctx->table, 16, ctx->ref_in, crc, buf, len);
+    default:
+        return lookup_slice_run(ctx->table, ctx->table_len / 256, ctx->ref_in,
+                                crc, buf, len);
+    }
+}
+
+/**
+ * \brief           Slicing loop of `lookup_slice_update` for `n` tables.
+ *
+ * \param[in]       table: The slicing tables
+ * \param[in]       n: Number of tables, the bytes taken per step; with a
+ *                  single table every byte goes through the byte loop
+ * \param[in]       ref_in: Whether the tables are reflected
+ * \param[in]       crc: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static inline uint16_t lookup_slice_run(const uint16_t* table, uint32_t n,
+                                        bool ref_in, uint16_t crc,
+                                        const uint8_t* buf, uint32_t len) {
+    const uint16_t(*t)[256] = (const uint16_t(*)[256])table;
+
+    if (ref_in) {
+        crc = reverse_bits_16(crc);
+        for (; n >= 2 && len >= n; len -= n, buf += n) {
+            uint16_t next = t[n - 1][buf[0] ^ (crc & 0xFF)]
+                            ^ t[n - 2][buf[1] ^ (crc >> 8)];
+
+            for (uint32_t k = 2; k < n; k++) {
+                next ^= t[n - 1 - k][buf[k]];
+            }
+            crc = next;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            crc = (crc >> 8) ^ t[0][(crc ^ buf[i]) & 0xFF];
+        }
+
+        return reverse_bits_16(crc);
+    }
+
+    for (; n >= 2 && len >= n; len -= n, buf += n) {
+        uint16_t next = t[n - 1][buf[0] ^ (crc >> 8)]
+                        ^ t[n - 2][buf[1] ^ (crc & 0xFF)];
+
+        for (uint32_t k = 2; k < n; k++) {
+            next ^= t[n - 1 - k][buf[k]];
+        }
+        crc = next;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        crc = (uint16_t)(crc << 8) ^ t[0][(crc >> 8) ^ buf[i]];
+    }
+
+    return crc;
+}
+
+#if CRC16_LOOKUP_SLICE_MAX
+/**
+ * \brief           Build the slicing tables of every polynomial.
+ */
+static void lookup_slice_build(void) {
+    for (uint32_t p = 0; p < CRC16_LOOKUP_POLYS; p++) {
+        uint16_t(*msb)[256] = crc16_slice_table[p][0];
+        uint16_t(*ref)[256] = crc16_slice_table[p][1];
+
+        crc16_generate_table(crc16_lookup_poly[p], msb[0], 256);
+        for (uint32_t b = 0; b < 256; b++) {
+            ref[0][b] = reverse_bits_16(msb[0][reverse_bits((uint8_t)b)]);
+        }
+
+        // One more zero byte after the byte of the previous table
+        for (uint32_t k = 1; k < CRC16_LOOKUP_SLICE_MAX; k++) {
+            for (uint32_t b = 0; b < 256; b++) {
+                uint16_t m = msb[k - 1][b];
+                uint16_t r = ref[k - 1][b];
+
+                msb[k][b] = (uint16_t)(m << 8) ^ msb[0][m >> 8];
+                ref[k][b] = (r >> 8) ^ ref[0][r & 0xFF];
+            }
+        }
+    }
+}
+#endif
+
 /* ----------------------------- end of file -------------------------------- */
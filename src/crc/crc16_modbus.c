@@ -0,0 +1,324 @@
+/**
+ * \file            crc16_modbus.c
+ * \brief           Modbus RTU stream framer driven by CRC16 (MODBUS)
+ * \date            2026-10-18
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the crc16 library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
+#include "crc/crc16_modbus.h"
+
+/* Private definitions ------------------------------------------------------ */
+#define MODBUS_POLY_REFLECTED 0xA001 /*!< 0x8005 with reversed bit order */
+#define MODBUS_INIT           0xFFFF /*!< CRC16_MODBUS_MODEL initial value */
+#define MODBUS_ADDR_MAX       247    /*!< Highest valid slave address */
+#define MODBUS_FC_MAX         25     /*!< Function codes covered by rules */
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Length rule of a function code.
+ *
+ * A frame is `len` bytes long when `count_at` is 0, otherwise `len` plus the
+ * value of the `count_sz`-byte big-endian field at offset `count_at`.
+ */
+typedef struct {
+    uint16_t len;     /*!< Fixed length, or base length */
+    uint8_t count_at; /*!< Offset of the byte count field, 0 if fixed */
+    uint8_t count_sz; /*!< Size of the byte count field in bytes */
+} modbus_rule_t;
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           Request (master to slave) length rules by function code.
+ */
+static const modbus_rule_t modbus_request_rules[MODBUS_FC_MAX] = {
+    [1] = {8, 0, 0},   [2] = {8, 0, 0},   [3] = {8, 0, 0},
+    [4] = {8, 0, 0},   [5] = {8, 0, 0},   [6] = {8, 0, 0},
+    [7] = {4, 0, 0},   [8] = {8, 0, 0},   [11] = {4, 0, 0},
+    [12] = {4, 0, 0},  [15] = {9, 6, 1},  [16] = {9, 6, 1},
+    [17] = {4, 0, 0},  [20] = {5, 2, 1},  [21] = {5, 2, 1},
+    [22] = {10, 0, 0}, [23] = {13, 10, 1}, [24] = {6, 0, 0},
+};
+
+/**
+ * \brief           Response (slave to master) length rules by function code.
+ */
+static const modbus_rule_t modbus_response_rules[MODBUS_FC_MAX] = {
+    [1] = {5, 2, 1},   [2] = {5, 2, 1},   [3] = {5, 2, 1},
+    [4] = {5, 2, 1},   [5] = {8, 0, 0},   [6] = {8, 0, 0},
+    [7] = {5, 0, 0},   [8] = {8, 0, 0},   [11] = {8, 0, 0},
+    [12] = {5, 2, 1},  [15] = {8, 0, 0},  [16] = {8, 0, 0},
+    [17] = {5, 2, 1},  [20] = {5, 2, 1},  [21] = {5, 2, 1},
+    [22] = {10, 0, 0}, [23] = {5, 2, 1},  [24] = {6, 2, 2},
+};
+
+/**
+ * \brief           Rule of an exception response (function code | 0x80).
+ */
+static const modbus_rule_t modbus_exception_rule = {5, 0, 0};
+
+/* Private function prototypes ---------------------------------------------- */
+static uint16_t crc16_modbus_mulmod(uint16_t a, uint16_t b);
+static void framer_schedule(crc16_modbus_framer_t* framer, uint64_t due,
+                            uint64_t start, uint16_t seed,
+                            const modbus_rule_t* rule);
+static void framer_add_candidate(crc16_modbus_framer_t* framer, uint8_t fc,
+                                 uint16_t seed);
+static void framer_run_slot(crc16_modbus_framer_t* framer, uint8_t byte,
+                            const uint8_t* chunk, uint64_t chunk_start);
+
+/* Public functions --------------------------------------------------------- */
+void crc16_modbus_framer_init(crc16_modbus_framer_t* framer,
+                              crc16_modbus_dir_e dir,
+                              crc16_modbus_frame_fn on_frame, void* arg) {
+    memset(framer, 0, sizeof(*framer));
+    framer->dir = dir;
+    framer->on_frame = on_frame;
+    framer->arg = arg;
+
+    // Byte-wise table of the reflected polynomial
+    for (uint32_t i = 0; i < 256; i++) {
+        uint16_t crc = (uint16_t)i;
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ MODBUS_POLY_REFLECTED : crc >> 1;
+        }
+        framer->table[i] = crc;
+    }
+
+    // x^(8n) mod P, reflected: x^0 is the top bit
+    framer->shift[0] = 0x8000;
+    for (uint32_t n = 1; n <= CRC16_MODBUS_ADU_MAX; n++) {
+        uint16_t crc = framer->shift[n - 1];
+        framer->shift[n] = (crc >> 8) ^ framer->table[crc & 0xFF];
+    }
+
+    // Chain all events into the free list
+    for (uint32_t i = 0; i < CRC16_MODBUS_EVENT_MAX; i++) {
+        framer->events[i].next = (uint16_t)(i + 2);
+    }
+    framer->events[CRC16_MODBUS_EVENT_MAX - 1].next = 0;
+    framer->free_head = 1;
+}
+
+void crc16_modbus_framer_feed(crc16_modbus_framer_t* framer,
+                              const uint8_t* buf, uint32_t len) {
+    uint64_t chunk_start = framer->pos;
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t byte = buf[i];
+        uint16_t crc_before = framer->crc;
+
+        // Running CRC16 of the stream, init 0: only the register is needed
+        framer->crc = (crc_before >> 8) ^ framer->table[(crc_before ^ byte)
+                                                        & 0xFF];
+
+        // The previous byte starts a candidate if it is an address and this
+        // byte a known function code
+        if (framer->pos > framer->frame_end
+            && framer->last <= MODBUS_ADDR_MAX) {
+            framer_add_candidate(framer, byte, MODBUS_INIT ^ framer->crc_prev);
+        }
+
+        framer_run_slot(framer, byte, buf, chunk_start);
+
+        framer->crc_prev = crc_before;
+        framer->last = byte;
+        framer->pos++;
+    }
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Multiply two polynomials modulo the MODBUS polynomial.
+ *
+ * Both operands and the result use the reflected bit order of the running
+ * CRC, where the top bit is x^0.
+ *
+ * \param[in]       a: First factor
+ * \param[in]       b: Second factor
+ * \return          a * b mod P
+ */
+static uint16_t crc16_modbus_mulmod(uint16_t a, uint16_t b) {
+    uint16_t product = 0;
+
+    for (uint16_t m = 0x8000; m != 0 && a != 0; m >>= 1) {
+        if (a & m) {
+            product ^= b;
+            a ^= m;
+        }
+        b = (b & 1) ? (b >> 1) ^ MODBUS_POLY_REFLECTED : b >> 1;
+    }
+
+    return product;
+}
+
+/**
+ * \brief           Queue an event for the byte at stream offset `due`.
+ *
+ * \param[in,out]   framer: Pointer to the framer
+ * \param[in]       due: Stream offset of the byte completing the event
+ * \param[in]       start: Stream offset of the candidate start
+ * \param[in]       seed: CRC16 init XOR running CRC16 at the start
+ * \param[in]       rule: Length rule of the candidate
+ */
+static void framer_schedule(crc16_modbus_framer_t* framer, uint64_t due,
+                            uint64_t start, uint16_t seed,
+                            const modbus_rule_t* rule) {
+    if (framer->free_head == 0) {
+        framer->dropped++;
+        return;
+    }
+
+    uint16_t index = framer->free_head;
+    crc16_modbus_event_t* event = &framer->events[index - 1];
+    uint16_t* slot = &framer->slot[due % CRC16_MODBUS_ADU_MAX];
+
+    framer->free_head = event->next;
+    event->start = start;
+    event->seed = seed;
+    event->len = rule->len;
+    event->count_at = rule->count_at;
+    event->count_sz = rule->count_sz;
+    event->next = *slot;
+    *slot = index;
+}
+
+/**
+ * \brief           Queue the candidate frame(s) starting at the previous byte.
+ *
+ * \param[in,out]   framer: Pointer to the framer
+ * \param[in]       fc: Function code of the candidate
+ * \param[in]       seed: CRC16 init XOR running CRC16 at the start
+ */
+static void framer_add_candidate(crc16_modbus_framer_t* framer, uint8_t fc,
+                                 uint16_t seed) {
+    uint64_t start = framer->pos - 1;
+    const modbus_rule_t* rules[2] = {NULL, NULL};
+
+    if (fc & 0x80) {
+        uint8_t code = fc & 0x7F;
+        if ((framer->dir & CRC16_MODBUS_RESPONSE) && code < MODBUS_FC_MAX
+            && modbus_response_rules[code].len != 0) {
+            rules[0] = &modbus_exception_rule;
+        }
+    } else if (fc < MODBUS_FC_MAX) {
+        if ((framer->dir & CRC16_MODBUS_REQUEST)
+            && modbus_request_rules[fc].len != 0) {
+            rules[0] = &modbus_request_rules[fc];
+        }
+        if ((framer->dir & CRC16_MODBUS_RESPONSE)
+            && modbus_response_rules[fc].len != 0) {
+            rules[1] = &modbus_response_rules[fc];
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        const modbus_rule_t* rule = rules[i];
+        if (rule == NULL) {
+            continue;
+        }
+        // Fixed frames are checked at their last byte, variable ones are
+        // resolved once their byte count field is complete
+        uint64_t due = rule->count_at == 0
+                           ? start + rule->len - 1
+                           : start + rule->count_at + rule->count_sz - 1;
+        framer_schedule(framer, due, start, seed, rule);
+    }
+}
+
+/**
+ * \brief           Process the events due at the current byte.
+ *
+ * \param[in,out]   framer: Pointer to the framer
+ * \param[in]       byte: The current byte
+ * \param[in]       chunk: Pointer to the chunk being fed
+ * \param[in]       chunk_start: Stream offset of the chunk
+ */
+static void framer_run_slot(crc16_modbus_framer_t* framer, uint8_t byte,
+                            const uint8_t* chunk, uint64_t chunk_start) {
+    uint16_t* slot = &framer->slot[framer->pos % CRC16_MODBUS_ADU_MAX];
+    uint16_t index = *slot;
+    uint64_t best_start = UINT64_MAX;
+
+    *slot = 0;
+    while (index != 0) {
+        crc16_modbus_event_t* event = &framer->events[index - 1];
+        uint16_t next = event->next;
+
+        // Candidates overlapping a frame already found are dead
+        if (event->start >= framer->frame_end) {
+            if (event->count_at != 0) {
+                uint32_t count = byte;
+                if (event->count_sz == 2) {
+                    count |= (uint32_t)framer->last << 8;
+                }
+                uint32_t len = event->len + count;
+                if (len <= CRC16_MODBUS_ADU_MAX) {
+                    modbus_rule_t rule = {(uint16_t)len, 0, 0};
+                    framer_schedule(framer, event->start + len - 1,
+                                    event->start, event->seed, &rule);
+                }
+            } else if (event->start < best_start) {
+                // The frame is valid if its CRC register, derived from the
+                // running CRC at both ends, is zero (MODBUS residue)
+                uint16_t len = event->len;
+                uint16_t crc = crc16_modbus_mulmod(event->seed,
+                                                   framer->shift[len]);
+                if (crc == framer->crc) {
+                    best_start = event->start;
+                }
+            }
+        }
+
+        event->next = framer->free_head;
+        framer->free_head = index;
+        index = next;
+    }
+
+    if (best_start != UINT64_MAX) {
+        crc16_modbus_frame_t frame;
+        frame.offset = best_start;
+        frame.len = (uint16_t)(framer->pos + 1 - best_start);
+        frame.data = best_start >= chunk_start
+                         ? chunk + (best_start - chunk_start)
+                         : NULL;
+
+        framer->skipped += best_start - framer->frame_end;
+        framer->frame_end = framer->pos + 1;
+        framer->frames++;
+        if (framer->on_frame != NULL) {
+            framer->on_frame(framer->arg, &frame);
+        }
+    }
+}
+
+/* ----------------------------- end of file -------------------------------- */
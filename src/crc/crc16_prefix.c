@@ -0,0 +1,157 @@
+/**
+ * \file            crc16_prefix.c
+ * \brief           CRC16 prefix snapshots for frames sharing a constant header
+ * \date            2026-10-18
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the crc16 library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
+#include "crc/crc16_prefix.h"
+
+/* Private function prototypes ---------------------------------------------- */
+static uint32_t prefix_hash(crc16_param_model_e model, const uint8_t* key,
+                            uint32_t len);
+
+/* Public functions --------------------------------------------------------- */
+void crc16_prefix_init(crc16_prefix_t* prefix, crc16_param_model_e model,
+                       const uint8_t* buf, uint32_t len) {
+    crc16_init(&prefix->ctx, model);
+    crc16_update(&prefix->ctx, buf, len);
+    prefix->len = len;
+}
+
+uint16_t crc16_prefix_calculate(const crc16_prefix_t* prefix,
+                                const uint8_t* buf, uint32_t len) {
+    // Work on a copy: crc16_final overwrites the running value
+    crc16_ctx_t ctx = prefix->ctx;
+
+    crc16_update(&ctx, buf, len);
+
+    return crc16_final(&ctx);
+}
+
+bool crc16_prefix_cache_init(crc16_prefix_cache_t* cache,
+                             crc16_prefix_entry_t* entries, uint32_t capacity) {
+    if (cache == NULL || entries == NULL || capacity == 0
+        || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+
+    cache->entries = entries;
+    cache->capacity = capacity;
+    crc16_prefix_cache_clear(cache);
+
+    return true;
+}
+
+void crc16_prefix_cache_clear(crc16_prefix_cache_t* cache) {
+    memset(cache->entries, 0, cache->capacity * sizeof(cache->entries[0]));
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+uint16_t crc16_prefix_cache_calculate(crc16_prefix_cache_t* cache,
+                                      crc16_param_model_e model,
+                                      const uint8_t* buf, uint32_t len,
+                                      uint32_t prefix_len) {
+    if (prefix_len == 0 || prefix_len > CRC16_PREFIX_KEY_MAX
+        || prefix_len > len) {
+        return crc16_calculate(model, buf, len);
+    }
+
+    uint32_t mask = cache->capacity - 1;
+    uint32_t slot = prefix_hash(model, buf, prefix_len) & mask;
+    crc16_prefix_entry_t* victim = NULL;
+    uint32_t probe = CRC16_PREFIX_CACHE_PROBE < cache->capacity
+                         ? CRC16_PREFIX_CACHE_PROBE
+                         : cache->capacity;
+
+    for (uint32_t i = 0; i < probe; i++) {
+        crc16_prefix_entry_t* entry = &cache->entries[(slot + i) & mask];
+
+        if (entry->key_len == prefix_len && entry->model == (uint8_t)model
+            && memcmp(entry->key, buf, prefix_len) == 0) {
+            cache->hits++;
+            if (entry->hits < UINT16_MAX) {
+                entry->hits++;
+            }
+            return crc16_prefix_calculate(&entry->prefix, buf + prefix_len,
+                                          len - prefix_len);
+        }
+
+        // Remember the coldest entry of the probe window as the victim
+        if (victim == NULL || entry->key_len == 0
+            || (victim->key_len != 0 && entry->hits < victim->hits)) {
+            victim = entry;
+        }
+    }
+
+    cache->misses++;
+
+    if (victim->key_len != 0 && victim->hits > 0) {
+        // Hot entry: let it decay instead of evicting it right away
+        victim->hits--;
+        return crc16_calculate(model, buf, len);
+    }
+
+    crc16_prefix_init(&victim->prefix, model, buf, prefix_len);
+    memcpy(victim->key, buf, prefix_len);
+    victim->key_len = (uint8_t)prefix_len;
+    victim->model = (uint8_t)model;
+    victim->hits = 0;
+
+    return crc16_prefix_calculate(&victim->prefix, buf + prefix_len,
+                                  len - prefix_len);
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Hash a model/prefix pair (FNV-1a).
+ *
+ * \param[in]       model: The CRC16 model
+ * \param[in]       key: Pointer to the prefix bytes
+ * \param[in]       len: Length of the prefix in bytes
+ * \return          32-bit hash value
+ */
+static uint32_t prefix_hash(crc16_param_model_e model, const uint8_t* key,
+                            uint32_t len) {
+    uint32_t hash = 0x811C9DC5u ^ (uint32_t)model;
+
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= key[i];
+        hash *= 0x01000193u;
+    }
+
+    return hash;
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -33,8 +33,24 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
 #include "crc/crc32.h"
 #include "crc/bit_utils.h"
+#include "crc/gf2poly.h"
+#include "crc_batch.h"
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           CRC32 residues, indexed by model.
+ */
+static const uint32_t crc32_residue_table[CRC32_NONE_MODEL] = {
+    0x2144DF1C, // CRC32_MODEL
+    0x00000000, // CRC32_MPEG2_MODEL (big-endian trailer)
+};
+
+/* Private function prototypes ---------------------------------------------- */
+static uint32_t crc32_unfinal(const crc32_ctx_t* ctx, uint32_t crc);
 
 /* Public functions --------------------------------------------------------- */
 void crc32_init(crc32_ctx_t* ctx, crc32_param_model_e model) {
@@ -145,4 +161,139 @@ bool crc32_verify_buf(crc32_param_model_e model, const uint8_t* buf,
     return (stored_crc == calculated_crc);
 }
 
+uint32_t crc32_residue(crc32_param_model_e model) {
+    if ((uint32_t)model >= CRC32_NONE_MODEL) {
+        return 0;
+    }
+
+    return crc32_residue_table[model];
+}
+
+void crc32_verify_stream_init(crc32_stream_t* stream,
+                              crc32_param_model_e model) {
+    crc32_init(&stream->ctx, model);
+    stream->residue = crc32_residue(model);
+    stream->use_residue = stream->ctx.ref_in && stream->ctx.ref_out;
+    memset(stream->tail, 0, sizeof(stream->tail));
+    stream->len = 0;
+}
+
+void crc32_verify_stream_update(crc32_stream_t* stream, const uint8_t* buf,
+                                uint32_t len) {
+    if (stream->use_residue) {
+        crc32_update(&stream->ctx, buf, len);
+        stream->len += len;
+        return;
+    }
+
+    // Hold the last bytes back from the CRC: they may be the trailer
+    uint32_t held = stream->len < sizeof(stream->tail) ? stream->len
+                                                       : sizeof(stream->tail);
+    uint32_t total = held + len;
+    uint32_t keep = total < sizeof(stream->tail) ? total : sizeof(stream->tail);
+    uint8_t tail[sizeof(stream->tail)];
+
+    for (uint32_t i = 0; i < keep; i++) {
+        uint32_t idx = total - keep + i;
+        tail[i] = idx < held ? stream->tail[idx] : buf[idx - held];
+    }
+
+    uint32_t flush = total - keep;
+    uint32_t from_tail = flush < held ? flush : held;
+    crc32_update(&stream->ctx, stream->tail, from_tail);
+    crc32_update(&stream->ctx, buf, flush - from_tail);
+
+    memcpy(stream->tail, tail, keep);
+    stream->len += len;
+}
+
+bool crc32_verify_stream(const crc32_stream_t* stream) {
+    if (stream->len <= sizeof(uint32_t)) {
+        return false; // Not enough bytes for data and CRC
+    }
+
+    crc32_ctx_t ctx = stream->ctx; // crc32_final overwrites the running value
+
+    if (stream->use_residue) {
+        return (crc32_final(&ctx) == stream->residue);
+    }
+
+    uint32_t stored_crc = ((uint32_t)stream->tail[3] << 24)
+                          | ((uint32_t)stream->tail[2] << 16)
+                          | ((uint32_t)stream->tail[1] << 8) | stream->tail[0];
+    return (stored_crc == crc32_final(&ctx));
+}
+
+uint32_t crc32_verify_bufs(crc32_param_model_e model,
+                           const uint8_t* const bufs[], const uint32_t lens[],
+                           uint32_t n, uint64_t* ok_bitmap) {
+    crc_batch_model_t batch;
+
+    crc32_batch_model(&batch, model);
+
+    return crc_batch_verify(&batch, bufs, lens, n, ok_bitmap);
+}
+
+void crc32_pack_bufs(crc32_param_model_e model, uint8_t* const bufs[],
+                     const uint32_t lens[], uint32_t n) {
+    crc_batch_model_t batch;
+
+    crc32_batch_model(&batch, model);
+    crc_batch_pack(&batch, bufs, lens, n);
+}
+
+uint32_t crc32_combine_gen(crc32_param_model_e model, uint64_t len2) {
+    crc32_ctx_t ctx;
+
+    crc32_init(&ctx, model);
+
+    return (uint32_t)gf2poly_xpow8n(len2, ctx.poly, 32);
+}
+
+uint32_t crc32_combine_op(crc32_param_model_e model, uint32_t crc1,
+                          uint32_t crc2, uint32_t op) {
+    crc32_ctx_t ctx;
+
+    crc32_init(&ctx, model);
+
+    // register(A + B) = (register(A) ^ init) * x^(8 * len2) ^ register(B)
+    ctx.init = (uint32_t)gf2poly_mulmod(crc32_unfinal(&ctx, crc1) ^ ctx.init,
+                                        op, ctx.poly, 32)
+               ^ crc32_unfinal(&ctx, crc2);
+
+    return crc32_final(&ctx);
+}
+
+uint32_t crc32_combine(crc32_param_model_e model, uint32_t crc1, uint32_t crc2,
+                       uint64_t len2) {
+    return crc32_combine_op(model, crc1, crc2,
+                            crc32_combine_gen(model, len2));
+}
+
+void crc32_batch_model(crc_batch_model_t* batch, crc32_param_model_e model) {
+    crc32_ctx_t ctx;
+
+    crc32_init(&ctx, model);
+    batch->init = ctx.init;
+    batch->xor_out = ctx.xor_out;
+    batch->poly = ctx.poly;
+    batch->width = 32;
+    batch->ref_in = ctx.ref_in;
+    batch->ref_out = ctx.ref_out;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Undo the final reflection and XOR of a CRC32 checksum.
+ *
+ * \param[in]       ctx: Pointer to the initialized CRC32 context
+ * \param[in]       crc: The CRC32 checksum
+ * \return          The register value the checksum was finalized from
+ */
+static uint32_t crc32_unfinal(const crc32_ctx_t* ctx, uint32_t crc) {
+    crc ^= ctx->xor_out;
+
+    return ctx->ref_out ? reverse_bits_32(crc) : crc;
+}
+
 /* ----------------------------- end of file -------------------------------- */
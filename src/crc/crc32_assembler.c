@@ -0,0 +1,576 @@
+/**
+ * \file            crc32_assembler.c
+ * \brief           Lock-free CRC32 of out-of-order stream chunks
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc32_assembler.h"
+#include "crc/bit_utils.h"
+#include "crc/gf2poly.h"
+#include "crc_batch.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of shards of the received ranges, one bit of a
+ *                  64-bit lock mask each.
+ */
+#define ASSEMBLER_SHARDS 64
+
+/**
+ * \brief           Length in bytes of the stripes the stream is cut into.
+ *
+ * Stripe `s` is recorded in shard `s % ASSEMBLER_SHARDS`, so chunks in
+ * different stripes of a 4 MiB window take different locks.
+ */
+#define ASSEMBLER_STRIPE (64 * 1024)
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Range of stream bytes received, `[start, end)`.
+ */
+typedef struct {
+    uint64_t start; /*!< Offset of the first byte */
+    uint64_t end;   /*!< Offset past the last byte */
+} assembler_span_t;
+
+/**
+ * \brief           Received ranges of the stripes of one shard.
+ *
+ * The lock spins since it is only held to search and shift the ranges, never
+ * to allocate, and works whether or not the library threads are enabled.
+ */
+typedef struct {
+    atomic_flag lock;        /*!< Guards the fields below */
+    assembler_span_t* spans; /*!< Received ranges, cut at the stripes,
+                                  sorted, disjoint and not adjacent */
+    size_t count;            /*!< Number of ranges in `spans` */
+    size_t cap;              /*!< Capacity of `spans` */
+} assembler_shard_t;
+
+/**
+ * \brief           State shared by all threads feeding an assembler.
+ *
+ * Chunks are hashed and folded into `sum` without any lock. Only the
+ * bookkeeping of the received ranges, which rejects overlapping chunks, takes
+ * the locks of the shards a chunk spans. Since accepted chunks are disjoint
+ * and within the stream, the stream is complete once `bytes` reaches `total`.
+ */
+typedef struct {
+    crc32_param_model_e model;   /*!< CRC32 model of the stream */
+    crc32_ctx_t ctx;             /*!< Parameters of the model */
+    crc_batch_engine_t eng;      /*!< Engine of the model, initial value 0 */
+    gf2poly_powers_t inv;        /*!< Powers of x^-8 mod the polynomial */
+    assembler_shard_t shards[ASSEMBLER_SHARDS]; /*!< Received ranges */
+    atomic_uint_least32_t sum;   /*!< Sum of P_i * x^(-8 end_i) */
+    atomic_uint_fast64_t bytes;  /*!< Number of bytes received */
+    atomic_uint_fast64_t total;  /*!< Stream length, only changed with every
+                                      shard locked */
+    atomic_flag finished;        /*!< Set by the thread computing `crc` */
+    uint32_t crc;                /*!< CRC32 of the complete stream */
+    atomic_bool ready;           /*!< Set once `crc` is valid */
+} assembler_state_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static bool assembler_fold(assembler_state_t* st, uint64_t offset,
+                           uint64_t len, uint32_t reg);
+static bool assembler_record(assembler_state_t* st, uint64_t start,
+                             uint64_t end);
+static bool assembler_overlaps(const assembler_shard_t* shard,
+                               uint64_t start, uint64_t end);
+static void assembler_insert(assembler_shard_t* shard, uint64_t start,
+                             uint64_t end);
+static bool assembler_grow(assembler_shard_t* shard, size_t need);
+static void assembler_complete(assembler_state_t* st);
+static uint64_t assembler_mask(uint64_t first, uint64_t last);
+static void assembler_lock(assembler_state_t* st, uint64_t mask);
+static void assembler_unlock(assembler_state_t* st, uint64_t mask);
+static void assembler_shard_lock(assembler_shard_t* shard);
+static void assembler_shard_unlock(assembler_shard_t* shard);
+
+/* Public functions --------------------------------------------------------- */
+bool crc32_assembler_init(crc32_assembler_t* as, crc32_param_model_e model,
+                          uint64_t total) {
+    crc_batch_model_t batch;
+
+    as->model = model;
+    as->state = NULL;
+    if ((uint32_t)model >= CRC32_NONE_MODEL) {
+        return false;
+    }
+
+    assembler_state_t* st = malloc(sizeof(*st));
+    if (st == NULL) {
+        return false;
+    }
+
+    st->model = model;
+    crc32_init(&st->ctx, model);
+    crc32_batch_model(&batch, model);
+    batch.init = 0;
+    crc_batch_engine_init(&st->eng, &batch);
+
+    // Chunks are folded in by x^(-8 end), cached for any end
+    uint64_t xinv8 = gf2poly_powmod(gf2poly_xinv(st->ctx.poly, 32), 8,
+                                    st->ctx.poly, 32);
+    gf2poly_powers_init(&st->inv, xinv8, st->ctx.poly, 32);
+
+    for (uint32_t i = 0; i < ASSEMBLER_SHARDS; i++) {
+        atomic_flag_clear(&st->shards[i].lock);
+        st->shards[i].spans = NULL;
+        st->shards[i].count = 0;
+        st->shards[i].cap = 0;
+    }
+    atomic_init(&st->sum, 0);
+    atomic_init(&st->bytes, 0);
+    atomic_init(&st->total, total);
+    atomic_flag_clear(&st->finished);
+    st->crc = 0;
+    atomic_init(&st->ready, false);
+    as->state = st;
+    assembler_complete(st);
+
+    return true;
+}
+
+bool crc32_assembler_set_total(crc32_assembler_t* as, uint64_t total) {
+    assembler_state_t* st = as->state;
+
+    if (total == CRC32_ASSEMBLER_TOTAL_UNKNOWN) {
+        return false;
+    }
+
+    // Once per stream: no chunk is being recorded meanwhile
+    assembler_lock(st, UINT64_MAX);
+    uint64_t known = atomic_load(&st->total);
+    bool ok = known == CRC32_ASSEMBLER_TOTAL_UNKNOWN || known == total;
+    for (uint32_t i = 0; ok && i < ASSEMBLER_SHARDS; i++) {
+        const assembler_shard_t* shard = &st->shards[i];
+
+        ok = shard->count == 0 || shard->spans[shard->count - 1].end <= total;
+    }
+    if (ok) {
+        atomic_store(&st->total, total);
+    }
+    assembler_unlock(st, UINT64_MAX);
+
+    if (ok) {
+        assembler_complete(st);
+    }
+
+    return ok;
+}
+
+bool crc32_assembler_add(crc32_assembler_t* as, uint64_t offset,
+                         const uint8_t* buf, uint32_t len) {
+    assembler_state_t* st = as->state;
+    const crc_batch_engine_t* eng = &st->eng;
+
+    uint32_t reg = crc_batch_update(eng, eng->init, buf, len);
+    if (eng->reflected) {
+        reg = reverse_bits_32(reg);
+    }
+
+    return assembler_fold(st, offset, len, reg);
+}
+
+bool crc32_assembler_add_crc(crc32_assembler_t* as, uint64_t offset,
+                             uint64_t len, uint32_t crc) {
+    assembler_state_t* st = as->state;
+    uint32_t reg = crc ^ st->ctx.xor_out;
+
+    if (st->ctx.ref_out) {
+        reg = reverse_bits_32(reg);
+    }
+
+    // Remove the contribution of the initial value
+    reg ^= (uint32_t)gf2poly_mulmod(st->ctx.init,
+                                    crc32_combine_gen(st->model, len),
+                                    st->ctx.poly, 32);
+
+    return assembler_fold(st, offset, len, reg);
+}
+
+uint64_t crc32_assembler_bytes(const crc32_assembler_t* as) {
+    assembler_state_t* st = as->state;
+
+    return atomic_load(&st->bytes);
+}
+
+bool crc32_assembler_result(const crc32_assembler_t* as, uint32_t* crc) {
+    assembler_state_t* st = as->state;
+
+    if (!atomic_load(&st->ready)) {
+        return false;
+    }
+    *crc = st->crc;
+
+    return true;
+}
+
+void crc32_assembler_deinit(crc32_assembler_t* as) {
+    assembler_state_t* st = as->state;
+
+    if (st != NULL) {
+        for (uint32_t i = 0; i < ASSEMBLER_SHARDS; i++) {
+            free(st->shards[i].spans);
+        }
+        free(st);
+    }
+    as->state = NULL;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Fold the register of a chunk into the accumulator.
+ *
+ * A rejected chunk leaves the state unchanged.
+ *
+ * \param[in,out]   st: Pointer to the shared state
+ * \param[in]       offset: Offset of the chunk in the stream
+ * \param[in]       len: Length of the chunk in bytes
+ * \param[in]       reg: Register of the chunk hashed from 0, MSB-first
+ * \return          `true` on success, `false` if the chunk exceeds the
+ *                  stream length, overlaps another one or on allocation
+ *                  errors
+ */
+static bool assembler_fold(assembler_state_t* st, uint64_t offset,
+                           uint64_t len, uint32_t reg) {
+    uint64_t end = offset + len;
+
+    if (end < offset) {
+        return false;
+    }
+    if (len == 0) {
+        return end <= atomic_load(&st->total);
+    }
+
+    uint32_t term = (uint32_t)gf2poly_powers_mul(&st->inv, reg, end);
+    if (!assembler_record(st, offset, end)) {
+        return false;
+    }
+
+    // The sum is complete before the bytes that make the stream complete
+    atomic_fetch_xor(&st->sum, term);
+    atomic_fetch_add(&st->bytes, len);
+    assembler_complete(st);
+
+    return true;
+}
+
+/**
+ * \brief           Record the range of a chunk in the shards it spans.
+ *
+ * The range is cut at the stripes. Shards short of room are grown with
+ * their locks released, then the whole check starts over.
+ *
+ * \param[in,out]   st: Pointer to the shared state
+ * \param[in]       start: Offset of the first byte, less than `end`
+ * \param[in]       end: Offset past the last byte
+ * \return          `true` on success, `false` if the range exceeds the
+ *                  stream length, overlaps one already received or on
+ *                  allocation errors
+ */
+static bool assembler_record(assembler_state_t* st, uint64_t start,
+                             uint64_t end) {
+    uint64_t first = start / ASSEMBLER_STRIPE;
+    uint64_t last = (end - 1) / ASSEMBLER_STRIPE;
+    uint64_t mask = assembler_mask(first, last);
+
+    for (;;) {
+        size_t need[ASSEMBLER_SHARDS] = {0};
+        bool ok = true;
+
+        assembler_lock(st, mask);
+        ok = end <= atomic_load(&st->total);
+        for (uint64_t s = first; ok && s <= last; s++) {
+            uint64_t base = s * ASSEMBLER_STRIPE;
+            uint64_t lo = start > base ? start : base;
+            uint64_t hi = end - base > ASSEMBLER_STRIPE
+                              ? base + ASSEMBLER_STRIPE
+                              : end;
+
+            ok = !assembler_overlaps(&st->shards[s % ASSEMBLER_SHARDS], lo,
+                                     hi);
+            need[s % ASSEMBLER_SHARDS]++;
+        }
+
+        uint32_t short_of = ASSEMBLER_SHARDS;
+        for (uint32_t i = 0; ok && i < ASSEMBLER_SHARDS; i++) {
+            const assembler_shard_t* shard = &st->shards[i];
+
+            if (need[i] != 0 && need[i] > shard->cap - shard->count) {
+                short_of = i;
+                break;
+            }
+        }
+
+        if (ok && short_of == ASSEMBLER_SHARDS) {
+            for (uint64_t s = first; s <= last; s++) {
+                uint64_t base = s * ASSEMBLER_STRIPE;
+                uint64_t lo = start > base ? start : base;
+                uint64_t hi = end - base > ASSEMBLER_STRIPE
+                                  ? base + ASSEMBLER_STRIPE
+                                  : end;
+
+                assembler_insert(&st->shards[s % ASSEMBLER_SHARDS], lo, hi);
+            }
+        }
+        assembler_unlock(st, mask);
+
+        if (!ok || short_of == ASSEMBLER_SHARDS) {
+            return ok;
+        }
+        if (!assembler_grow(&st->shards[short_of], need[short_of])) {
+            return false;
+        }
+    }
+}
+
+/**
+ * \brief           Check whether a range overlaps one of a shard.
+ *
+ * \param[in]       shard: Pointer to the shard, locked
+ * \param[in]       start: Offset of the first byte, less than `end`
+ * \param[in]       end: Offset past the last byte
+ * \return          `true` if a received range overlaps `[start, end)`
+ */
+static bool assembler_overlaps(const assembler_shard_t* shard,
+                               uint64_t start, uint64_t end) {
+    size_t lo = 0;
+    size_t hi = shard->count;
+
+    // First range starting after `start`
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (shard->spans[mid].start <= start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return (lo > 0 && shard->spans[lo - 1].end > start)
+           || (lo < shard->count && shard->spans[lo].start < end);
+}
+
+/**
+ * \brief           Record a range of received bytes in a shard.
+ *
+ * Ranges that touch are merged.
+ *
+ * \param[in,out]   shard: Pointer to the shard, locked, with room for one
+ *                  more range
+ * \param[in]       start: Offset of the first byte, less than `end`
+ * \param[in]       end: Offset past the last byte, not overlapping
+ */
+static void assembler_insert(assembler_shard_t* shard, uint64_t start,
+                             uint64_t end) {
+    size_t lo = 0;
+    size_t hi = shard->count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (shard->spans[mid].start <= start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    assembler_span_t* prev = lo > 0 ? &shard->spans[lo - 1] : NULL;
+    assembler_span_t* next = lo < shard->count ? &shard->spans[lo] : NULL;
+    bool join_prev = prev != NULL && prev->end == start;
+    bool join_next = next != NULL && next->start == end;
+
+    if (join_prev && join_next) {
+        prev->end = next->end;
+        memmove(next, next + 1,
+                (shard->count - lo - 1) * sizeof(shard->spans[0]));
+        shard->count--;
+    } else if (join_prev) {
+        prev->end = end;
+    } else if (join_next) {
+        next->start = start;
+    } else {
+        memmove(&shard->spans[lo + 1], &shard->spans[lo],
+                (shard->count - lo) * sizeof(shard->spans[0]));
+        shard->spans[lo].start = start;
+        shard->spans[lo].end = end;
+        shard->count++;
+    }
+}
+
+/**
+ * \brief           Make room for more ranges in a shard.
+ *
+ * The new array is allocated without the lock, which is only taken to copy
+ * the ranges over.
+ *
+ * \param[in,out]   shard: Pointer to the shard, not locked
+ * \param[in]       need: Number of ranges to make room for
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool assembler_grow(assembler_shard_t* shard, size_t need) {
+    for (;;) {
+        assembler_shard_lock(shard);
+        size_t cap = 2 * shard->cap + need;
+        assembler_shard_unlock(shard);
+
+        assembler_span_t* spans = malloc(cap * sizeof(spans[0]));
+        if (spans == NULL) {
+            return false;
+        }
+
+        // Another thread may have grown the shard meanwhile
+        assembler_shard_lock(shard);
+        assembler_span_t* old = spans;
+        if (shard->count + need > shard->cap && shard->count + need <= cap) {
+            memcpy(spans, shard->spans, shard->count * sizeof(spans[0]));
+            old = shard->spans;
+            shard->spans = spans;
+            shard->cap = cap;
+        }
+        bool done = shard->count + need <= shard->cap;
+        assembler_shard_unlock(shard);
+        free(old);
+
+        if (done) {
+            return true;
+        }
+    }
+}
+
+/**
+ * \brief           Finalize the CRC32 if the stream is complete.
+ *
+ * Complete means `total` bytes were received, which, chunks being disjoint
+ * and within the stream, covers `[0, total)`. The CRC32 is computed once,
+ * by whichever thread sees the stream complete first.
+ *
+ * \param[in,out]   st: Pointer to the shared state
+ */
+static void assembler_complete(assembler_state_t* st) {
+    uint64_t total = atomic_load(&st->total);
+
+    if (atomic_load(&st->bytes) != total
+        || atomic_flag_test_and_set(&st->finished)) {
+        return;
+    }
+
+    // register = x^(8 T) * (I + sum)
+    crc32_ctx_t ctx = st->ctx;
+
+    ctx.init = (uint32_t)gf2poly_mulmod(ctx.init ^ atomic_load(&st->sum),
+                                        crc32_combine_gen(st->model, total),
+                                        ctx.poly, 32);
+    st->crc = crc32_final(&ctx);
+    atomic_store(&st->ready, true);
+}
+
+/**
+ * \brief           Get the lock mask of the shards of a stripe range.
+ *
+ * \param[in]       first: First stripe
+ * \param[in]       last: Last stripe, not below `first`
+ * \return          Bit `i` set for each shard `i` to be locked
+ */
+static uint64_t assembler_mask(uint64_t first, uint64_t last) {
+    uint64_t mask = 0;
+
+    if (last - first >= ASSEMBLER_SHARDS - 1) {
+        return UINT64_MAX;
+    }
+    for (uint64_t s = first; s <= last; s++) {
+        mask |= (uint64_t)1 << (s % ASSEMBLER_SHARDS);
+    }
+
+    return mask;
+}
+
+/**
+ * \brief           Acquire the locks of a set of shards.
+ *
+ * Locks are always taken in shard order, so no two threads deadlock.
+ *
+ * \param[in,out]   st: Pointer to the shared state
+ * \param[in]       mask: Shards to be locked, see `assembler_mask`
+ */
+static void assembler_lock(assembler_state_t* st, uint64_t mask) {
+    for (uint32_t i = 0; i < ASSEMBLER_SHARDS; i++) {
+        if ((mask >> i) & 1) {
+            assembler_shard_lock(&st->shards[i]);
+        }
+    }
+}
+
+/**
+ * \brief           Release the locks of a set of shards.
+ *
+ * \param[in,out]   st: Pointer to the shared state
+ * \param[in]       mask: Shards to be unlocked, see `assembler_mask`
+ */
+static void assembler_unlock(assembler_state_t* st, uint64_t mask) {
+    for (uint32_t i = 0; i < ASSEMBLER_SHARDS; i++) {
+        if ((mask >> i) & 1) {
+            assembler_shard_unlock(&st->shards[i]);
+        }
+    }
+}
+
+/**
+ * \brief           Acquire the lock of a shard.
+ *
+ * \param[in,out]   shard: Pointer to the shard
+ */
+static void assembler_shard_lock(assembler_shard_t* shard) {
+    while (atomic_flag_test_and_set_explicit(&shard->lock,
+                                             memory_order_acquire)) {
+        crc_thread_yield();
+    }
+}
+
+/**
+ * \brief           Release the lock of a shard.
+ *
+ * \param[in,out]   shard: Pointer to the shard
+ */
+static void assembler_shard_unlock(assembler_shard_t* shard) {
+    atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+}
+
+/* ----------------------------- end of file -------------------------------- */
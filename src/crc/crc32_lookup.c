@@ -33,8 +33,18 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <stddef.h>
 #include "crc/crc32_lookup.h"
 #include "crc/bit_utils.h"
+#if CRC32_LOOKUP_SLICE_MAX
+#include "crc_once.h"
+#endif
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of polynomials with built-in tables.
+ */
+#define CRC32_LOOKUP_POLYS 1
 
 /* Private variables -------------------------------------------------------- */
 /**
@@ -49,6 +59,51 @@ static const uint32_t crc32_poly_0x04C11DB7_table[16] = {
     0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
 };
 
+/**
+ * \brief           Polynomials with built-in tables.
+ */
+static const uint32_t crc32_lookup_poly[CRC32_LOOKUP_POLYS] = {
+    0x04C11DB7,
+};
+
+/**
+ * \brief           Nibble tables of `crc32_lookup_poly`.
+ */
+static const uint32_t* const crc32_nibble_table[CRC32_LOOKUP_POLYS] = {
+    crc32_poly_0x04C11DB7_table,
+};
+
+#if CRC32_LOOKUP_SLICE_MAX
+/**
+ * \brief           Slicing tables by polynomial, then MSB-first or reflected.
+ *
+ * Table `k` holds the register after a byte followed by `k` zero bytes; a tier
+ * of `n` tables uses the first `n`.
+ */
+static uint32_t crc32_slice_table[CRC32_LOOKUP_POLYS][2]
+                                 [CRC32_LOOKUP_SLICE_MAX][256];
+
+/**
+ * \brief           Guard of the slicing tables build.
+ */
+static crc_once_t crc32_slice_once = CRC_ONCE_INIT;
+#endif
+
+#if CRC32_LOOKUP_SLICE > CRC32_LOOKUP_SLICE_MAX
+#error "CRC32_LOOKUP_SLICE exceeds CRC32_LOOKUP_SLICE_MAX"
+#endif
+
+/* Private function prototypes ---------------------------------------------- */
+static uint32_t lookup_slice_update(const crc32_lookup_ctx_t* ctx,
+                                    uint32_t crc, const uint8_t* buf,
+                                    uint32_t len);
+static inline uint32_t lookup_slice_run(const uint32_t* table, uint32_t n,
+                                        bool ref_in, uint32_t crc,
+                                        const uint8_t* buf, uint32_t len);
+#if CRC32_LOOKUP_SLICE_MAX
+static void lookup_slice_build(void);
+#endif
+
 /* Public functions --------------------------------------------------------- */
 void crc32_lookup_init(crc32_lookup_ctx_t* ctx,
                        crc32_lookup_param_model_e model) {
@@ -84,8 +139,42 @@ void crc32_lookup_init(crc32_lookup_ctx_t* ctx,
         ctx->xor_out = 0x00000000; // Default XOR value
         ctx->ref_in = false;       // Do not reverse input bits
         ctx->ref_out = false;      // Do not reverse output bits
+        ctx->table_len = 0;
+        ctx->table = NULL;
         break;
     }
+
+#if CRC32_LOOKUP_SLICE
+    // Move from the built-in nibble table to the default tier
+    crc32_lookup_set_tier(ctx, (crc_tier_e)CRC32_LOOKUP_SLICE);
+#endif
+}
+
+bool crc32_lookup_set_tier(crc32_lookup_ctx_t* ctx, crc_tier_e tier) {
+    if (ctx->table == NULL || !crc_tier_is_valid(tier)
+        || (uint32_t)tier > CRC32_LOOKUP_SLICE_MAX) {
+        return false;
+    }
+
+    for (uint32_t p = 0; p < CRC32_LOOKUP_POLYS; p++) {
+        if (crc32_lookup_poly[p] != ctx->poly) {
+            continue;
+        }
+
+        if (tier == CRC_TIER_NIBBLE) {
+            ctx->table = (uint32_t*)crc32_nibble_table[p];
+            ctx->table_len = 16;
+            return true;
+        }
+#if CRC32_LOOKUP_SLICE_MAX
+        crc_once(&crc32_slice_once, lookup_slice_build);
+        ctx->table = &crc32_slice_table[p][ctx->ref_in][0][0];
+        ctx->table_len = (uint16_t)(tier * 256);
+        return true;
+#endif
+    }
+
+    return false;
 }
 
 void crc32_lookup_update(crc32_lookup_ctx_t* ctx, const uint8_t* buf,
@@ -95,6 +184,11 @@ void crc32_lookup_update(crc32_lookup_ctx_t* ctx, const uint8_t* buf,
     }
 
     uint32_t crc = ctx->init;
+    if (ctx->table_len >= 256) {
+        ctx->init = lookup_slice_update(ctx, crc, buf, len);
+        return;
+    }
+
     for (uint32_t i = 0; i < len; i++) {
         uint8_t data = buf[i];
 
@@ -213,4 +307,120 @@ void crc32_generate_table(uint32_t polynomial, uint32_t table[],
     }
 }
 
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Run the register over a buffer with the slicing tables.
+ *
+ * The context register is MSB-first over bit-reversed bytes when the input is
+ * reflected; the reflected tables run it reflected instead, so that the bytes
+ * are taken as they are.
+ *
+ * \param[in]       ctx: Pointer to the CRC32 context
+ * \param[in]       crc: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static uint32_t lookup_slice_update(const crc32_lookup_ctx_t* ctx,
+                                    uint32_t crc, const uint8_t* buf,
+                                    uint32_t len) {
+    // Constant step sizes let the compiler unroll the step
+    switch (ctx->table_len / 256) {
+    case 1:
+        return lookup_slice_run(ctx->table, 1, ctx->ref_in, crc, buf, len);
+    case 4:
+        return lookup_slice_run(ctx->table, 4, ctx->ref_in, crc, buf, len);
+    case 8:
+        return lookup_slice_run(ctx->table, 8, ctx->ref_in, crc, buf, len);
+    case 16:
+        return lookup_slice_run(ctx->table, 16, ctx->ref_in, crc, buf, len);
+    default:
+        return lookup_slice_run(ctx->table, ctx->table_len / 256, ctx->ref_in,
+                                crc, buf, len);
+    }
+}
+
+/**
+ * \brief           Slicing loop of `lookup_slice_update` for `n` tables.
+ *
+ * \param[in]       table: The slicing tables
+ * \param[in]       n: Number of tables, the bytes taken per step; below four
+ *                  tables every byte goes through the byte loop
+ * \param[in]       ref_in: Whether the tables are reflected
+ * \param[in]       crc: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static inline uint32_t lookup_slice_run(const uint32_t* table, uint32_t n,
+                                        bool ref_in, uint32_t crc,
+                                        const uint8_t* buf, uint32_t len) {
+    const uint32_t(*t)[256] = (const uint32_t(*)[256])table;
+
+    if (ref_in) {
+        crc = reverse_bits_32(crc);
+        for (; n >= 4 && len >= n; len -= n, buf += n) {
+            uint32_t next = t[n - 1][buf[0] ^ (crc & 0xFF)]
+                            ^ t[n - 2][buf[1] ^ ((crc >> 8) & 0xFF)]
+                            ^ t[n - 3][buf[2] ^ ((crc >> 16) & 0xFF)]
+                            ^ t[n - 4][buf[3] ^ (crc >> 24)];
+
+            for (uint32_t k = 4; k < n; k++) {
+                next ^= t[n - 1 - k][buf[k]];
+            }
+            crc = next;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            crc = (crc >> 8) ^ t[0][(crc ^ buf[i]) & 0xFF];
+        }
+
+        return reverse_bits_32(crc);
+    }
+
+    for (; n >= 4 && len >= n; len -= n, buf += n) {
+        uint32_t next = t[n - 1][buf[0] ^ (crc >> 24)]
+                        ^ t[n - 2][buf[1] ^ ((crc >> 16) & 0xFF)]
+                        ^ t[n - 3][buf[2] ^ ((crc >> 8) & 0xFF)]
+                        ^ t[n - 4][buf[3] ^ (crc & 0xFF)];
+
+        for (uint32_t k = 4; k < n; k++) {
+            next ^= t[n - 1 - k][buf[k]];
+        }
+        crc = next;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        crc = (crc << 8) ^ t[0][(crc >> 24) ^ buf[i]];
+    }
+
+    return crc;
+}
+
+#if CRC32_LOOKUP_SLICE_MAX
+/**
+ * \brief           Build the slicing tables of every polynomial.
+ */
+static void lookup_slice_build(void) {
+    for (uint32_t p = 0; p < CRC32_LOOKUP_POLYS; p++) {
+        uint32_t(*msb)[256] = crc32_slice_table[p][0];
+        uint32_t(*ref)[256] = crc32_slice_table[p][1];
+
+        crc32_generate_table(crc32_lookup_poly[p], msb[0], 256);
+        for (uint32_t b = 0; b < 256; b++) {
+            ref[0][b] = reverse_bits_32(msb[0][reverse_bits((uint8_t)b)]);
+        }
+
+        // One more zero byte after the byte of the previous table
+        for (uint32_t k = 1; k < CRC32_LOOKUP_SLICE_MAX; k++) {
+            for (uint32_t b = 0; b < 256; b++) {
+                uint32_t m = msb[k - 1][b];
+                uint32_t r = ref[k - 1][b];
+
+                msb[k][b] = (m << 8) ^ msb[0][m >> 24];
+                ref[k][b] = (r >> 8) ^ ref[0][r & 0xFF];
+            }
+        }
+    }
+}
+#endif
+
 /* ----------------------------- end of file -------------------------------- */
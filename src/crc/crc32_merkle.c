@@ -0,0 +1,511 @@
+/**
+ * \file            crc32_merkle.c
+ * \brief           Merkle tree of CRC32 block checksums
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc32_merkle.h"
+#include "crc_batch.h"
+#include "crc_blob.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Magic number of the serialised tree, "CRCT".
+ */
+#define MERKLE_MAGIC       0x54435243u
+
+/**
+ * \brief           Number of bytes a worker reads at a time.
+ */
+#define MERKLE_CHUNK_BYTES (1024 * 1024)
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Leaf hashing job shared by all workers.
+ */
+typedef struct {
+    crc32_merkle_t* tree;      /*!< Tree whose leaves are hashed */
+    const char* path;          /*!< Data file */
+    crc_batch_model_t batch;   /*!< Model for the batch engine */
+    uint32_t chunk_blocks;     /*!< Number of blocks per chunk */
+    crc_chunks_t chunks;       /*!< Chunks of leaves to hash */
+} merkle_job_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static bool merkle_layout(crc32_merkle_t* tree);
+static void merkle_parents(crc32_merkle_t* tree);
+static bool merkle_hash(const crc32_merkle_t* tree, FILE* fp,
+                        const crc_batch_model_t* batch, uint64_t first,
+                        uint32_t count, uint8_t* data, const uint8_t** bufs,
+                        uint32_t* lens, uint32_t* crcs);
+static void* merkle_worker(void* arg);
+static uint64_t node_len(const crc32_merkle_t* tree, uint32_t level,
+                         uint64_t index);
+static void merkle_descend(const crc32_merkle_t* a, const crc32_merkle_t* b,
+                           uint32_t level, uint64_t index, uint64_t* blocks,
+                           uint64_t max, uint64_t* count);
+
+/* Public functions --------------------------------------------------------- */
+bool crc32_merkle_build(crc32_merkle_t* tree, const char* path,
+                        crc32_param_model_e model, uint32_t block_size,
+                        uint32_t fanout, uint32_t threads) {
+    crc_file_info_t info;
+    merkle_job_t job;
+
+    memset(tree, 0, sizeof(*tree));
+    if (path == NULL || (uint32_t)model >= CRC32_NONE_MODEL || block_size == 0
+        || block_size > CRC32_MERKLE_BLOCK_MAX || fanout < 2
+        || !crc_file_info(path, &info)) {
+        return false;
+    }
+
+    tree->model = model;
+    tree->block_size = block_size;
+    tree->fanout = fanout;
+    tree->file_size = info.size;
+    if (!merkle_layout(tree)) {
+        return false;
+    }
+
+    job.tree = tree;
+    job.path = path;
+    crc32_batch_model(&job.batch, model);
+    job.chunk_blocks = MERKLE_CHUNK_BYTES / block_size;
+    job.chunk_blocks = job.chunk_blocks != 0 ? job.chunk_blocks : 1;
+    crc_chunks_init(&job.chunks, (tree->level_len[0] + job.chunk_blocks - 1)
+                                     / job.chunk_blocks);
+
+    threads = threads != 0 ? threads : crc_cpu_count();
+    threads = threads < CRC32_MERKLE_THREADS_MAX ? threads
+                                                 : CRC32_MERKLE_THREADS_MAX;
+    threads = (uint64_t)threads < job.chunks.count ? threads
+                                                   : (uint32_t)job.chunks.count;
+    crc_parallel_run(merkle_worker, &job, 0, threads);
+
+    if (crc_chunks_failed(&job.chunks)) {
+        crc32_merkle_deinit(tree);
+        return false;
+    }
+    merkle_parents(tree);
+
+    return true;
+}
+
+uint32_t crc32_merkle_root(const crc32_merkle_t* tree) {
+    if (tree->levels == 0) {
+        return crc32_calculate(tree->model, NULL, 0);
+    }
+
+    return tree->nodes[tree->level_off[tree->levels - 1]].hash;
+}
+
+uint32_t crc32_merkle_flat_crc(const crc32_merkle_t* tree) {
+    if (tree->levels == 0) {
+        return crc32_calculate(tree->model, NULL, 0);
+    }
+
+    return tree->nodes[tree->level_off[tree->levels - 1]].span;
+}
+
+bool crc32_merkle_verify_range(const crc32_merkle_t* tree, const char* path,
+                               uint64_t offset, uint64_t len, uint64_t* bad,
+                               uint64_t bad_max, uint64_t* bad_count) {
+    crc_batch_model_t batch;
+    uint32_t chunk = MERKLE_CHUNK_BYTES / tree->block_size;
+
+    *bad_count = 0;
+    if (len == 0 || offset >= tree->file_size) {
+        return true;
+    }
+
+    uint64_t end = len < tree->file_size - offset ? offset + len
+                                                  : tree->file_size;
+    uint64_t first = offset / tree->block_size;
+    uint64_t last = (end + tree->block_size - 1) / tree->block_size;
+
+    chunk = chunk != 0 ? chunk : 1;
+    crc32_batch_model(&batch, tree->model);
+
+    uint8_t* data = malloc((size_t)chunk * tree->block_size);
+    const uint8_t** bufs = malloc(chunk * sizeof(bufs[0]));
+    uint32_t* lens = malloc(chunk * sizeof(lens[0]));
+    uint32_t* crcs = malloc(chunk * sizeof(crcs[0]));
+    FILE* fp = fopen(path, "rb");
+    bool ok = data != NULL && bufs != NULL && lens != NULL && crcs != NULL
+              && fp != NULL;
+
+    for (uint64_t block = first; ok && block < last; block += chunk) {
+        uint32_t count = last - block < chunk ? (uint32_t)(last - block)
+                                              : chunk;
+
+        ok = merkle_hash(tree, fp, &batch, block, count, data, bufs, lens,
+                         crcs);
+        for (uint32_t i = 0; ok && i < count; i++) {
+            if (crcs[i] != tree->nodes[block + i].hash) {
+                if (bad != NULL && *bad_count < bad_max) {
+                    bad[*bad_count] = block + i;
+                }
+                (*bad_count)++;
+            }
+        }
+    }
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(crcs);
+    free(lens);
+    free(bufs);
+    free(data);
+
+    return ok;
+}
+
+bool crc32_merkle_diff(const crc32_merkle_t* a, const crc32_merkle_t* b,
+                       uint64_t* blocks, uint64_t max, uint64_t* count) {
+    *count = 0;
+    if (a->model != b->model || a->block_size != b->block_size
+        || a->fanout != b->fanout || a->file_size != b->file_size) {
+        return false;
+    }
+
+    if (a->levels != 0) {
+        merkle_descend(a, b, a->levels - 1, 0, blocks, max, count);
+    }
+
+    return true;
+}
+
+bool crc32_merkle_save(const crc32_merkle_t* tree, const char* path) {
+    uint8_t head[CRC32_MERKLE_HEAD_SIZE];
+    uint64_t leaves = tree->levels != 0 ? tree->level_len[0] : 0;
+
+    crc_put_le(head + 0, MERKLE_MAGIC, 4);
+    crc_put_le(head + 4, CRC32_MERKLE_VERSION, 2);
+    crc_put_le(head + 6, (uint64_t)tree->model, 1);
+    crc_put_le(head + 7, 0, 1);
+    crc_put_le(head + 8, tree->block_size, 4);
+    crc_put_le(head + 12, tree->fanout, 4);
+    crc_put_le(head + 16, tree->file_size, 8);
+    crc_put_le(head + 24, 0, 8);
+
+    return crc_blob_save(path, head, sizeof(head),
+                         leaves != 0 ? &tree->nodes[0].hash : NULL,
+                         sizeof(tree->nodes[0]), leaves);
+}
+
+bool crc32_merkle_load(crc32_merkle_t* tree, const char* path) {
+    uint8_t head[CRC32_MERKLE_HEAD_SIZE];
+    crc_blob_reader_t rd;
+
+    memset(tree, 0, sizeof(*tree));
+
+    bool ok = crc_blob_open(&rd, path, head, sizeof(head))
+              && crc_get_le(head + 0, 4) == MERKLE_MAGIC
+              && crc_get_le(head + 4, 2) == CRC32_MERKLE_VERSION
+              && crc_get_le(head + 6, 1) < CRC32_NONE_MODEL
+              && crc_get_le(head + 8, 4) != 0
+              && crc_get_le(head + 8, 4) <= CRC32_MERKLE_BLOCK_MAX
+              && crc_get_le(head + 12, 4) >= 2;
+
+    if (ok) {
+        tree->model = (crc32_param_model_e)crc_get_le(head + 6, 1);
+        tree->block_size = (uint32_t)crc_get_le(head + 8, 4);
+        tree->fanout = (uint32_t)crc_get_le(head + 12, 4);
+        tree->file_size = crc_get_le(head + 16, 8);
+        ok = merkle_layout(tree);
+    }
+
+    uint64_t leaves = ok && tree->levels != 0 ? tree->level_len[0] : 0;
+    ok = ok
+         && (leaves == 0
+             || crc_blob_read(&rd, &tree->nodes[0].hash,
+                              sizeof(tree->nodes[0]), leaves));
+    ok = crc_blob_close(&rd, ok);
+
+    if (!ok) {
+        crc32_merkle_deinit(tree);
+        return false;
+    }
+    for (uint64_t i = 0; i < leaves; i++) {
+        tree->nodes[i].span = tree->nodes[i].hash;
+    }
+    merkle_parents(tree);
+
+    return true;
+}
+
+void crc32_merkle_deinit(crc32_merkle_t* tree) {
+    free(tree->nodes);
+    tree->nodes = NULL;
+    tree->levels = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Lay out the levels of a tree and allocate its nodes.
+ *
+ * \param[in,out]   tree: Pointer to the tree, geometry set
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool merkle_layout(crc32_merkle_t* tree) {
+    uint64_t len = (tree->file_size + tree->block_size - 1) / tree->block_size;
+    uint64_t total = 0;
+
+    tree->levels = 0;
+    while (len != 0) {
+        tree->level_off[tree->levels] = total;
+        tree->level_len[tree->levels] = len;
+        tree->levels++;
+        total += len;
+        if (len == 1) {
+            break;
+        }
+        len = (len + tree->fanout - 1) / tree->fanout;
+    }
+
+    if (total == 0) {
+        return true;
+    }
+    if (total > SIZE_MAX / sizeof(tree->nodes[0])) {
+        return false;
+    }
+    tree->nodes = malloc((size_t)total * sizeof(tree->nodes[0]));
+
+    return tree->nodes != NULL;
+}
+
+/**
+ * \brief           Derive the parent levels of a tree from its leaves.
+ *
+ * The span of a parent folds the spans of its children with
+ * `crc32_combine_op`. All children but the last of a level have the same
+ * length, so one operator per level serves them.
+ *
+ * \param[in,out]   tree: Pointer to the tree, leaves set
+ */
+static void merkle_parents(crc32_merkle_t* tree) {
+    crc_batch_model_t batch;
+    crc_batch_engine_t eng;
+
+    crc32_batch_model(&batch, tree->model);
+    crc_batch_engine_init(&eng, &batch);
+
+    for (uint32_t level = 1; level < tree->levels; level++) {
+        const crc32_merkle_node_t* child =
+            &tree->nodes[tree->level_off[level - 1]];
+        crc32_merkle_node_t* node = &tree->nodes[tree->level_off[level]];
+        uint64_t children = tree->level_len[level - 1];
+        uint32_t op_full = crc32_combine_gen(tree->model,
+                                             node_len(tree, level - 1, 0));
+        uint32_t op_last = crc32_combine_gen(
+            tree->model, node_len(tree, level - 1, children - 1));
+
+        for (uint64_t i = 0; i < tree->level_len[level]; i++) {
+            uint64_t first = i * tree->fanout;
+            uint64_t end = children - first < tree->fanout
+                               ? children
+                               : first + tree->fanout;
+            uint32_t reg = eng.init;
+            uint8_t le[4];
+
+            node[i].span = child[first].span;
+            for (uint64_t c = first; c < end; c++) {
+                crc_put_le(le, child[c].hash, 4);
+                reg = crc_batch_update(&eng, reg, le, sizeof(le));
+                if (c != first) {
+                    node[i].span = crc32_combine_op(
+                        tree->model, node[i].span, child[c].span,
+                        c + 1 < children ? op_full : op_last);
+                }
+            }
+            node[i].hash = crc_batch_final(&eng, reg);
+        }
+    }
+}
+
+/**
+ * \brief           Hash consecutive blocks of a file.
+ *
+ * \param[in]       tree: Pointer to the tree, geometry set
+ * \param[in]       fp: Data file
+ * \param[in]       batch: Model for the batch engine
+ * \param[in]       first: Index of the first block
+ * \param[in]       count: Number of blocks
+ * \param[out]      data: Buffer of `count` blocks
+ * \param[out]      bufs: Scratch array of `count` block pointers
+ * \param[out]      lens: Scratch array of `count` block lengths
+ * \param[out]      crcs: CRC32 of the blocks
+ * \return          `true` on success, `false` on I/O errors
+ */
+static bool merkle_hash(const crc32_merkle_t* tree, FILE* fp,
+                        const crc_batch_model_t* batch, uint64_t first,
+                        uint32_t count, uint8_t* data, const uint8_t** bufs,
+                        uint32_t* lens, uint32_t* crcs) {
+    uint64_t offset = first * tree->block_size;
+    uint64_t left = tree->file_size - offset;
+    size_t size = (uint64_t)count * tree->block_size < left
+                      ? (size_t)count * tree->block_size
+                      : (size_t)left;
+
+    if (crc_fseek(fp, (int64_t)offset, SEEK_SET) != 0
+        || fread(data, 1, size, fp) != size) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        size_t at = (size_t)i * tree->block_size;
+
+        bufs[i] = data + at;
+        lens[i] = size - at < tree->block_size ? (uint32_t)(size - at)
+                                               : tree->block_size;
+    }
+    crc_batch_calculate(batch, bufs, lens, count, crcs);
+
+    return true;
+}
+
+/**
+ * \brief           Claim chunks of leaves until all are hashed.
+ *
+ * \param[in,out]   arg: Pointer to the job
+ * \return          NULL
+ */
+static void* merkle_worker(void* arg) {
+    merkle_job_t* job = arg;
+    crc32_merkle_t* tree = job->tree;
+    uint32_t n = job->chunk_blocks;
+    uint8_t* data = malloc((size_t)n * tree->block_size);
+    const uint8_t** bufs = malloc(n * sizeof(bufs[0]));
+    uint32_t* lens = malloc(n * sizeof(lens[0]));
+    uint32_t* crcs = malloc(n * sizeof(crcs[0]));
+    FILE* fp = fopen(job->path, "rb");
+    bool ok = data != NULL && bufs != NULL && lens != NULL && crcs != NULL
+              && fp != NULL;
+
+    uint64_t chunk;
+
+    while (ok && crc_chunks_claim(&job->chunks, &chunk)) {
+        uint64_t first = chunk * n;
+        uint32_t count = tree->level_len[0] - first < n
+                             ? (uint32_t)(tree->level_len[0] - first)
+                             : n;
+
+        ok = merkle_hash(tree, fp, &job->batch, first, count, data, bufs,
+                         lens, crcs);
+        for (uint32_t i = 0; ok && i < count; i++) {
+            tree->nodes[first + i].hash = crcs[i];
+            tree->nodes[first + i].span = crcs[i];
+        }
+    }
+
+    if (!ok) {
+        crc_chunks_fail(&job->chunks);
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(crcs);
+    free(lens);
+    free(bufs);
+    free(data);
+
+    return NULL;
+}
+
+/**
+ * \brief           Get the number of file bytes spanned by a node.
+ *
+ * \param[in]       tree: Pointer to the tree
+ * \param[in]       level: Level of the node
+ * \param[in]       index: Index of the node in its level
+ * \return          Number of bytes spanned by the node
+ */
+static uint64_t node_len(const crc32_merkle_t* tree, uint32_t level,
+                         uint64_t index) {
+    uint64_t full = tree->block_size;
+
+    // Saturates: a node can never span more than the file
+    for (uint32_t i = 0; i < level && full < tree->file_size; i++) {
+        full *= tree->fanout;
+    }
+    if (full >= tree->file_size) {
+        return index == 0 ? tree->file_size : 0;
+    }
+
+    uint64_t start = index * full;
+    return tree->file_size - start < full ? tree->file_size - start : full;
+}
+
+/**
+ * \brief           Collect the differing leaves below a node.
+ *
+ * \param[in]       a: Pointer to the first tree
+ * \param[in]       b: Pointer to the second tree, same geometry
+ * \param[in]       level: Level of the node
+ * \param[in]       index: Index of the node in its level
+ * \param[out]      blocks: Indexes of the differing blocks, or NULL
+ * \param[in]       max: Capacity of `blocks`
+ * \param[in,out]   count: Number of differing blocks found so far
+ */
+static void merkle_descend(const crc32_merkle_t* a, const crc32_merkle_t* b,
+                           uint32_t level, uint64_t index, uint64_t* blocks,
+                           uint64_t max, uint64_t* count) {
+    uint64_t at = a->level_off[level] + index;
+
+    if (a->nodes[at].hash == b->nodes[at].hash) {
+        return;
+    }
+
+    if (level == 0) {
+        if (blocks != NULL && *count < max) {
+            blocks[*count] = index;
+        }
+        (*count)++;
+        return;
+    }
+
+    uint64_t first = index * a->fanout;
+    uint64_t end = a->level_len[level - 1] - first < a->fanout
+                       ? a->level_len[level - 1]
+                       : first + a->fanout;
+    for (uint64_t c = first; c < end; c++) {
+        merkle_descend(a, b, level - 1, c, blocks, max, count);
+    }
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,353 @@
+/**
+ * \file            crc32_range.c
+ * \brief           Prefix CRC32 index answering the CRC32 of any byte range
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc32_range.h"
+#include "crc_batch.h"
+#include "crc_blob.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Magic number of the index file, "CRCR".
+ */
+#define RANGE_MAGIC       0x52435243u
+
+/**
+ * \brief           Number of bytes a worker reads at a time, at least a stride.
+ */
+#define RANGE_CHUNK_BYTES (1024 * 1024)
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Stride hashing job shared by all workers.
+ */
+typedef struct {
+    crc32_range_t* idx;        /*!< Index whose strides are hashed */
+    const char* path;          /*!< Data file */
+    crc_batch_model_t batch;   /*!< Model for the batch engine */
+    uint64_t strides;          /*!< Number of full strides */
+    uint32_t chunk_strides;    /*!< Number of strides per chunk */
+    crc_chunks_t chunks;       /*!< Chunks of strides to hash */
+} range_job_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static void* range_worker(void* arg);
+static bool range_read(const crc_batch_engine_t* eng, FILE* fp,
+                       uint64_t offset, uint64_t len, uint8_t* buf,
+                       uint32_t* crc);
+static bool range_prefix(const crc32_range_t* idx,
+                         const crc_batch_engine_t* eng, FILE* fp,
+                         uint64_t pos, uint8_t* buf, uint32_t* crc);
+
+/* Public functions --------------------------------------------------------- */
+bool crc32_range_build(crc32_range_t* idx, const char* path,
+                       crc32_param_model_e model, uint32_t stride,
+                       uint32_t threads) {
+    crc_file_info_t info;
+    range_job_t job;
+
+    memset(idx, 0, sizeof(*idx));
+    if (path == NULL || (uint32_t)model >= CRC32_NONE_MODEL || stride == 0
+        || stride > CRC32_RANGE_STRIDE_MAX || !crc_file_info(path, &info)) {
+        return false;
+    }
+
+    idx->model = model;
+    idx->stride = stride;
+    idx->file_size = info.size;
+    idx->mtime_ns = info.mtime_ns;
+    idx->count = info.size / stride + 1;
+    if (idx->count > SIZE_MAX / sizeof(idx->prefix[0])) {
+        return false;
+    }
+    idx->prefix = malloc((size_t)idx->count * sizeof(idx->prefix[0]));
+    if (idx->prefix == NULL) {
+        return false;
+    }
+
+    job.idx = idx;
+    job.path = path;
+    crc32_batch_model(&job.batch, model);
+    job.strides = idx->count - 1;
+    job.chunk_strides = RANGE_CHUNK_BYTES / stride;
+    job.chunk_strides = job.chunk_strides != 0 ? job.chunk_strides : 1;
+    crc_chunks_init(&job.chunks, (job.strides + job.chunk_strides - 1)
+                                     / job.chunk_strides);
+
+    threads = threads != 0 ? threads : crc_cpu_count();
+    threads = threads < CRC32_RANGE_THREADS_MAX ? threads
+                                                : CRC32_RANGE_THREADS_MAX;
+    threads = (uint64_t)threads < job.chunks.count ? threads
+                                                   : (uint32_t)job.chunks.count;
+    crc_parallel_run(range_worker, &job, 0, threads);
+
+    if (crc_chunks_failed(&job.chunks)) {
+        crc32_range_deinit(idx);
+        return false;
+    }
+
+    // The workers left the CRC32 of stride i in prefix[i + 1]
+    uint32_t op = crc32_combine_gen(model, stride);
+
+    idx->prefix[0] = crc32_calculate(model, NULL, 0);
+    for (uint64_t i = 1; i < idx->count; i++) {
+        idx->prefix[i] = crc32_combine_op(model, idx->prefix[i - 1],
+                                          idx->prefix[i], op);
+    }
+
+    return true;
+}
+
+bool crc32_range_stale(const crc32_range_t* idx, const char* path) {
+    crc_file_info_t info;
+
+    if (!crc_file_info(path, &info)) {
+        return true;
+    }
+
+    return info.size != idx->file_size || info.mtime_ns != idx->mtime_ns;
+}
+
+bool crc32_range_query(const crc32_range_t* idx, const char* path,
+                       uint64_t offset, uint64_t len, uint32_t* crc) {
+    crc_batch_model_t batch;
+    crc_batch_engine_t eng;
+    uint32_t crc_a;
+    uint32_t crc_b;
+
+    if (len > idx->file_size || offset > idx->file_size - len) {
+        return false;
+    }
+
+    crc32_batch_model(&batch, idx->model);
+    crc_batch_engine_init(&eng, &batch);
+
+    uint8_t* buf = malloc(idx->stride);
+    FILE* fp = fopen(path, "rb");
+    bool ok = buf != NULL && fp != NULL;
+
+    if (ok && len <= idx->stride) {
+        ok = range_read(&eng, fp, offset, len, buf, crc);
+    } else if (ok) {
+        ok = range_prefix(idx, &eng, fp, offset, buf, &crc_a)
+             && range_prefix(idx, &eng, fp, offset + len, buf, &crc_b);
+        if (ok) {
+            *crc = crc32_combine_op(idx->model, crc_a, crc_b,
+                                    crc32_combine_gen(idx->model, len));
+        }
+    }
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(buf);
+
+    return ok;
+}
+
+bool crc32_range_save(const crc32_range_t* idx, const char* path) {
+    uint8_t head[CRC32_RANGE_HEAD_SIZE];
+
+    crc_put_le(head + 0, RANGE_MAGIC, 4);
+    crc_put_le(head + 4, CRC32_RANGE_VERSION, 2);
+    crc_put_le(head + 6, (uint64_t)idx->model, 1);
+    crc_put_le(head + 7, 0, 1);
+    crc_put_le(head + 8, idx->stride, 4);
+    crc_put_le(head + 12, 0, 4);
+    crc_put_le(head + 16, idx->file_size, 8);
+    crc_put_le(head + 24, (uint64_t)idx->mtime_ns, 8);
+
+    return crc_blob_save(path, head, sizeof(head), idx->prefix,
+                         sizeof(idx->prefix[0]), idx->count);
+}
+
+bool crc32_range_load(crc32_range_t* idx, const char* path) {
+    uint8_t head[CRC32_RANGE_HEAD_SIZE];
+    crc_blob_reader_t rd;
+
+    memset(idx, 0, sizeof(*idx));
+
+    bool ok = crc_blob_open(&rd, path, head, sizeof(head))
+              && crc_get_le(head + 0, 4) == RANGE_MAGIC
+              && crc_get_le(head + 4, 2) == CRC32_RANGE_VERSION
+              && crc_get_le(head + 6, 1) < CRC32_NONE_MODEL
+              && crc_get_le(head + 8, 4) != 0
+              && crc_get_le(head + 8, 4) <= CRC32_RANGE_STRIDE_MAX;
+
+    if (ok) {
+        idx->model = (crc32_param_model_e)crc_get_le(head + 6, 1);
+        idx->stride = (uint32_t)crc_get_le(head + 8, 4);
+        idx->file_size = crc_get_le(head + 16, 8);
+        idx->mtime_ns = (int64_t)crc_get_le(head + 24, 8);
+        idx->count = idx->file_size / idx->stride + 1;
+        ok = idx->count <= SIZE_MAX / sizeof(idx->prefix[0]);
+    }
+    if (ok) {
+        idx->prefix = malloc((size_t)idx->count * sizeof(idx->prefix[0]));
+        ok = idx->prefix != NULL;
+    }
+    ok = ok
+         && crc_blob_read(&rd, idx->prefix, sizeof(idx->prefix[0]),
+                          idx->count);
+    ok = crc_blob_close(&rd, ok);
+
+    if (!ok) {
+        crc32_range_deinit(idx);
+    }
+
+    return ok;
+}
+
+void crc32_range_deinit(crc32_range_t* idx) {
+    free(idx->prefix);
+    idx->prefix = NULL;
+    idx->count = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Claim chunks of strides until all are hashed.
+ *
+ * \param[in,out]   arg: Pointer to the job
+ * \return          NULL
+ */
+static void* range_worker(void* arg) {
+    range_job_t* job = arg;
+    uint32_t n = job->chunk_strides;
+    uint32_t stride = job->idx->stride;
+    uint8_t* data = malloc((size_t)n * stride);
+    const uint8_t** bufs = malloc(n * sizeof(bufs[0]));
+    uint32_t* lens = malloc(n * sizeof(lens[0]));
+    FILE* fp = fopen(job->path, "rb");
+    bool ok = data != NULL && bufs != NULL && lens != NULL && fp != NULL;
+
+    for (uint32_t i = 0; ok && i < n; i++) {
+        bufs[i] = data + (size_t)i * stride;
+        lens[i] = stride;
+    }
+
+    uint64_t chunk;
+
+    while (ok && crc_chunks_claim(&job->chunks, &chunk)) {
+        uint64_t first = chunk * n;
+        uint32_t count = job->strides - first < n
+                             ? (uint32_t)(job->strides - first)
+                             : n;
+        size_t size = (size_t)count * stride;
+
+        ok = crc_fseek(fp, (int64_t)(first * stride), SEEK_SET) == 0
+             && fread(data, 1, size, fp) == size;
+        if (ok) {
+            crc_batch_calculate(&job->batch, bufs, lens, count,
+                                &job->idx->prefix[first + 1]);
+        }
+    }
+
+    if (!ok) {
+        crc_chunks_fail(&job->chunks);
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(lens);
+    free(bufs);
+    free(data);
+
+    return NULL;
+}
+
+/**
+ * \brief           Read a part of a file and calculate its CRC32.
+ *
+ * \param[in]       eng: Pointer to the engine of the index model
+ * \param[in]       fp: Data file
+ * \param[in]       offset: Offset of the part
+ * \param[in]       len: Length of the part, at most a stride
+ * \param[out]      buf: Scratch buffer of a stride
+ * \param[out]      crc: CRC32 of the part
+ * \return          `true` on success, `false` on I/O errors
+ */
+static bool range_read(const crc_batch_engine_t* eng, FILE* fp,
+                       uint64_t offset, uint64_t len, uint8_t* buf,
+                       uint32_t* crc) {
+    if (crc_fseek(fp, (int64_t)offset, SEEK_SET) != 0
+        || fread(buf, 1, (size_t)len, fp) != len) {
+        return false;
+    }
+
+    *crc = crc_batch_final(eng, crc_batch_update(eng, eng->init, buf,
+                                                 (uint32_t)len));
+
+    return true;
+}
+
+/**
+ * \brief           Calculate the CRC32 of a prefix of a file.
+ *
+ * The prefix is the closest indexed one extended by the partial stride up to
+ * `pos`, which is the only part read.
+ *
+ * \param[in]       idx: Pointer to the index
+ * \param[in]       eng: Pointer to the engine of the index model
+ * \param[in]       fp: Data file
+ * \param[in]       pos: Length of the prefix
+ * \param[out]      buf: Scratch buffer of a stride
+ * \param[out]      crc: CRC32 of the prefix
+ * \return          `true` on success, `false` on I/O errors
+ */
+static bool range_prefix(const crc32_range_t* idx,
+                         const crc_batch_engine_t* eng, FILE* fp,
+                         uint64_t pos, uint8_t* buf, uint32_t* crc) {
+    uint64_t k = pos / idx->stride;
+    uint64_t tail = pos - k * idx->stride;
+    uint32_t tail_crc;
+
+    if (tail == 0) {
+        *crc = idx->prefix[k];
+        return true;
+    }
+    if (!range_read(eng, fp, k * idx->stride, tail, buf, &tail_crc)) {
+        return false;
+    }
+    *crc = crc32_combine(idx->model, idx->prefix[k], tail_crc, tail);
+
+    return true;
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,463 @@
+/**
+ * \file            crc32_region.c
+ * \brief           Checksummed memory region with dirty-page tracking
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <signal.h>
+#include <sys/mman.h>
+#endif
+#include "crc/crc32_region.h"
+#include "crc_batch.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of dirty pages hashed per batch.
+ */
+#define REGION_BATCH 64
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Private state of a region.
+ *
+ * The page checksums are the leaves of a complete binary tree stored as a
+ * heap: node k has the children 2k and 2k+1, the leaves start at `leaves`.
+ * A node holds the CRC32 of the pages below it; leaves past the last page
+ * hold the CRC32 of no data, which `crc32_combine_op` with a length of 0
+ * leaves unchanged.
+ */
+typedef struct {
+    crc_batch_model_t batch;       /*!< Model for the batch engine */
+    uint64_t leaves;               /*!< Number of leaves, a power of two */
+    uint32_t levels;               /*!< Number of levels above the leaves */
+    uint32_t* node;                /*!< Tree of CRC32, 2 * `leaves` nodes */
+    uint32_t* op_full;             /*!< Operator of a full node, per level */
+    uint64_t* list;                /*!< Scratch list of dirty nodes */
+    atomic_uint_least64_t* dirty;  /*!< Bitmap of the dirty pages */
+    uint64_t dirty_words;          /*!< Number of words of `dirty` */
+    crc32_region_t* region;        /*!< Region owning the state */
+} region_state_t;
+
+/* Private variables -------------------------------------------------------- */
+#if !defined(_WIN32)
+/**
+ * \brief           Regions tracked with `mprotect`, looked up by the handler.
+ */
+static _Atomic(region_state_t*) region_tracked[CRC32_REGION_TRACK_MAX];
+
+/**
+ * \brief           Whether the `SIGSEGV` handler is installed.
+ */
+static atomic_bool region_handler_installed;
+
+/**
+ * \brief           `SIGSEGV` action replaced by the handler.
+ */
+static struct sigaction region_prev_action;
+#endif
+
+/* Private function prototypes ---------------------------------------------- */
+static uint64_t node_bytes(const crc32_region_t* region, uint32_t level,
+                           uint64_t index);
+static void region_hash(crc32_region_t* region, region_state_t* st,
+                        const uint64_t* pages, uint32_t count);
+static void region_fold(crc32_region_t* region, region_state_t* st,
+                        uint64_t count);
+#if !defined(_WIN32)
+static void region_protect(crc32_region_t* region, uint64_t page,
+                           uint64_t count, bool writable);
+static void region_on_fault(int sig, siginfo_t* info, void* uctx);
+#endif
+
+/* Public functions --------------------------------------------------------- */
+bool crc32_region_init(crc32_region_t* region, crc32_param_model_e model,
+                       uint8_t* base, size_t size, uint32_t page_size) {
+    memset(region, 0, sizeof(*region));
+    if ((uint32_t)model >= CRC32_NONE_MODEL || page_size == 0
+        || (base == NULL && size != 0)) {
+        return false;
+    }
+
+    region->model = model;
+    region->base = base;
+    region->size = size;
+    region->page_size = page_size;
+    region->pages = (size + page_size - 1) / page_size;
+
+    region_state_t* st = calloc(1, sizeof(*st));
+    if (st == NULL) {
+        return false;
+    }
+    region->state = st;
+    st->region = region;
+    crc32_batch_model(&st->batch, model);
+
+    st->leaves = 1;
+    while (st->leaves < region->pages) {
+        st->leaves <<= 1;
+        st->levels++;
+    }
+    st->dirty_words = (region->pages + 63) / 64;
+    st->node = malloc(2 * st->leaves * sizeof(st->node[0]));
+    st->op_full = malloc((st->levels + 1) * sizeof(st->op_full[0]));
+    st->list = malloc(st->leaves * sizeof(st->list[0]));
+    st->dirty = calloc(st->dirty_words + 1, sizeof(st->dirty[0]));
+    if (st->node == NULL || st->op_full == NULL || st->list == NULL
+        || st->dirty == NULL) {
+        crc32_region_deinit(region);
+        return false;
+    }
+
+    // A full node of level l spans 2^l pages
+    uint64_t bytes = page_size;
+    for (uint32_t l = 0; l <= st->levels; l++) {
+        st->op_full[l] = crc32_combine_gen(model, bytes);
+        bytes <<= 1;
+    }
+
+    uint32_t empty = crc32_calculate(model, NULL, 0);
+    for (uint64_t k = st->leaves + region->pages; k < 2 * st->leaves; k++) {
+        st->node[k] = empty;
+    }
+
+    // Hash every page, then build every parent
+    for (uint64_t p = 0; p < region->pages; p += REGION_BATCH) {
+        uint32_t count = region->pages - p < REGION_BATCH
+                             ? (uint32_t)(region->pages - p)
+                             : REGION_BATCH;
+
+        for (uint32_t i = 0; i < count; i++) {
+            st->list[i] = p + i;
+        }
+        region_hash(region, st, st->list, count);
+    }
+    for (uint64_t k = 0; k < st->leaves; k++) {
+        st->list[k] = st->leaves + k;
+    }
+    region_fold(region, st, st->leaves);
+    region->rehashed = region->pages;
+
+    return true;
+}
+
+void crc32_region_mark(crc32_region_t* region, size_t offset, size_t len) {
+    region_state_t* st = region->state;
+
+    if (len == 0 || offset >= region->size) {
+        return;
+    }
+    len = len < region->size - offset ? len : region->size - offset;
+
+    uint64_t first = offset / region->page_size;
+    uint64_t last = (offset + len - 1) / region->page_size;
+    for (uint64_t p = first; p <= last; p++) {
+        atomic_fetch_or(&st->dirty[p / 64], (uint64_t)1 << (p % 64));
+    }
+}
+
+void crc32_region_write(crc32_region_t* region, size_t offset,
+                        const void* buf, size_t len) {
+    memcpy(region->base + offset, buf, len);
+    crc32_region_mark(region, offset, len);
+}
+
+bool crc32_region_track(crc32_region_t* region, bool enable) {
+#if defined(_WIN32)
+    (void)region;
+    return !enable;
+#else
+    region_state_t* st = region->state;
+    long sys_page = sysconf(_SC_PAGESIZE);
+
+    if (enable == region->tracking) {
+        return true;
+    }
+
+    if (!enable) {
+        for (uint32_t i = 0; i < CRC32_REGION_TRACK_MAX; i++) {
+            region_state_t* expected = st;
+            atomic_compare_exchange_strong(&region_tracked[i], &expected,
+                                           NULL);
+        }
+        region_protect(region, 0, region->pages, true);
+        region->tracking = false;
+        return true;
+    }
+
+    // mprotect covers whole system pages: the region must not share one
+    if (sys_page <= 0 || region->page_size % (uint32_t)sys_page != 0
+        || (uintptr_t)region->base % (uintptr_t)sys_page != 0
+        || region->size % (size_t)sys_page != 0) {
+        return false;
+    }
+
+    if (!atomic_exchange(&region_handler_installed, true)) {
+        struct sigaction action;
+
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = region_on_fault;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGSEGV, &action, &region_prev_action) != 0) {
+            atomic_store(&region_handler_installed, false);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < CRC32_REGION_TRACK_MAX; i++) {
+        region_state_t* expected = NULL;
+
+        if (atomic_compare_exchange_strong(&region_tracked[i], &expected,
+                                           st)) {
+            region->tracking = true;
+            region_protect(region, 0, region->pages, false);
+            return true;
+        }
+    }
+
+    return false;
+#endif
+}
+
+uint32_t crc32_region_crc(crc32_region_t* region) {
+    region_state_t* st = region->state;
+    uint64_t count = 0;
+
+    // Collect the dirty pages, clearing their bits
+    for (uint64_t w = 0; w < st->dirty_words; w++) {
+        uint64_t bits = atomic_exchange(&st->dirty[w], 0);
+
+        while (bits != 0) {
+            uint32_t b = 0;
+
+            while (((bits >> b) & 1) == 0) {
+                b++;
+            }
+            bits &= bits - 1;
+            st->list[count++] = w * 64 + b;
+        }
+    }
+    region->rehashed = count;
+
+#if !defined(_WIN32)
+    // Protect again before hashing: a write racing with the hash faults and
+    // marks the page for the next call
+    for (uint64_t i = 0; region->tracking && i < count; i++) {
+        region_protect(region, st->list[i], 1, false);
+    }
+#endif
+
+    for (uint64_t i = 0; i < count; i += REGION_BATCH) {
+        uint32_t n = count - i < REGION_BATCH ? (uint32_t)(count - i)
+                                              : REGION_BATCH;
+
+        region_hash(region, st, &st->list[i], n);
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        st->list[i] += st->leaves;
+    }
+    region_fold(region, st, count);
+
+    // With a single leaf, the leaf is the root
+    return st->node[1];
+}
+
+void crc32_region_deinit(crc32_region_t* region) {
+    region_state_t* st = region->state;
+
+    if (st == NULL) {
+        return;
+    }
+    if (region->tracking) {
+        crc32_region_track(region, false);
+    }
+
+    free((void*)st->dirty);
+    free(st->list);
+    free(st->op_full);
+    free(st->node);
+    free(st);
+    region->state = NULL;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Get the number of region bytes below a tree node.
+ *
+ * \param[in]       region: Pointer to the region
+ * \param[in]       level: Level of the node, 0 for a leaf
+ * \param[in]       index: Index of the node in its level
+ * \return          Number of bytes below the node
+ */
+static uint64_t node_bytes(const crc32_region_t* region, uint32_t level,
+                           uint64_t index) {
+    uint64_t first = index << level;
+    uint64_t end = (index + 1) << level;
+
+    if (first >= region->pages) {
+        return 0;
+    }
+    end = end < region->pages ? end : region->pages;
+    uint64_t stop = end * region->page_size;
+
+    return (stop < region->size ? stop : region->size)
+           - first * region->page_size;
+}
+
+/**
+ * \brief           Hash pages into the leaves of the tree.
+ *
+ * \param[in]       region: Pointer to the region
+ * \param[in,out]   st: Pointer to the state of the region
+ * \param[in]       pages: Indexes of the pages
+ * \param[in]       count: Number of pages, at most `REGION_BATCH`
+ */
+static void region_hash(crc32_region_t* region, region_state_t* st,
+                        const uint64_t* pages, uint32_t count) {
+    const uint8_t* bufs[REGION_BATCH] = {NULL};
+    uint32_t lens[REGION_BATCH] = {0};
+    uint32_t crcs[REGION_BATCH];
+
+    for (uint32_t i = 0; i < count; i++) {
+        bufs[i] = region->base + pages[i] * region->page_size;
+        lens[i] = (uint32_t)node_bytes(region, 0, pages[i]);
+    }
+    crc_batch_calculate(&st->batch, bufs, lens, count, crcs);
+    for (uint32_t i = 0; i < count; i++) {
+        st->node[st->leaves + pages[i]] = crcs[i];
+    }
+}
+
+/**
+ * \brief           Recompute the ancestors of changed nodes.
+ *
+ * \param[in]       region: Pointer to the region
+ * \param[in,out]   st: Pointer to the state of the region, `list` holding
+ *                  the changed leaves in ascending order
+ * \param[in]       count: Number of changed leaves
+ */
+static void region_fold(crc32_region_t* region, region_state_t* st,
+                        uint64_t count) {
+    for (uint32_t level = 1; level <= st->levels && count != 0; level++) {
+        uint64_t parents = 0;
+
+        // Parents of sorted nodes are sorted: drop the repeated ones
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t k = st->list[i] >> 1;
+
+            if (parents == 0 || st->list[parents - 1] != k) {
+                st->list[parents++] = k;
+            }
+        }
+        count = parents;
+
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t k = st->list[i];
+            uint64_t right = 2 * k + 1 - (st->leaves >> (level - 1));
+            uint64_t len = node_bytes(region, level - 1, right);
+            uint32_t op = len == (uint64_t)region->page_size << (level - 1)
+                              ? st->op_full[level - 1]
+                              : crc32_combine_gen(region->model, len);
+
+            st->node[k] = crc32_combine_op(region->model, st->node[2 * k],
+                                           st->node[2 * k + 1], op);
+        }
+    }
+}
+
+#if !defined(_WIN32)
+/**
+ * \brief           Change the protection of pages of a tracked region.
+ *
+ * \param[in]       region: Pointer to the region
+ * \param[in]       page: Index of the first page
+ * \param[in]       count: Number of pages
+ * \param[in]       writable: Whether the pages become writable
+ */
+static void region_protect(crc32_region_t* region, uint64_t page,
+                           uint64_t count, bool writable) {
+    size_t offset = (size_t)(page * region->page_size);
+    size_t len = (size_t)(count * region->page_size);
+
+    if (count == 0) {
+        return;
+    }
+    // The last page may be short, though it ends on a system page
+    len = len < region->size - offset ? len : region->size - offset;
+    mprotect(region->base + offset, len,
+             writable ? PROT_READ | PROT_WRITE : PROT_READ);
+}
+
+/**
+ * \brief           `SIGSEGV` handler marking the first write to a page.
+ *
+ * \param[in]       sig: Signal number
+ * \param[in]       info: Signal information, holding the faulting address
+ * \param[in]       uctx: Signal context
+ */
+static void region_on_fault(int sig, siginfo_t* info, void* uctx) {
+    uint8_t* addr = info->si_addr;
+
+    for (uint32_t i = 0; i < CRC32_REGION_TRACK_MAX; i++) {
+        region_state_t* st = atomic_load(&region_tracked[i]);
+
+        if (st == NULL || addr < st->region->base
+            || addr >= st->region->base + st->region->size) {
+            continue;
+        }
+
+        uint64_t page = (uint64_t)(addr - st->region->base)
+                        / st->region->page_size;
+        atomic_fetch_or(&st->dirty[page / 64], (uint64_t)1 << (page % 64));
+        region_protect(st->region, page, 1, true);
+        return;
+    }
+
+    // Not ours: hand over to the previous action
+    if (region_prev_action.sa_flags & SA_SIGINFO) {
+        region_prev_action.sa_sigaction(sig, info, uctx);
+    } else if (region_prev_action.sa_handler != SIG_DFL
+               && region_prev_action.sa_handler != SIG_IGN) {
+        region_prev_action.sa_handler(sig);
+    } else {
+        // Re-executing the faulting access now terminates the process
+        signal(sig, SIG_DFL);
+    }
+}
+#endif
+
+/* ----------------------------- end of file -------------------------------- */
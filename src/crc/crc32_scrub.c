@@ -0,0 +1,318 @@
+/**
+ * \file            crc32_scrub.c
+ * \brief           Parallel scrub of files made of CRC32 protected fixed-size
+ *                  records
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc32_scrub.h"
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Scrub job shared by all workers.
+ */
+typedef struct {
+    crc32_param_model_e model; /*!< CRC32 model of the record trailers */
+    uint32_t record_size;      /*!< Record size in bytes */
+    uint32_t chunk_records;    /*!< Number of records per chunk */
+    uint64_t records;          /*!< Number of records to verify */
+    const char* path;          /*!< File to read, NULL for `buf` */
+    const uint8_t* buf;        /*!< Records in memory */
+    crc_chunks_t chunks;       /*!< Chunks of records to verify */
+} scrub_job_t;
+
+/**
+ * \brief           Per-worker state.
+ */
+typedef struct {
+    scrub_job_t* job;   /*!< Shared job */
+    uint64_t* bad;      /*!< Offsets of the corrupt records found */
+    uint64_t bad_count; /*!< Number of offsets in `bad` */
+    uint64_t bad_cap;   /*!< Capacity of `bad` */
+} scrub_worker_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static bool scrub_run(const crc32_scrub_cfg_t* cfg, const char* path,
+                      const uint8_t* buf, uint64_t len,
+                      crc32_scrub_report_t* report);
+static void* scrub_worker(void* arg);
+static bool scrub_push(scrub_worker_t* worker, uint64_t offset);
+static int scrub_cmp(const void* a, const void* b);
+
+/* Public functions --------------------------------------------------------- */
+bool crc32_scrub_file(const crc32_scrub_cfg_t* cfg, const char* path,
+                      crc32_scrub_report_t* report) {
+    if (path == NULL) {
+        return false;
+    }
+
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return false;
+    }
+
+    bool ok = crc_fseek(fp, 0, SEEK_END) == 0;
+    int64_t len = ok ? (int64_t)crc_ftell(fp) : -1;
+    fclose(fp);
+    if (len < 0) {
+        return false;
+    }
+
+    return scrub_run(cfg, path, NULL, (uint64_t)len, report);
+}
+
+bool crc32_scrub_buf(const crc32_scrub_cfg_t* cfg, const uint8_t* buf,
+                     uint64_t len, crc32_scrub_report_t* report) {
+    if (buf == NULL && len != 0) {
+        return false;
+    }
+
+    return scrub_run(cfg, NULL, buf, len, report);
+}
+
+void crc32_scrub_report_free(crc32_scrub_report_t* report) {
+    free(report->bad);
+    report->bad = NULL;
+    report->bad_count = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Split the records into chunks and verify them in parallel.
+ *
+ * \param[in]       cfg: Pointer to the scrub configuration
+ * \param[in]       path: File to read, or NULL
+ * \param[in]       buf: Records in memory if `path` is NULL
+ * \param[in]       len: Length of the file or buffer in bytes
+ * \param[out]      report: Pointer to the report
+ * \return          `true` on success, `false` otherwise
+ */
+static bool scrub_run(const crc32_scrub_cfg_t* cfg, const char* path,
+                      const uint8_t* buf, uint64_t len,
+                      crc32_scrub_report_t* report) {
+    if (cfg == NULL || report == NULL || cfg->record_size <= sizeof(uint32_t)
+        || (uint32_t)cfg->model >= CRC32_NONE_MODEL) {
+        return false;
+    }
+
+    double start = crc_time_now();
+    scrub_job_t job;
+    scrub_worker_t workers[CRC32_SCRUB_THREADS_MAX];
+    uint32_t threads = cfg->threads != 0 ? cfg->threads : crc_cpu_count();
+    bool ok = true;
+
+    memset(report, 0, sizeof(*report));
+    job.model = cfg->model;
+    job.record_size = cfg->record_size;
+    job.chunk_records = CRC32_SCRUB_CHUNK_BYTES / cfg->record_size;
+    job.chunk_records = job.chunk_records != 0 ? job.chunk_records : 1;
+    job.records = len / cfg->record_size;
+    job.path = path;
+    job.buf = buf;
+    crc_chunks_init(&job.chunks, (job.records + job.chunk_records - 1)
+                                     / job.chunk_records);
+
+    threads = threads < CRC32_SCRUB_THREADS_MAX ? threads
+                                                : CRC32_SCRUB_THREADS_MAX;
+    threads = (uint64_t)threads < job.chunks.count ? threads
+                                                   : (uint32_t)job.chunks.count;
+    threads = threads != 0 ? threads : 1;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        workers[i].job = &job;
+        workers[i].bad = NULL;
+        workers[i].bad_count = 0;
+        workers[i].bad_cap = 0;
+    }
+
+    crc_parallel_run(scrub_worker, workers, sizeof(workers[0]), threads);
+    ok = !crc_chunks_failed(&job.chunks);
+
+    for (uint32_t i = 0; i < threads; i++) {
+        report->bad_count += workers[i].bad_count;
+    }
+    if (ok && report->bad_count != 0) {
+        report->bad = malloc(report->bad_count * sizeof(report->bad[0]));
+        ok = report->bad != NULL;
+    }
+    if (ok) {
+        uint64_t at = 0;
+
+        for (uint32_t i = 0; i < threads; i++) {
+            if (workers[i].bad_count != 0) {
+                memcpy(&report->bad[at], workers[i].bad,
+                       workers[i].bad_count * sizeof(report->bad[0]));
+            }
+            at += workers[i].bad_count;
+        }
+        // Chunks are claimed out of order
+        qsort(report->bad, report->bad_count, sizeof(report->bad[0]),
+              scrub_cmp);
+    } else {
+        report->bad_count = 0;
+    }
+    for (uint32_t i = 0; i < threads; i++) {
+        free(workers[i].bad);
+    }
+
+    report->records = job.records;
+    report->bytes = job.records * cfg->record_size;
+    report->tail = len - report->bytes;
+    report->seconds = crc_time_now() - start;
+    if (report->seconds > 0) {
+        report->gb_per_sec = (double)report->bytes / report->seconds / 1e9;
+        report->records_per_sec = (double)report->records / report->seconds;
+    }
+
+    return ok;
+}
+
+/**
+ * \brief           Claim chunks until all are verified.
+ *
+ * \param[in,out]   arg: Pointer to the worker state
+ * \return          NULL
+ */
+static void* scrub_worker(void* arg) {
+    scrub_worker_t* worker = arg;
+    scrub_job_t* job = worker->job;
+    uint32_t n = job->chunk_records;
+    size_t chunk_bytes = (size_t)n * job->record_size;
+    const uint8_t** bufs = malloc(n * sizeof(bufs[0]));
+    uint32_t* lens = malloc(n * sizeof(lens[0]));
+    uint64_t* ok_bitmap = malloc(((n + 63) / 64) * sizeof(ok_bitmap[0]));
+    uint8_t* data = job->path != NULL ? malloc(chunk_bytes) : NULL;
+    FILE* fp = job->path != NULL ? fopen(job->path, "rb") : NULL;
+    bool ok = bufs != NULL && lens != NULL && ok_bitmap != NULL
+              && (job->path == NULL || (data != NULL && fp != NULL));
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (lens != NULL) {
+            lens[i] = job->record_size;
+        }
+    }
+
+    uint64_t chunk;
+
+    while (ok && crc_chunks_claim(&job->chunks, &chunk)) {
+        uint64_t first = chunk * n;
+        uint32_t count = job->records - first < n
+                             ? (uint32_t)(job->records - first)
+                             : n;
+        uint64_t offset = first * job->record_size;
+        const uint8_t* records = data;
+
+        if (fp != NULL) {
+            size_t size = (size_t)count * job->record_size;
+
+            ok = crc_fseek(fp, (int64_t)offset, SEEK_SET) == 0
+                 && fread(data, 1, size, fp) == size;
+        } else {
+            records = job->buf + offset;
+        }
+
+        for (uint32_t i = 0; ok && i < count; i++) {
+            bufs[i] = records + (size_t)i * job->record_size;
+        }
+
+        if (ok
+            && crc32_verify_bufs(job->model, bufs, lens, count, ok_bitmap)
+                   != count) {
+            for (uint32_t i = 0; ok && i < count; i++) {
+                uint64_t at = offset + (uint64_t)i * job->record_size;
+
+                if (!((ok_bitmap[i / 64] >> (i % 64)) & 1)) {
+                    ok = scrub_push(worker, at);
+                }
+            }
+        }
+    }
+
+    if (!ok) {
+        crc_chunks_fail(&job->chunks);
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(data);
+    free(ok_bitmap);
+    free(lens);
+    free(bufs);
+
+    return NULL;
+}
+
+/**
+ * \brief           Record the offset of a corrupt record.
+ *
+ * \param[in,out]   worker: Pointer to the worker state
+ * \param[in]       offset: Offset of the record
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool scrub_push(scrub_worker_t* worker, uint64_t offset) {
+    if (worker->bad_count == worker->bad_cap) {
+        uint64_t cap = worker->bad_cap != 0 ? worker->bad_cap * 2 : 64;
+        uint64_t* bad = realloc(worker->bad, cap * sizeof(bad[0]));
+
+        if (bad == NULL) {
+            return false;
+        }
+        worker->bad = bad;
+        worker->bad_cap = cap;
+    }
+
+    worker->bad[worker->bad_count++] = offset;
+
+    return true;
+}
+
+/**
+ * \brief           Compare two record offsets for `qsort`.
+ *
+ * \param[in]       a: Pointer to the first offset
+ * \param[in]       b: Pointer to the second offset
+ * \return          Negative, zero or positive as `a` is below, equal to or
+ *                  above `b`
+ */
+static int scrub_cmp(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,377 @@
+/**
+ * \file            crc32_sidecar.c
+ * \brief           Per-block CRC32 sidecar index with incremental re-
+ *                  verification
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc32_sidecar.h"
+#include "crc_batch.h"
+#include "crc_blob.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Magic number of the sidecar file, "CRCS".
+ */
+#define SIDECAR_MAGIC       0x53435243u
+
+/**
+ * \brief           Number of bytes read from the data file at a time.
+ */
+#define SIDECAR_CHUNK_BYTES (1024 * 1024)
+
+/* Private function prototypes ---------------------------------------------- */
+static uint32_t block_len(uint64_t file_size, uint32_t block_size,
+                          uint64_t block);
+static bool sidecar_hash(const crc32_sidecar_t* sc, FILE* fp,
+                         uint64_t file_size, uint64_t first, uint64_t count,
+                         uint32_t* out);
+static bool sidecar_resize(crc32_sidecar_t* sc, uint64_t file_size);
+
+/* Public functions --------------------------------------------------------- */
+bool crc32_sidecar_build(crc32_sidecar_t* sc, const char* path,
+                         crc32_param_model_e model, uint32_t block_size) {
+    crc_file_info_t info;
+
+    memset(sc, 0, sizeof(*sc));
+    if (path == NULL || (uint32_t)model >= CRC32_NONE_MODEL || block_size == 0
+        || block_size > CRC32_SIDECAR_BLOCK_MAX
+        || !crc_file_info(path, &info)) {
+        return false;
+    }
+
+    sc->model = model;
+    sc->block_size = block_size;
+
+    FILE* fp = fopen(path, "rb");
+    bool ok = fp != NULL && sidecar_resize(sc, info.size)
+              && sidecar_hash(sc, fp, info.size, 0, sc->blocks, sc->crc);
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    if (!ok) {
+        crc32_sidecar_deinit(sc);
+        return false;
+    }
+
+    sc->file_size = info.size;
+    sc->mtime_ns = info.mtime_ns;
+
+    return true;
+}
+
+bool crc32_sidecar_stale(const crc32_sidecar_t* sc, const char* path) {
+    crc_file_info_t info;
+
+    if (!crc_file_info(path, &info)) {
+        return true;
+    }
+
+    return info.size != sc->file_size || info.mtime_ns != sc->mtime_ns;
+}
+
+bool crc32_sidecar_update(crc32_sidecar_t* sc, const char* path,
+                          uint64_t offset, uint64_t len) {
+    crc_file_info_t info;
+
+    if (!crc_file_info(path, &info)) {
+        return false;
+    }
+
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return false;
+    }
+
+    uint64_t old_size = sc->file_size;
+    bool ok = sidecar_resize(sc, info.size);
+
+    // Blocks between the old and the new end of the file
+    if (ok && info.size != old_size) {
+        uint64_t first = (old_size < info.size ? old_size : info.size)
+                         / sc->block_size;
+
+        ok = sidecar_hash(sc, fp, info.size, first, sc->blocks - first,
+                          sc->crc + first);
+    }
+
+    // Blocks overlapping the rewritten range
+    if (ok && len != 0 && offset < info.size) {
+        uint64_t end = len < info.size - offset ? offset + len : info.size;
+        uint64_t first = offset / sc->block_size;
+        uint64_t last = (end + sc->block_size - 1) / sc->block_size;
+
+        ok = sidecar_hash(sc, fp, info.size, first, last - first,
+                          sc->crc + first);
+    }
+    fclose(fp);
+
+    if (ok) {
+        sc->file_size = info.size;
+        sc->mtime_ns = info.mtime_ns;
+    }
+
+    return ok;
+}
+
+bool crc32_sidecar_verify(const crc32_sidecar_t* sc, const char* path,
+                          uint64_t* bad, uint64_t bad_max,
+                          uint64_t* bad_count) {
+    crc_file_info_t info;
+    uint32_t chunk = SIDECAR_CHUNK_BYTES / sc->block_size;
+
+    *bad_count = 0;
+    chunk = chunk != 0 ? chunk : 1;
+    if (!crc_file_info(path, &info)) {
+        return false;
+    }
+
+    uint64_t blocks = (info.size + sc->block_size - 1) / sc->block_size;
+    uint64_t total = blocks > sc->blocks ? blocks : sc->blocks;
+    uint32_t* crc = malloc(chunk * sizeof(crc[0]));
+    FILE* fp = fopen(path, "rb");
+    bool ok = crc != NULL && fp != NULL;
+
+    for (uint64_t first = 0; ok && first < total; first += chunk) {
+        uint64_t count = total - first < chunk ? total - first : chunk;
+        uint64_t hashed = 0;
+
+        if (first < blocks) {
+            hashed = blocks - first < count ? blocks - first : count;
+            ok = sidecar_hash(sc, fp, info.size, first, hashed, crc);
+        }
+
+        for (uint64_t i = 0; ok && i < count; i++) {
+            uint64_t block = first + i;
+            bool match = i < hashed && block < sc->blocks
+                         && block_len(info.size, sc->block_size, block)
+                                == block_len(sc->file_size, sc->block_size,
+                                             block)
+                         && crc[i] == sc->crc[block];
+
+            if (!match) {
+                if (bad != NULL && *bad_count < bad_max) {
+                    bad[*bad_count] = block;
+                }
+                (*bad_count)++;
+            }
+        }
+    }
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(crc);
+
+    return ok;
+}
+
+uint32_t crc32_sidecar_file_crc(const crc32_sidecar_t* sc) {
+    if (sc->blocks == 0) {
+        return crc32_calculate(sc->model, NULL, 0);
+    }
+
+    uint32_t op = crc32_combine_gen(sc->model, sc->block_size);
+    uint32_t crc = sc->crc[0];
+
+    for (uint64_t i = 1; i < sc->blocks; i++) {
+        uint32_t len = block_len(sc->file_size, sc->block_size, i);
+
+        crc = crc32_combine_op(sc->model, crc, sc->crc[i],
+                               len == sc->block_size
+                                   ? op
+                                   : crc32_combine_gen(sc->model, len));
+    }
+
+    return crc;
+}
+
+bool crc32_sidecar_save(const crc32_sidecar_t* sc, const char* path) {
+    uint8_t head[CRC32_SIDECAR_HEAD_SIZE];
+
+    crc_put_le(head + 0, SIDECAR_MAGIC, 4);
+    crc_put_le(head + 4, CRC32_SIDECAR_VERSION, 2);
+    crc_put_le(head + 6, (uint64_t)sc->model, 1);
+    crc_put_le(head + 7, 0, 1);
+    crc_put_le(head + 8, sc->block_size, 4);
+    crc_put_le(head + 12, 0, 4);
+    crc_put_le(head + 16, sc->file_size, 8);
+    crc_put_le(head + 24, (uint64_t)sc->mtime_ns, 8);
+
+    return crc_blob_save(path, head, sizeof(head), sc->crc, sizeof(sc->crc[0]),
+                         sc->blocks);
+}
+
+bool crc32_sidecar_load(crc32_sidecar_t* sc, const char* path) {
+    uint8_t head[CRC32_SIDECAR_HEAD_SIZE];
+    crc_blob_reader_t rd;
+
+    memset(sc, 0, sizeof(*sc));
+
+    bool ok = crc_blob_open(&rd, path, head, sizeof(head))
+              && crc_get_le(head + 0, 4) == SIDECAR_MAGIC
+              && crc_get_le(head + 4, 2) == CRC32_SIDECAR_VERSION
+              && crc_get_le(head + 6, 1) < CRC32_NONE_MODEL
+              && crc_get_le(head + 8, 4) != 0
+              && crc_get_le(head + 8, 4) <= CRC32_SIDECAR_BLOCK_MAX;
+
+    if (ok) {
+        sc->model = (crc32_param_model_e)crc_get_le(head + 6, 1);
+        sc->block_size = (uint32_t)crc_get_le(head + 8, 4);
+        sc->mtime_ns = (int64_t)crc_get_le(head + 24, 8);
+        ok = sidecar_resize(sc, crc_get_le(head + 16, 8));
+        sc->file_size = crc_get_le(head + 16, 8);
+    }
+    ok = ok && crc_blob_read(&rd, sc->crc, sizeof(sc->crc[0]), sc->blocks);
+    ok = crc_blob_close(&rd, ok);
+
+    if (!ok) {
+        crc32_sidecar_deinit(sc);
+    }
+
+    return ok;
+}
+
+void crc32_sidecar_deinit(crc32_sidecar_t* sc) {
+    free(sc->crc);
+    sc->crc = NULL;
+    sc->blocks = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Get the length of a block of a file.
+ *
+ * \param[in]       file_size: File size in bytes
+ * \param[in]       block_size: Block size in bytes
+ * \param[in]       block: Index of the block
+ * \return          Length of the block in bytes, 0 past the end of the file
+ */
+static uint32_t block_len(uint64_t file_size, uint32_t block_size,
+                          uint64_t block) {
+    uint64_t start = block * block_size;
+
+    if (start >= file_size) {
+        return 0;
+    }
+
+    return file_size - start < block_size ? (uint32_t)(file_size - start)
+                                          : block_size;
+}
+
+/**
+ * \brief           Hash consecutive blocks of a file.
+ *
+ * \param[in]       sc: Pointer to the index (model and block size)
+ * \param[in]       fp: Data file
+ * \param[in]       file_size: Size of the data file in bytes
+ * \param[in]       first: Index of the first block
+ * \param[in]       count: Number of blocks, all within the file
+ * \param[out]      out: CRC32 of each block
+ * \return          `true` on success, `false` on I/O or allocation errors
+ */
+static bool sidecar_hash(const crc32_sidecar_t* sc, FILE* fp,
+                         uint64_t file_size, uint64_t first, uint64_t count,
+                         uint32_t* out) {
+    crc_batch_model_t batch;
+    uint32_t chunk = SIDECAR_CHUNK_BYTES / sc->block_size;
+
+    if (count == 0) {
+        return true;
+    }
+
+    chunk = chunk != 0 ? chunk : 1;
+    crc32_batch_model(&batch, sc->model);
+
+    uint8_t* data = malloc((size_t)chunk * sc->block_size);
+    const uint8_t** bufs = malloc(chunk * sizeof(bufs[0]));
+    uint32_t* lens = malloc(chunk * sizeof(lens[0]));
+    bool ok = data != NULL && bufs != NULL && lens != NULL
+              && crc_fseek(fp, (int64_t)(first * sc->block_size), SEEK_SET)
+                     == 0;
+
+    for (uint64_t done = 0; ok && done < count; done += chunk) {
+        uint32_t n = count - done < chunk ? (uint32_t)(count - done) : chunk;
+        size_t size = 0;
+
+        for (uint32_t i = 0; i < n; i++) {
+            bufs[i] = data + size;
+            lens[i] = block_len(file_size, sc->block_size, first + done + i);
+            size += lens[i];
+        }
+
+        ok = fread(data, 1, size, fp) == size;
+        if (ok) {
+            crc_batch_calculate(&batch, bufs, lens, n, out + done);
+        }
+    }
+
+    free(lens);
+    free(bufs);
+    free(data);
+
+    return ok;
+}
+
+/**
+ * \brief           Resize the block array of an index for a file size.
+ *
+ * \param[in,out]   sc: Pointer to the index
+ * \param[in]       file_size: New file size in bytes
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool sidecar_resize(crc32_sidecar_t* sc, uint64_t file_size) {
+    uint64_t blocks = (file_size + sc->block_size - 1) / sc->block_size;
+
+    if (blocks > SIZE_MAX / sizeof(sc->crc[0])) {
+        return false;
+    }
+    if (blocks != 0) {
+        uint32_t* crc = realloc(sc->crc, (size_t)blocks * sizeof(crc[0]));
+
+        if (crc == NULL) {
+            return false;
+        }
+        sc->crc = crc;
+    }
+    sc->blocks = blocks;
+
+    return true;
+}
+
+/* ----------------------------- end of file -------------------------------- */
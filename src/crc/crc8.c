@@ -33,8 +33,21 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <stddef.h>
 #include "crc/crc8.h"
 #include "crc/bit_utils.h"
+#include "crc_batch.h"
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           CRC8 residues, indexed by model.
+ */
+static const uint8_t crc8_residue_table[CRC8_NONE_MODEL] = {
+    0x00, // CRC8_MODEL
+    0xF9, // CRC8_ITU_MODEL
+    0x00, // CRC8_ROHC_MODEL
+    0x00, // CRC8_MAXIM_MODEL
+};
 
 /* Public functions --------------------------------------------------------- */
 void crc8_init(crc8_ctx_t* ctx, crc8_param_model_e model) {
@@ -166,4 +179,65 @@ bool crc8_verify_buf(crc8_param_model_e model, const uint8_t* buf,
     return (stored_crc == calculated_crc);
 }
 
+uint8_t crc8_residue(crc8_param_model_e model) {
+    if ((uint32_t)model >= CRC8_NONE_MODEL) {
+        return 0;
+    }
+
+    return crc8_residue_table[model];
+}
+
+void crc8_verify_stream_init(crc8_stream_t* stream, crc8_param_model_e model) {
+    crc8_init(&stream->ctx, model);
+    stream->residue = crc8_residue(model);
+    stream->len = 0;
+}
+
+void crc8_verify_stream_update(crc8_stream_t* stream, const uint8_t* buf,
+                               uint32_t len) {
+    // A single-byte trailer always cancels into the residue
+    crc8_update(&stream->ctx, buf, len);
+    stream->len += len;
+}
+
+bool crc8_verify_stream(const crc8_stream_t* stream) {
+    if (stream->len <= sizeof(uint8_t)) {
+        return false; // Not enough bytes for data and CRC
+    }
+
+    crc8_ctx_t ctx = stream->ctx; // crc8_final overwrites the running value
+
+    return (crc8_final(&ctx) == stream->residue);
+}
+
+uint32_t crc8_verify_bufs(crc8_param_model_e model,
+                          const uint8_t* const bufs[], const uint32_t lens[],
+                          uint32_t n, uint64_t* ok_bitmap) {
+    crc_batch_model_t batch;
+
+    crc8_batch_model(&batch, model);
+
+    return crc_batch_verify(&batch, bufs, lens, n, ok_bitmap);
+}
+
+void crc8_pack_bufs(crc8_param_model_e model, uint8_t* const bufs[],
+                    const uint32_t lens[], uint32_t n) {
+    crc_batch_model_t batch;
+
+    crc8_batch_model(&batch, model);
+    crc_batch_pack(&batch, bufs, lens, n);
+}
+
+void crc8_batch_model(crc_batch_model_t* batch, crc8_param_model_e model) {
+    crc8_ctx_t ctx;
+
+    crc8_init(&ctx, model);
+    batch->init = ctx.init;
+    batch->xor_out = ctx.xor_out;
+    batch->poly = ctx.poly;
+    batch->width = 8;
+    batch->ref_in = ctx.ref_in;
+    batch->ref_out = ctx.ref_out;
+}
+
 /* ----------------------------- end of file -------------------------------- */
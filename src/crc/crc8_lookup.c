@@ -33,8 +33,18 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <stddef.h>
 #include "crc/crc8_lookup.h"
 #include "crc/bit_utils.h"
+#if CRC8_LOOKUP_SLICE_MAX
+#include "crc_once.h"
+#endif
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of polynomials with built-in tables.
+ */
+#define CRC8_LOOKUP_POLYS 2
 
 /* Private variables -------------------------------------------------------- */
 /**
@@ -57,6 +67,52 @@ static const uint8_t crc8_poly_0x31_table[16] = {
     0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
 };
 
+/**
+ * \brief           Polynomials with built-in tables.
+ */
+static const uint8_t crc8_lookup_poly[CRC8_LOOKUP_POLYS] = {
+    0x07,
+    0x31,
+};
+
+/**
+ * \brief           Nibble tables of `crc8_lookup_poly`.
+ */
+static const uint8_t* const crc8_nibble_table[CRC8_LOOKUP_POLYS] = {
+    crc8_poly_0x07_table,
+    crc8_poly_0x31_table,
+};
+
+#if CRC8_LOOKUP_SLICE_MAX
+/**
+ * \brief           Slicing tables by polynomial, then MSB-first or reflected.
+ *
+ * Table `k` holds the register after a byte followed by `k` zero bytes; a tier
+ * of `n` tables uses the first `n`.
+ */
+static uint8_t crc8_slice_table[CRC8_LOOKUP_POLYS][2][CRC8_LOOKUP_SLICE_MAX]
+                               [256];
+
+/**
+ * \brief           Guard of the slicing tables build.
+ */
+static crc_once_t crc8_slice_once = CRC_ONCE_INIT;
+#endif
+
+#if CRC8_LOOKUP_SLICE > CRC8_LOOKUP_SLICE_MAX
+#error "CRC8_LOOKUP_SLICE exceeds CRC8_LOOKUP_SLICE_MAX"
+#endif
+
+/* Private function prototypes ---------------------------------------------- */
+static uint8_t lookup_slice_update(const crc8_lookup_ctx_t* ctx, uint8_t crc,
+                                   const uint8_t* buf, uint32_t len);
+static inline uint8_t lookup_slice_run(const uint8_t* table, uint32_t n,
+                                       uint8_t crc, const uint8_t* buf,
+                                       uint32_t len);
+#if CRC8_LOOKUP_SLICE_MAX
+static void lookup_slice_build(void);
+#endif
+
 /* Public functions --------------------------------------------------------- */
 void crc8_lookup_init(crc8_lookup_ctx_t* ctx, crc8_lookup_param_model_e model) {
     switch (model) {
@@ -104,6 +160,38 @@ void crc8_lookup_init(crc8_lookup_ctx_t* ctx, crc8_lookup_param_model_e model) {
         ctx->table = NULL;
         break;
     }
+
+#if CRC8_LOOKUP_SLICE
+    // Move from the built-in nibble table to the default tier
+    crc8_lookup_set_tier(ctx, (crc_tier_e)CRC8_LOOKUP_SLICE);
+#endif
+}
+
+bool crc8_lookup_set_tier(crc8_lookup_ctx_t* ctx, crc_tier_e tier) {
+    if (ctx->table == NULL || !crc_tier_is_valid(tier)
+        || (uint32_t)tier > CRC8_LOOKUP_SLICE_MAX) {
+        return false;
+    }
+
+    for (uint32_t p = 0; p < CRC8_LOOKUP_POLYS; p++) {
+        if (crc8_lookup_poly[p] != ctx->poly) {
+            continue;
+        }
+
+        if (tier == CRC_TIER_NIBBLE) {
+            ctx->table = (uint8_t*)crc8_nibble_table[p];
+            ctx->table_len = 16;
+            return true;
+        }
+#if CRC8_LOOKUP_SLICE_MAX
+        crc_once(&crc8_slice_once, lookup_slice_build);
+        ctx->table = &crc8_slice_table[p][ctx->ref_in][0][0];
+        ctx->table_len = (uint16_t)(tier * 256);
+        return true;
+#endif
+    }
+
+    return false;
 }
 
 void crc8_lookup_update(crc8_lookup_ctx_t* ctx, const uint8_t* buf,
@@ -113,6 +201,11 @@ void crc8_lookup_update(crc8_lookup_ctx_t* ctx, const uint8_t* buf,
     }
 
     uint8_t crc = ctx->init;
+    if (ctx->table_len >= 256) {
+        ctx->init = lookup_slice_update(ctx, crc, buf, len);
+        return;
+    }
+
     for (uint32_t i = 0; i < len; i++) {
         uint8_t data = buf[i];
 
@@ -235,4 +328,103 @@ void crc8_generate_table(uint8_t polynomial, uint8_t table[],
     }
 }
 
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Run the register over a buffer with the slicing tables.
+ *
+ * The context register is MSB-first over bit-reversed bytes when the input is
+ * reflected; the reflected tables run it reflected instead, so that the bytes
+ * are taken as they are. An 8-bit register is all shifted out by one byte, so
+ * both orders share the same steps.
+ *
+ * \param[in]       ctx: Pointer to the CRC8 context
+ * \param[in]       crc: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static uint8_t lookup_slice_update(const crc8_lookup_ctx_t* ctx, uint8_t crc,
+                                   const uint8_t* buf, uint32_t len) {
+    if (ctx->ref_in) {
+        crc = reverse_bits(crc);
+    }
+
+    // Constant step sizes let the compiler unroll the step
+    switch (ctx->table_len / 256) {
+    case 1:
+        crc = lookup_slice_run(ctx->table, 1, crc, buf, len);
+        break;
+    case 4:
+        crc = lookup_slice_run(ctx->table, 4, crc, buf, len);
+        break;
+    case 8:
+        crc = lookup_slice_run(ctx->table, 8, crc, buf, len);
+        break;
+    case 16:
+        crc = lookup_slice_run(ctx->table, 16, crc, buf, len);
+        break;
+    default:
+        crc = lookup_slice_run(ctx->table, ctx->table_len / 256, crc, buf,
+                               len);
+        break;
+    }
+
+    return ctx->ref_in ? reverse_bits(crc) : crc;
+}
+
+/**
+ * \brief           Slicing loop of `lookup_slice_update` for `n` tables.
+ *
+ * \param[in]       table: The slicing tables
+ * \param[in]       n: Number of tables, the bytes taken per step
+ * \param[in]       crc: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static inline uint8_t lookup_slice_run(const uint8_t* table, uint32_t n,
+                                       uint8_t crc, const uint8_t* buf,
+                                       uint32_t len) {
+    const uint8_t(*t)[256] = (const uint8_t(*)[256])table;
+
+    for (; len >= n; len -= n, buf += n) {
+        uint8_t next = t[n - 1][buf[0] ^ crc];
+
+        for (uint32_t k = 1; k < n; k++) {
+            next ^= t[n - 1 - k][buf[k]];
+        }
+        crc = next;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        crc = t[0][crc ^ buf[i]];
+    }
+
+    return crc;
+}
+
+#if CRC8_LOOKUP_SLICE_MAX
+/**
+ * \brief           Build the slicing tables of every polynomial.
+ */
+static void lookup_slice_build(void) {
+    for (uint32_t p = 0; p < CRC8_LOOKUP_POLYS; p++) {
+        uint8_t(*msb)[256] = crc8_slice_table[p][0];
+        uint8_t(*ref)[256] = crc8_slice_table[p][1];
+
+        crc8_generate_table(crc8_lookup_poly[p], msb[0], 256);
+        for (uint32_t b = 0; b < 256; b++) {
+            ref[0][b] = reverse_bits(msb[0][reverse_bits((uint8_t)b)]);
+        }
+
+        // One more zero byte after the byte of the previous table
+        for (uint32_t k = 1; k < CRC8_LOOKUP_SLICE_MAX; k++) {
+            for (uint32_t b = 0; b < 256; b++) {
+                msb[k][b] = msb[0][msb[k - 1][b]];
+                ref[k][b] = ref[0][ref[k - 1][b]];
+            }
+        }
+    }
+}
+#endif
+
 /* ----------------------------- end of file -------------------------------- */
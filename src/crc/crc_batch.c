@@ -0,0 +1,675 @@
+/**
+ * \file            crc_batch.c
+ * \brief           Private batch CRC engine shared by the CRC8/16/32 frame
+ *                  helpers
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
+#include "crc_batch.h"
+#include "crc_cpu.h"
+#include "crc/bit_utils.h"
+#include "crc/crc_clmul.h"
+#include "crc/gf2poly.h"
+#if CRC_HAVE_SSSE3
+#include <immintrin.h>
+#endif
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of frames run together, one per `pshufb` byte lane.
+ */
+#define CRC_BATCH_LANES          16
+
+/**
+ * \brief           Number of frames whose scalar CRC chains are interleaved.
+ */
+#define CRC_BATCH_CHAINS         4
+
+/**
+ * \brief           Length in bytes of the segments a long buffer is cut into
+ *                  to fill the `pshufb` lanes.
+ */
+#define CRC_BATCH_SEGMENT        256
+
+/**
+ * \brief           Number of frames prefetched ahead of the current one.
+ */
+#define CRC_BATCH_PREFETCH_AHEAD 8
+
+/* Private function prototypes ---------------------------------------------- */
+static uint32_t reflect(uint32_t data, uint8_t width);
+static void engine_lanes(const crc_batch_engine_t* eng,
+                         const uint8_t* const p[], const uint32_t len[],
+                         uint32_t lanes, uint32_t reg[]);
+static void engine_chains(const crc_batch_engine_t* eng,
+                          const uint8_t* const p[], const uint32_t len[],
+                          uint32_t reg[], uint32_t done[]);
+#if CRC_HAVE_SSSE3
+static uint32_t engine_segments(const crc_batch_engine_t* eng, uint32_t* reg,
+                                const uint8_t* buf, uint32_t len);
+static void engine_lanes_ssse3(const crc_batch_engine_t* eng,
+                               const uint8_t* const p[], uint32_t len,
+                               uint32_t reg[]);
+static void transpose_16x16(__m128i x[16]);
+#endif
+static void prefetch_frame(const uint8_t* const bufs[], const uint32_t lens[],
+                           uint32_t n, uint32_t i);
+
+/* Public functions --------------------------------------------------------- */
+bool crc_batch_model_get(crc_batch_model_t* batch, uint8_t width,
+                         uint8_t model) {
+    switch (width) {
+    case 8:
+        if (model >= CRC8_NONE_MODEL) {
+            return false;
+        }
+        crc8_batch_model(batch, (crc8_param_model_e)model);
+        return true;
+
+    case 16:
+        if (model >= CRC16_NONE_MODEL) {
+            return false;
+        }
+        crc16_batch_model(batch, (crc16_param_model_e)model);
+        return true;
+
+    case 32:
+        if (model >= CRC32_NONE_MODEL) {
+            return false;
+        }
+        crc32_batch_model(batch, (crc32_param_model_e)model);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void crc_batch_engine_init(crc_batch_engine_t* eng,
+                           const crc_batch_model_t* model) {
+    uint8_t width = model->width;
+    uint32_t mask = width == 32 ? 0xFFFFFFFFu : ((uint32_t)1 << width) - 1;
+    uint32_t top = (uint32_t)1 << (width - 1);
+    uint32_t rpoly = reflect(model->poly, width);
+
+    eng->model = *model;
+    eng->mask = mask;
+    eng->shift = (uint8_t)(width - 8);
+    eng->reflected = model->ref_in;
+    eng->init = model->ref_in ? reflect(model->init, width) : model->init;
+    eng->table[0] = 0;
+
+    // Only the single-bit entries are shifted bit by bit: the table is linear,
+    // so every other entry is the XOR of two entries already computed
+    for (uint32_t k = 0; k < 8; k++) {
+        uint32_t crc;
+
+        if (eng->reflected) {
+            crc = (uint32_t)1 << k;
+            for (int j = 0; j < 8; j++) {
+                crc = (crc & 1) ? (crc >> 1) ^ rpoly : crc >> 1;
+            }
+        } else {
+            crc = (uint32_t)1 << (k + eng->shift);
+            for (int j = 0; j < 8; j++) {
+                crc = (crc & top) ? (crc << 1) ^ model->poly : crc << 1;
+            }
+        }
+        eng->table[1u << k] = crc & mask;
+    }
+
+    for (uint32_t i = 3; i < 256; i++) {
+        uint32_t low = i & (~i + 1);
+
+        if (low != i) {
+            eng->table[i] = eng->table[low] ^ eng->table[i ^ low];
+        }
+    }
+
+    eng->clmul = crc_cpu_has_clmul();
+    if (eng->clmul) {
+        crc_clmul_consts(eng->fold, model->poly, width, eng->reflected);
+    }
+
+    // The first 16 entries of the MSB-first table shift a nibble through the
+    // register; reflected, the nibble enters from the low end of the byte
+    eng->ssse3 = width <= 16 && crc_cpu_has_ssse3();
+    if (eng->ssse3) {
+        for (uint32_t n = 0; n < 16; n++) {
+            uint32_t crc = eng->table[eng->reflected ? n << 4 : n];
+
+            eng->nibble[0][n] = (uint8_t)crc;
+            eng->nibble[1][n] = (uint8_t)(crc >> 8);
+        }
+        eng->seg_shift = (uint32_t)gf2poly_xpow8n(CRC_BATCH_SEGMENT,
+                                                  model->poly, width);
+    }
+}
+
+uint32_t crc_batch_update(const crc_batch_engine_t* eng, uint32_t reg,
+                          const uint8_t* buf, uint32_t len) {
+    const uint32_t* t = eng->table;
+
+    if (eng->clmul && len >= CRC_CLMUL_MIN) {
+        uint8_t rem[16];
+        uint64_t wide = eng->reflected
+                            ? reg
+                            : (uint64_t)reg << (64 - eng->model.width);
+        uint32_t done = crc_clmul_fold(eng->fold, eng->reflected, wide, buf,
+                                       len, rem);
+
+        reg = crc_batch_update(eng, 0, rem, sizeof(rem));
+        buf += done;
+        len -= done;
+    }
+#if CRC_HAVE_SSSE3
+    else if (eng->ssse3 && len >= CRC_BATCH_LANES * CRC_BATCH_SEGMENT) {
+        uint32_t done = engine_segments(eng, &reg, buf, len);
+
+        buf += done;
+        len -= done;
+    }
+#endif
+
+    if (eng->reflected) {
+        for (uint32_t i = 0; i < len; i++) {
+            reg = (reg >> 8) ^ t[(reg ^ buf[i]) & 0xFF];
+        }
+    } else {
+        for (uint32_t i = 0; i < len; i++) {
+            reg = ((reg << 8) & eng->mask) ^ t[((reg >> eng->shift) ^ buf[i])
+                                               & 0xFF];
+        }
+    }
+
+    return reg;
+}
+
+uint32_t crc_batch_final(const crc_batch_engine_t* eng, uint32_t reg) {
+    if (eng->reflected != eng->model.ref_out) {
+        reg = reflect(reg, eng->model.width);
+    }
+
+    return reg ^ eng->model.xor_out;
+}
+
+uint32_t crc_batch_verify(const crc_batch_model_t* model,
+                          const uint8_t* const bufs[], const uint32_t lens[],
+                          uint32_t n, uint64_t* ok_bitmap) {
+    crc_batch_engine_t eng;
+    uint32_t bytes = model->width / 8;
+    uint32_t idx[CRC_BATCH_LANES];
+    const uint8_t* p[CRC_BATCH_LANES];
+    uint32_t len[CRC_BATCH_LANES];
+    uint32_t reg[CRC_BATCH_LANES];
+    uint32_t lanes = 0;
+    uint32_t ok = 0;
+
+    memset(ok_bitmap, 0, ((n + 63) / 64) * sizeof(ok_bitmap[0]));
+    crc_batch_engine_init(&eng, model);
+
+    for (uint32_t i = 0; i <= n; i++) {
+        if (i < n) {
+            prefetch_frame(bufs, lens, n, i + CRC_BATCH_PREFETCH_AHEAD);
+            if (bufs[i] == NULL || lens[i] <= bytes) {
+                continue; // Not enough space for CRC
+            }
+            idx[lanes] = i;
+            p[lanes] = bufs[i];
+            len[lanes] = lens[i] - bytes;
+            lanes++;
+            if (lanes < CRC_BATCH_LANES) {
+                continue;
+            }
+        }
+        if (lanes == 0) {
+            continue;
+        }
+
+        engine_lanes(&eng, p, len, lanes, reg);
+
+        for (uint32_t k = 0; k < lanes; k++) {
+            uint32_t stored_crc = 0;
+
+            for (uint32_t b = 0; b < bytes; b++) {
+                stored_crc |= (uint32_t)p[k][len[k] + b] << (8 * b);
+            }
+            if (stored_crc == crc_batch_final(&eng, reg[k])) {
+                ok_bitmap[idx[k] / 64] |= (uint64_t)1 << (idx[k] % 64);
+                ok++;
+            }
+        }
+        lanes = 0;
+    }
+
+    return ok;
+}
+
+void crc_batch_calculate(const crc_batch_model_t* model,
+                         const uint8_t* const bufs[], const uint32_t lens[],
+                         uint32_t n, uint32_t crcs[]) {
+    crc_batch_engine_t eng;
+    uint32_t reg[CRC_BATCH_LANES];
+
+    crc_batch_engine_init(&eng, model);
+
+    for (uint32_t i = 0; i < n; i += CRC_BATCH_LANES) {
+        uint32_t lanes = n - i < CRC_BATCH_LANES ? n - i : CRC_BATCH_LANES;
+
+        prefetch_frame(bufs, lens, n, i + CRC_BATCH_PREFETCH_AHEAD);
+        engine_lanes(&eng, &bufs[i], &lens[i], lanes, reg);
+        for (uint32_t k = 0; k < lanes; k++) {
+            crcs[i + k] = crc_batch_final(&eng, reg[k]);
+        }
+    }
+}
+
+void crc_batch_pack(const crc_batch_model_t* model, uint8_t* const bufs[],
+                    const uint32_t lens[], uint32_t n) {
+    crc_batch_engine_t eng;
+    uint32_t bytes = model->width / 8;
+    uint8_t* p[CRC_BATCH_LANES];
+    uint32_t len[CRC_BATCH_LANES];
+    uint32_t reg[CRC_BATCH_LANES];
+    uint32_t lanes = 0;
+
+    crc_batch_engine_init(&eng, model);
+
+    for (uint32_t i = 0; i <= n; i++) {
+        if (i < n) {
+            prefetch_frame((const uint8_t* const*)bufs, lens, n,
+                           i + CRC_BATCH_PREFETCH_AHEAD);
+            if (bufs[i] == NULL || lens[i] <= bytes) {
+                continue; // Not enough space for CRC
+            }
+            p[lanes] = bufs[i];
+            len[lanes] = lens[i] - bytes;
+            lanes++;
+            if (lanes < CRC_BATCH_LANES) {
+                continue;
+            }
+        }
+        if (lanes == 0) {
+            continue;
+        }
+
+        engine_lanes(&eng, (const uint8_t* const*)p, len, lanes, reg);
+
+        for (uint32_t k = 0; k < lanes; k++) {
+            uint32_t crc = crc_batch_final(&eng, reg[k]);
+
+            for (uint32_t b = 0; b < bytes; b++) {
+                p[k][len[k] + b] = (uint8_t)(crc >> (8 * b));
+            }
+        }
+        lanes = 0;
+    }
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Reverse the low `width` bits of a value.
+ *
+ * \param[in]       data: Value to be reversed
+ * \param[in]       width: Number of bits to reverse
+ * \return          The reversed value
+ */
+static uint32_t reflect(uint32_t data, uint8_t width) {
+    return reverse_bits_32(data) >> (32 - width);
+}
+
+/**
+ * \brief           Run up to `CRC_BATCH_LANES` independent CRC chains.
+ *
+ * Frames of at least `CRC_CLMUL_MIN` bytes are folded one at a time by
+ * `crc_batch_update` when the engine has carry-less multiplies, which beats
+ * any table chain. The other frames form a group that runs in the byte lanes
+ * of `pshufb` over the length common to its frames when the group is full
+ * and the engine allows it; otherwise its chains are interleaved
+ * `CRC_BATCH_CHAINS` at a time so that their table loads overlap. The
+ * remaining bytes of each frame are finished one chain at a time.
+ *
+ * \param[in]       eng: Pointer to the engine
+ * \param[in]       p: Pointers to the data of the frames
+ * \param[in]       len: Lengths of the data in bytes
+ * \param[in]       lanes: Number of frames, at most `CRC_BATCH_LANES`
+ * \param[out]      reg: Register values after each frame
+ */
+static void engine_lanes(const crc_batch_engine_t* eng,
+                         const uint8_t* const p[], const uint32_t len[],
+                         uint32_t lanes, uint32_t reg[]) {
+    const uint8_t* q[CRC_BATCH_LANES];
+    uint32_t rest[CRC_BATCH_LANES];
+    uint32_t done[CRC_BATCH_LANES];
+    uint32_t idx[CRC_BATCH_LANES];
+    uint32_t r[CRC_BATCH_LANES];
+    uint32_t n = 0;
+    uint32_t k;
+
+    for (uint32_t i = 0; i < lanes; i++) {
+        if (eng->clmul && len[i] >= CRC_CLMUL_MIN) {
+            reg[i] = crc_batch_update(eng, eng->init, p[i], len[i]);
+            continue;
+        }
+        idx[n] = i;
+        q[n] = p[i];
+        rest[n] = len[i];
+        r[n] = eng->init;
+        done[n] = 0;
+        n++;
+    }
+
+#if CRC_HAVE_SSSE3
+    if (eng->ssse3 && n == CRC_BATCH_LANES) {
+        uint32_t common = rest[0];
+
+        for (uint32_t i = 1; i < n; i++) {
+            common = rest[i] < common ? rest[i] : common;
+        }
+        engine_lanes_ssse3(eng, q, common, r);
+        for (uint32_t i = 0; i < n; i++) {
+            done[i] = common;
+        }
+    }
+#endif
+
+    for (uint32_t i = 0; i < n; i++) {
+        q[i] += done[i];
+        rest[i] -= done[i];
+        done[i] = 0;
+    }
+    for (k = 0; k + CRC_BATCH_CHAINS <= n; k += CRC_BATCH_CHAINS) {
+        engine_chains(eng, q + k, rest + k, r + k, done + k);
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        reg[idx[i]] = crc_batch_update(eng, r[i], q[i] + done[i],
+                                       rest[i] - done[i]);
+    }
+}
+
+/**
+ * \brief           Interleave `CRC_BATCH_CHAINS` CRC chains over the length
+ *                  common to their frames.
+ *
+ * \param[in]       eng: Pointer to the engine
+ * \param[in]       p: Pointers to the data of the frames
+ * \param[in]       len: Lengths of the data in bytes
+ * \param[in,out]   reg: Register values of the chains
+ * \param[out]      done: Number of bytes run of each frame
+ */
+static void engine_chains(const crc_batch_engine_t* eng,
+                          const uint8_t* const p[], const uint32_t len[],
+                          uint32_t reg[], uint32_t done[]) {
+    const uint32_t* t = eng->table;
+    uint32_t r0 = reg[0], r1 = reg[1], r2 = reg[2], r3 = reg[3];
+    const uint8_t *p0 = p[0], *p1 = p[1], *p2 = p[2], *p3 = p[3];
+    uint32_t common = len[0];
+
+    for (uint32_t k = 1; k < CRC_BATCH_CHAINS; k++) {
+        common = len[k] < common ? len[k] : common;
+    }
+
+    if (eng->reflected) {
+        for (uint32_t i = 0; i < common; i++) {
+            r0 = (r0 >> 8) ^ t[(r0 ^ p0[i]) & 0xFF];
+            r1 = (r1 >> 8) ^ t[(r1 ^ p1[i]) & 0xFF];
+            r2 = (r2 >> 8) ^ t[(r2 ^ p2[i]) & 0xFF];
+            r3 = (r3 >> 8) ^ t[(r3 ^ p3[i]) & 0xFF];
+        }
+    } else {
+        uint32_t m = eng->mask;
+        uint8_t s = eng->shift;
+
+        for (uint32_t i = 0; i < common; i++) {
+            r0 = ((r0 << 8) & m) ^ t[((r0 >> s) ^ p0[i]) & 0xFF];
+            r1 = ((r1 << 8) & m) ^ t[((r1 >> s) ^ p1[i]) & 0xFF];
+            r2 = ((r2 << 8) & m) ^ t[((r2 >> s) ^ p2[i]) & 0xFF];
+            r3 = ((r3 << 8) & m) ^ t[((r3 >> s) ^ p3[i]) & 0xFF];
+        }
+    }
+
+    reg[0] = r0;
+    reg[1] = r1;
+    reg[2] = r2;
+    reg[3] = r3;
+    for (uint32_t k = 0; k < CRC_BATCH_CHAINS; k++) {
+        done[k] = common;
+    }
+}
+
+#if CRC_HAVE_SSSE3
+/**
+ * \brief           Run the whole blocks of a long buffer as parallel segments.
+ *
+ * Each block of `CRC_BATCH_LANES` segments runs in the `pshufb` lanes, the
+ * first segment from the register and the others from 0; the segment
+ * registers are then joined by CRC linearity, each shifted over the
+ * following segment with `seg_shift`.
+ *
+ * \param[in]       eng: Pointer to the engine
+ * \param[in,out]   reg: The register
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Number of bytes run
+ */
+static uint32_t engine_segments(const crc_batch_engine_t* eng, uint32_t* reg,
+                                const uint8_t* buf, uint32_t len) {
+    const uint32_t block = CRC_BATCH_LANES * CRC_BATCH_SEGMENT;
+    uint8_t width = eng->model.width;
+    const uint8_t* p[CRC_BATCH_LANES];
+    uint32_t lane[CRC_BATCH_LANES];
+    uint32_t done = 0;
+
+    for (; len - done >= block; done += block) {
+        for (uint32_t k = 0; k < CRC_BATCH_LANES; k++) {
+            p[k] = buf + done + k * CRC_BATCH_SEGMENT;
+            lane[k] = 0;
+        }
+        lane[0] = *reg;
+        engine_lanes_ssse3(eng, p, CRC_BATCH_SEGMENT, lane);
+
+        // The shift is a product of MSB-first polynomials
+        uint32_t acc = 0;
+        for (uint32_t k = 0; k < CRC_BATCH_LANES; k++) {
+            uint32_t r = eng->reflected ? reflect(lane[k], width) : lane[k];
+
+            acc = (uint32_t)gf2poly_mulmod(acc, eng->seg_shift,
+                                           eng->model.poly, width)
+                  ^ r;
+        }
+        *reg = eng->reflected ? reflect(acc, width) : acc;
+    }
+
+    return done;
+}
+
+/**
+ * \brief           Run `CRC_BATCH_LANES` 8- or 16-bit CRC chains in the byte
+ *                  lanes of `pshufb`.
+ *
+ * The registers are split into a vector of low bytes and one of high bytes;
+ * every nibble of input is a 16-entry table lookup per vector, which is a
+ * single `pshufb`. Whole blocks of 16 bytes are transposed so that vector
+ * `j` holds byte `j` of every frame.
+ *
+ * \param[in]       eng: Pointer to the engine, `eng->ssse3` set
+ * \param[in]       p: Pointers to the data of the frames
+ * \param[in]       len: Number of bytes to run of every frame
+ * \param[in,out]   reg: Register values of the chains
+ */
+CRC_TARGET_SSSE3
+static void engine_lanes_ssse3(const crc_batch_engine_t* eng,
+                               const uint8_t* const p[], uint32_t len,
+                               uint32_t reg[]) {
+    const __m128i tl = _mm_loadu_si128((const __m128i*)(const void*)
+                                           eng->nibble[0]);
+    const __m128i th = _mm_loadu_si128((const __m128i*)(const void*)
+                                           eng->nibble[1]);
+    const __m128i lo4 = _mm_set1_epi8(0x0F);
+    const __m128i hi4 = _mm_set1_epi8((char)0xF0);
+    bool wide = eng->model.width > 8;
+    uint8_t lo[CRC_BATCH_LANES], hi[CRC_BATCH_LANES];
+    uint8_t tail[16][CRC_BATCH_LANES];
+    __m128i col[16];
+
+    for (uint32_t k = 0; k < CRC_BATCH_LANES; k++) {
+        lo[k] = (uint8_t)reg[k];
+        hi[k] = (uint8_t)(reg[k] >> 8);
+    }
+    __m128i rl = _mm_loadu_si128((const __m128i*)(const void*)lo);
+    __m128i rh = _mm_loadu_si128((const __m128i*)(const void*)hi);
+
+#define LANES_SHR4(v) _mm_and_si128(_mm_srli_epi16((v), 4), lo4)
+#define LANES_SHL4(v) _mm_and_si128(_mm_slli_epi16((v), 4), hi4)
+
+    for (uint32_t i = 0; i < len; i += 16) {
+        uint32_t n = len - i < 16 ? len - i : 16;
+
+        if (i + n >= 16) {
+            // A short last block is loaded ending at `len`, overlapping the
+            // block before it
+            for (uint32_t k = 0; k < CRC_BATCH_LANES; k++) {
+                col[k] = _mm_loadu_si128((const __m128i*)(const void*)(p[k]
+                                                                       + i + n
+                                                                       - 16));
+            }
+            transpose_16x16(col);
+            for (uint32_t j = 0; j < n; j++) {
+                col[j] = col[16 - n + j];
+            }
+        } else {
+            for (uint32_t j = 0; j < n; j++) {
+                for (uint32_t k = 0; k < CRC_BATCH_LANES; k++) {
+                    tail[j][k] = p[k][i + j];
+                }
+                col[j] = _mm_loadu_si128((const __m128i*)(const void*)tail[j]);
+            }
+        }
+
+        // Reflected registers shift out at the low end of `rl`, MSB-first
+        // ones at the high end of `rh`, or of `rl` when the CRC is 8 bits
+        for (uint32_t j = 0; j < n; j++) {
+            if (!wide) {
+                rl = _mm_xor_si128(rl, col[j]);
+                for (int nib = 0; nib < 2; nib++) {
+                    rl = eng->reflected
+                             ? _mm_xor_si128(
+                                   LANES_SHR4(rl),
+                                   _mm_shuffle_epi8(tl,
+                                                    _mm_and_si128(rl, lo4)))
+                             : _mm_xor_si128(
+                                   LANES_SHL4(rl),
+                                   _mm_shuffle_epi8(tl, LANES_SHR4(rl)));
+                }
+            } else if (eng->reflected) {
+                rl = _mm_xor_si128(rl, col[j]);
+                for (int nib = 0; nib < 2; nib++) {
+                    __m128i idx = _mm_and_si128(rl, lo4);
+
+                    rl = _mm_xor_si128(
+                        _mm_or_si128(LANES_SHR4(rl), LANES_SHL4(rh)),
+                        _mm_shuffle_epi8(tl, idx));
+                    rh = _mm_xor_si128(LANES_SHR4(rh),
+                                       _mm_shuffle_epi8(th, idx));
+                }
+            } else {
+                rh = _mm_xor_si128(rh, col[j]);
+                for (int nib = 0; nib < 2; nib++) {
+                    __m128i idx = LANES_SHR4(rh);
+
+                    rh = _mm_xor_si128(
+                        _mm_or_si128(LANES_SHL4(rh), LANES_SHR4(rl)),
+                        _mm_shuffle_epi8(th, idx));
+                    rl = _mm_xor_si128(LANES_SHL4(rl),
+                                       _mm_shuffle_epi8(tl, idx));
+                }
+            }
+        }
+    }
+
+#undef LANES_SHR4
+#undef LANES_SHL4
+
+    _mm_storeu_si128((__m128i*)(void*)lo, rl);
+    _mm_storeu_si128((__m128i*)(void*)hi, rh);
+    for (uint32_t k = 0; k < CRC_BATCH_LANES; k++) {
+        reg[k] = wide ? (uint32_t)hi[k] << 8 | lo[k] : lo[k];
+    }
+}
+
+/**
+ * \brief           Transpose a 16x16 byte matrix held in 16 vectors.
+ *
+ * Each round interleaves vectors `k` and `k + 8`, which rotates the 8-bit
+ * index (vector, byte) of every element left by one; four rounds swap the
+ * two halves of the index.
+ *
+ * \param[in,out]   x: The matrix, one row per vector
+ */
+CRC_TARGET_SSSE3
+static void transpose_16x16(__m128i x[16]) {
+    __m128i y[16];
+
+    for (int round = 0; round < 4; round++) {
+        for (uint32_t k = 0; k < 8; k++) {
+            y[2 * k] = _mm_unpacklo_epi8(x[k], x[k + 8]);
+            y[2 * k + 1] = _mm_unpackhi_epi8(x[k], x[k + 8]);
+        }
+        for (uint32_t k = 0; k < 16; k++) {
+            x[k] = y[k];
+        }
+    }
+}
+#endif
+
+/**
+ * \brief           Prefetch the start and the trailer of an upcoming frame.
+ *
+ * \param[in]       bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ * \param[in]       i: Index of the frame to prefetch, ignored if out of range
+ */
+static void prefetch_frame(const uint8_t* const bufs[], const uint32_t lens[],
+                           uint32_t n, uint32_t i) {
+    if (i >= n || bufs[i] == NULL || lens[i] == 0) {
+        return;
+    }
+
+    CRC_PREFETCH(bufs[i]);
+    CRC_PREFETCH(bufs[i] + lens[i] - 1);
+}
+
+/* ----------------------------- end of file -------------------------------- */
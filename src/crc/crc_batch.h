@@ -0,0 +1,253 @@
+/**
+ * \file            crc_batch.h
+ * \brief           Private batch CRC engine shared by the CRC8/16/32 frame
+ *                  helpers
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_BATCH_H__
+#define __CRC_BATCH_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc32.h"
+#include "crc/crc8.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Width-independent description of a CRC model.
+ */
+typedef struct {
+    uint32_t init;    /*!< Initial value */
+    uint32_t xor_out; /*!< Final XOR value */
+    uint32_t poly;    /*!< Polynomial, MSB-first without the top bit */
+    uint8_t width;    /*!< Width of the CRC in bits: 8, 16 or 32 */
+    bool ref_in;      /*!< Whether to reverse the input data bits */
+    bool ref_out;     /*!< Whether to reverse the output data bits */
+} crc_batch_model_t;
+
+/**
+ * \brief           Byte-wise table engine resolved from a model.
+ *
+ * Reflected models run a reflected register so that no input byte has to be
+ * bit-reversed; other models run an MSB-first register.
+ */
+typedef struct {
+    crc_batch_model_t model; /*!< The CRC model */
+    uint32_t table[256];     /*!< Byte-wise CRC table */
+    uint32_t init;           /*!< Initial register value */
+    uint32_t mask;           /*!< Mask of the register width */
+    uint8_t shift;           /*!< Width minus 8, MSB-first table index shift */
+    bool reflected;          /*!< Whether the register is reflected */
+    bool clmul;              /*!< Whether long updates are folded */
+    uint64_t fold[4];        /*!< Folding constants, see `crc_clmul_fold` */
+    bool ssse3;              /*!< Whether 8- and 16-bit chains run in the
+                                  byte lanes of `pshufb` */
+    uint8_t nibble[2][16];   /*!< Nibble table, low and high bytes */
+    uint32_t seg_shift;      /*!< x^(8 * segment) mod P, see `ssse3` */
+} crc_batch_engine_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Describe a CRC8 model for the batch engine.
+ *
+ * \param[out]      batch: Pointer to the model description
+ * \param[in]       model: The CRC8 model
+ */
+void crc8_batch_model(crc_batch_model_t* batch, crc8_param_model_e model);
+
+/**
+ * \brief           Describe a CRC16 model for the batch engine.
+ *
+ * \param[out]      batch: Pointer to the model description
+ * \param[in]       model: The CRC16 model
+ */
+void crc16_batch_model(crc_batch_model_t* batch, crc16_param_model_e model);
+
+/**
+ * \brief           Describe a CRC32 model for the batch engine.
+ *
+ * \param[out]      batch: Pointer to the model description
+ * \param[in]       model: The CRC32 model
+ */
+void crc32_batch_model(crc_batch_model_t* batch, crc32_param_model_e model);
+
+/**
+ * \brief           Describe a CRC model given by its width and number.
+ *
+ * \param[out]      batch: Pointer to the model description
+ * \param[in]       width: CRC width in bits: 8, 16 or 32
+ * \param[in]       model: `crc8_param_model_e`, `crc16_param_model_e` or
+ *                  `crc32_param_model_e`, as per `width`
+ * \return          `true` on success, `false` if the model is invalid
+ */
+bool crc_batch_model_get(crc_batch_model_t* batch, uint8_t width,
+                         uint8_t model);
+
+/**
+ * \brief           Compute the carry-less multiply folding constants of a
+ *                  polynomial.
+ *
+ * \param[out]      fold: The constants for `crc_clmul_fold`
+ * \param[in]       poly: The polynomial, MSB-first without the top bit
+ * \param[in]       width: Degree of the polynomial, 1 to 64
+ * \param[in]       reflected: Whether the register is reflected
+ */
+void crc_clmul_consts(uint64_t fold[4], uint64_t poly, uint8_t width,
+                      bool reflected);
+
+/**
+ * \brief           Fold 16-byte blocks of data with carry-less multiplies.
+ *
+ * The register is XORed into the first block: an MSB-first register in the
+ * high bits, a reflected one in the low bits. The 16 bytes left in `rem`
+ * have the same CRC, from a register of 0, as the register followed by the
+ * bytes folded. Only to be called when `crc_cpu_has_clmul` holds.
+ *
+ * \param[in]       fold: Constants from `crc_clmul_consts`
+ * \param[in]       reflected: Whether the register is reflected
+ * \param[in]       reg: The register
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \param[out]      rem: The remainder block
+ * \return          Number of bytes folded, a multiple of 16, or 0 if `len`
+ *                  is below 64
+ */
+uint32_t crc_clmul_fold(const uint64_t fold[4], bool reflected, uint64_t reg,
+                        const uint8_t* buf, uint32_t len, uint8_t rem[16]);
+
+/**
+ * \brief           Fold the head of a CRC16 update with carry-less multiplies.
+ *
+ * Covers the 0x8005, 0x1021 and 0x3D65 polynomials, reflected or not, above
+ * `CRC_CLMUL_MIN` bytes; other cases consume nothing. The register is the
+ * MSB-first one of `crc16_update` and `crc16_lookup_update`.
+ *
+ * \param[in]       poly: The polynomial
+ * \param[in]       ref_in: Whether the input bits are reversed
+ * \param[in,out]   crc: The register
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Number of bytes consumed
+ */
+uint32_t crc16_fold(uint16_t poly, bool ref_in, uint16_t* crc,
+                    const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Resolve a model into a byte-wise table engine.
+ *
+ * \param[out]      eng: Pointer to the engine to be initialized
+ * \param[in]       model: The CRC model
+ */
+void crc_batch_engine_init(crc_batch_engine_t* eng,
+                           const crc_batch_model_t* model);
+
+/**
+ * \brief           Run the engine register over a buffer.
+ *
+ * Start from `eng->init`; the register can be carried across calls to
+ * process a stream.
+ *
+ * \param[in]       eng: Pointer to the engine
+ * \param[in]       reg: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+uint32_t crc_batch_update(const crc_batch_engine_t* eng, uint32_t reg,
+                          const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Convert an engine register into the model's checksum.
+ *
+ * \param[in]       eng: Pointer to the engine
+ * \param[in]       reg: Register value after the data
+ * \return          The final checksum
+ */
+uint32_t crc_batch_final(const crc_batch_engine_t* eng, uint32_t reg);
+
+/**
+ * \brief           Verify an array of frames followed by their CRC trailer.
+ *
+ * The trailer is `width / 8` bytes, little-endian, as written by
+ * `crc*_pack_buf`. Bit `i % 64` of `ok_bitmap[i / 64]` is set when frame `i`
+ * is valid; all `(n + 63) / 64` words are written.
+ *
+ * \param[in]       model: The CRC model
+ * \param[in]       bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes, trailer included
+ * \param[in]       n: Number of frames
+ * \param[out]      ok_bitmap: Result bitmap
+ * \return          Number of valid frames
+ */
+uint32_t crc_batch_verify(const crc_batch_model_t* model,
+                          const uint8_t* const bufs[], const uint32_t lens[],
+                          uint32_t n, uint64_t* ok_bitmap);
+
+/**
+ * \brief           Calculate the CRC of an array of buffers.
+ *
+ * \param[in]       model: The CRC model
+ * \param[in]       bufs: Pointers to the buffers
+ * \param[in]       lens: Lengths of the buffers in bytes
+ * \param[in]       n: Number of buffers
+ * \param[out]      crcs: Checksum of each buffer
+ */
+void crc_batch_calculate(const crc_batch_model_t* model,
+                         const uint8_t* const bufs[], const uint32_t lens[],
+                         uint32_t n, uint32_t crcs[]);
+
+/**
+ * \brief           Append the CRC trailer to an array of frames.
+ *
+ * Frames too short to hold a trailer are left unchanged.
+ *
+ * \param[in]       model: The CRC model
+ * \param[in,out]   bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes, trailer included
+ * \param[in]       n: Number of frames
+ */
+void crc_batch_pack(const crc_batch_model_t* model, uint8_t* const bufs[],
+                    const uint32_t lens[], uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_BATCH_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
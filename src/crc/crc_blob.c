@@ -0,0 +1,140 @@
+/**
+ * \file            crc_blob.c
+ * \brief           Private CRC-trailed index files shared by the sidecar,
+ *                  Merkle and range indexes
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <string.h>
+#include "crc_blob.h"
+
+/* Public functions --------------------------------------------------------- */
+bool crc_blob_save(const char* path, const uint8_t* head, size_t head_size,
+                   const void* base, size_t stride, uint64_t count) {
+    const uint8_t* word = base;
+    uint8_t buf[32];
+    crc32_ctx_t ctx;
+    size_t len = strlen(path);
+    char* tmp = malloc(len + 5);
+
+    if (tmp == NULL) {
+        return false;
+    }
+    memcpy(tmp, path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE* fp = fopen(tmp, "wb");
+    if (fp == NULL) {
+        free(tmp);
+        return false;
+    }
+
+    crc32_init(&ctx, CRC32_MODEL);
+    crc32_update(&ctx, head, head_size);
+    bool ok = fwrite(head, 1, head_size, fp) == head_size;
+
+    for (uint64_t i = 0; ok && i < count; i += 8) {
+        uint32_t n = count - i < 8 ? (uint32_t)(count - i) : 8;
+
+        for (uint32_t k = 0; k < n; k++, word += stride) {
+            uint32_t value;
+
+            memcpy(&value, word, sizeof(value));
+            crc_put_le(buf + 4 * k, value, 4);
+        }
+        crc32_update(&ctx, buf, 4 * n);
+        ok = fwrite(buf, 1, 4 * n, fp) == 4 * n;
+    }
+
+    crc_put_le(buf, crc32_final(&ctx), 4);
+    ok = ok && fwrite(buf, 1, 4, fp) == 4 && crc_file_sync(fp);
+    ok = (fclose(fp) == 0) && ok && crc_file_replace(tmp, path);
+    if (!ok) {
+        remove(tmp);
+    }
+    free(tmp);
+
+    return ok;
+}
+
+bool crc_blob_open(crc_blob_reader_t* rd, const char* path, uint8_t* head,
+                   size_t head_size) {
+    crc32_init(&rd->ctx, CRC32_MODEL);
+    rd->fp = fopen(path, "rb");
+    if (rd->fp == NULL || fread(head, 1, head_size, rd->fp) != head_size) {
+        return false;
+    }
+    crc32_update(&rd->ctx, head, head_size);
+
+    return true;
+}
+
+bool crc_blob_read(crc_blob_reader_t* rd, void* base, size_t stride,
+                   uint64_t count) {
+    uint8_t* word = base;
+    uint8_t buf[32];
+
+    for (uint64_t i = 0; i < count; i += 8) {
+        uint32_t n = count - i < 8 ? (uint32_t)(count - i) : 8;
+
+        if (fread(buf, 1, 4 * n, rd->fp) != 4 * n) {
+            return false;
+        }
+        crc32_update(&rd->ctx, buf, 4 * n);
+        for (uint32_t k = 0; k < n; k++, word += stride) {
+            uint32_t value = (uint32_t)crc_get_le(buf + 4 * k, 4);
+
+            memcpy(word, &value, sizeof(value));
+        }
+    }
+
+    return true;
+}
+
+bool crc_blob_close(crc_blob_reader_t* rd, bool ok) {
+    uint8_t buf[5];
+
+    if (rd->fp == NULL) {
+        return false;
+    }
+
+    // Trailer, then nothing else
+    ok = ok && fread(buf, 1, 5, rd->fp) == 4
+         && (uint32_t)crc_get_le(buf, 4) == crc32_final(&rd->ctx);
+    fclose(rd->fp);
+    rd->fp = NULL;
+
+    return ok;
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,120 @@
+/**
+ * \file            crc_blob.h
+ * \brief           Private CRC-trailed index files shared by the sidecar,
+ *                  Merkle and range indexes
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_BLOB_H__
+#define __CRC_BLOB_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Reader of a CRC-trailed index file, see `crc_blob_open`.
+ */
+typedef struct {
+    FILE* fp;        /*!< Open file, NULL if it could not be opened */
+    crc32_ctx_t ctx; /*!< CRC32 of the bytes read so far */
+} crc_blob_reader_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Write a CRC-trailed index file.
+ *
+ * The layout shared by the sidecar, Merkle and range indexes: a fixed head,
+ * `count` little-endian 32-bit words and the CRC32 of everything before it.
+ * The file is written next to `path`, flushed to disk and moved over it, so
+ * an interrupted save leaves the previous file intact.
+ *
+ * \param[in]       path: Path of the file
+ * \param[in]       head: Encoded head
+ * \param[in]       head_size: Size of the head in bytes
+ * \param[in]       base: Pointer to the first word
+ * \param[in]       stride: Distance in bytes between consecutive words
+ * \param[in]       count: Number of words
+ * \return          `true` on success, `false` on I/O error
+ */
+bool crc_blob_save(const char* path, const uint8_t* head, size_t head_size,
+                   const void* base, size_t stride, uint64_t count);
+
+/**
+ * \brief           Open a CRC-trailed index file and read its head.
+ *
+ * The reader must be closed with `crc_blob_close`, even on failure.
+ *
+ * \param[out]      rd: Pointer to the reader
+ * \param[in]       path: Path of the file
+ * \param[out]      head: Buffer receiving the head
+ * \param[in]       head_size: Size of the head in bytes
+ * \return          `true` on success, `false` if the head cannot be read
+ */
+bool crc_blob_open(crc_blob_reader_t* rd, const char* path, uint8_t* head,
+                   size_t head_size);
+
+/**
+ * \brief           Read the words of a CRC-trailed index file.
+ *
+ * \param[in,out]   rd: Pointer to the reader
+ * \param[out]      base: Pointer to the first word
+ * \param[in]       stride: Distance in bytes between consecutive words
+ * \param[in]       count: Number of words
+ * \return          `true` on success, `false` if the file is too short
+ */
+bool crc_blob_read(crc_blob_reader_t* rd, void* base, size_t stride,
+                   uint64_t count);
+
+/**
+ * \brief           Check the trailer of a CRC-trailed index file and close it.
+ *
+ * \param[in,out]   rd: Pointer to the reader
+ * \param[in]       ok: Whether the head and the words were accepted
+ * \return          `true` if `ok` and the trailer matches and ends the file
+ */
+bool crc_blob_close(crc_blob_reader_t* rd, bool ok);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_BLOB_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,598 @@
+/**
+ * \file            crc_checkpoint.c
+ * \brief           Checkpoint and resume of streaming CRC state
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc_checkpoint.h"
+#include "crc/bit_utils.h"
+#include "crc_batch.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Magic number of the serialised state, "CRCX".
+ */
+#define STATE_MAGIC      0x58435243u
+
+/**
+ * \brief           Number of bytes read from the file at a time.
+ */
+#define CHECKPOINT_CHUNK (1024 * 1024)
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Context type of a serialised state.
+ */
+typedef enum {
+    STATE_KIND_CRC8 = 1,     /*!< `crc8_ctx_t` */
+    STATE_KIND_CRC16,        /*!< `crc16_ctx_t` */
+    STATE_KIND_CRC32,        /*!< `crc32_ctx_t` */
+    STATE_KIND_CRC8_LOOKUP,  /*!< `crc8_lookup_ctx_t` */
+    STATE_KIND_CRC16_LOOKUP, /*!< `crc16_lookup_ctx_t` */
+    STATE_KIND_CRC32_LOOKUP, /*!< `crc32_lookup_ctx_t` */
+} state_kind_e;
+
+/**
+ * \brief           Streaming CRC state, independent of the context type.
+ */
+typedef struct {
+    state_kind_e kind;  /*!< Context type */
+    uint32_t reg;       /*!< Running register, MSB-first */
+    uint32_t poly;      /*!< Polynomial */
+    uint32_t xor_out;   /*!< Final XOR value */
+    bool ref_in;        /*!< Whether the input bits are reversed */
+    bool ref_out;       /*!< Whether the output bits are reversed */
+    uint16_t table_len; /*!< Length of the lookup table, 0 if none */
+    uint64_t offset;    /*!< Number of bytes consumed */
+} state_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static void state_pack(const state_t* st, uint8_t* buf);
+static bool state_unpack(state_t* st, state_kind_e kind, const uint8_t* buf);
+static state_kind_e driver_kind(uint8_t width);
+static uint32_t reflect_reg(uint32_t reg, uint8_t width);
+static bool table_tier(uint16_t table_len, crc_tier_e* tier);
+static bool checkpoint_load(const crc_checkpoint_cfg_t* cfg,
+                            const crc_batch_engine_t* eng,
+                            const crc_file_info_t* info, uint32_t* reg,
+                            uint64_t* offset);
+static bool checkpoint_save(const crc_checkpoint_cfg_t* cfg,
+                            const crc_batch_engine_t* eng,
+                            const crc_file_info_t* info, uint32_t reg,
+                            uint64_t offset);
+
+/* Public functions --------------------------------------------------------- */
+void crc8_state_export(const crc8_ctx_t* ctx, uint64_t offset, uint8_t* buf) {
+    state_t st = {STATE_KIND_CRC8, ctx->init, ctx->poly, ctx->xor_out,
+                  ctx->ref_in, ctx->ref_out, 0, offset};
+
+    state_pack(&st, buf);
+}
+
+bool crc8_state_import(crc8_ctx_t* ctx, uint64_t* offset, const uint8_t* buf) {
+    state_t st;
+
+    if (!state_unpack(&st, STATE_KIND_CRC8, buf)) {
+        return false;
+    }
+
+    ctx->init = (uint8_t)st.reg;
+    ctx->poly = (uint8_t)st.poly;
+    ctx->xor_out = (uint8_t)st.xor_out;
+    ctx->ref_in = st.ref_in;
+    ctx->ref_out = st.ref_out;
+    *offset = st.offset;
+
+    return true;
+}
+
+void crc16_state_export(const crc16_ctx_t* ctx, uint64_t offset,
+                        uint8_t* buf) {
+    state_t st = {STATE_KIND_CRC16, ctx->init, ctx->poly, ctx->xor_out,
+                  ctx->ref_in, ctx->ref_out, 0, offset};
+
+    state_pack(&st, buf);
+}
+
+bool crc16_state_import(crc16_ctx_t* ctx, uint64_t* offset,
+                        const uint8_t* buf) {
+    state_t st;
+
+    if (!state_unpack(&st, STATE_KIND_CRC16, buf)) {
+        return false;
+    }
+
+    ctx->init = (uint16_t)st.reg;
+    ctx->poly = (uint16_t)st.poly;
+    ctx->xor_out = (uint16_t)st.xor_out;
+    ctx->ref_in = st.ref_in;
+    ctx->ref_out = st.ref_out;
+    *offset = st.offset;
+
+    return true;
+}
+
+void crc32_state_export(const crc32_ctx_t* ctx, uint64_t offset,
+                        uint8_t* buf) {
+    state_t st = {STATE_KIND_CRC32, ctx->init, ctx->poly, ctx->xor_out,
+                  ctx->ref_in, ctx->ref_out, 0, offset};
+
+    state_pack(&st, buf);
+}
+
+bool crc32_state_import(crc32_ctx_t* ctx, uint64_t* offset,
+                        const uint8_t* buf) {
+    state_t st;
+
+    if (!state_unpack(&st, STATE_KIND_CRC32, buf)) {
+        return false;
+    }
+
+    ctx->init = st.reg;
+    ctx->poly = st.poly;
+    ctx->xor_out = st.xor_out;
+    ctx->ref_in = st.ref_in;
+    ctx->ref_out = st.ref_out;
+    *offset = st.offset;
+
+    return true;
+}
+
+void crc8_lookup_state_export(const crc8_lookup_ctx_t* ctx, uint64_t offset,
+                              uint8_t* buf) {
+    state_t st = {STATE_KIND_CRC8_LOOKUP, ctx->init, ctx->poly, ctx->xor_out,
+                  ctx->ref_in, ctx->ref_out, ctx->table_len, offset};
+
+    state_pack(&st, buf);
+}
+
+bool crc8_lookup_state_import(crc8_lookup_ctx_t* ctx, uint64_t* offset,
+                              const uint8_t* buf) {
+    crc8_lookup_ctx_t found;
+    crc_tier_e tier;
+    state_t st;
+
+    if (!state_unpack(&st, STATE_KIND_CRC8_LOOKUP, buf)
+        || (st.table_len != 0 && !table_tier(st.table_len, &tier))) {
+        return false;
+    }
+
+    // Re-attach the built-in table of the polynomial and bit order
+    found.table = NULL;
+    for (int m = 0; st.table_len != 0 && m < CRC8_NONE_LOOKUP_MODEL; m++) {
+        crc8_lookup_init(&found, (crc8_lookup_param_model_e)m);
+        if (found.poly == st.poly && found.ref_in == st.ref_in
+            && crc8_lookup_set_tier(&found, tier)) {
+            break;
+        }
+        found.table = NULL;
+    }
+    if (st.table_len != 0 && found.table == NULL) {
+        return false;
+    }
+
+    ctx->init = (uint8_t)st.reg;
+    ctx->poly = (uint8_t)st.poly;
+    ctx->xor_out = (uint8_t)st.xor_out;
+    ctx->ref_in = st.ref_in;
+    ctx->ref_out = st.ref_out;
+    ctx->table_len = st.table_len;
+    ctx->table = found.table;
+    *offset = st.offset;
+
+    return true;
+}
+
+void crc16_lookup_state_export(const crc16_lookup_ctx_t* ctx, uint64_t offset,
+                               uint8_t* buf) {
+    state_t st = {STATE_KIND_CRC16_LOOKUP, ctx->init, ctx->poly, ctx->xor_out,
+                  ctx->ref_in, ctx->ref_out, ctx->table_len, offset};
+
+    state_pack(&st, buf);
+}
+
+bool crc16_lookup_state_import(crc16_lookup_ctx_t* ctx, uint64_t* offset,
+                               const uint8_t* buf) {
+    crc16_lookup_ctx_t found;
+    crc_tier_e tier;
+    state_t st;
+
+    if (!state_unpack(&st, STATE_KIND_CRC16_LOOKUP, buf)
+        || (st.table_len != 0 && !table_tier(st.table_len, &tier))) {
+        return false;
+    }
+
+    // Re-attach the built-in table of the polynomial and bit order
+    found.table = NULL;
+    for (int m = 0; st.table_len != 0 && m < CRC16_NONE_LOOKUP_MODEL; m++) {
+        crc16_lookup_init(&found, (crc16_lookup_param_model_e)m);
+        if (found.poly == st.poly && found.ref_in == st.ref_in
+            && crc16_lookup_set_tier(&found, tier)) {
+            break;
+        }
+        found.table = NULL;
+    }
+    if (st.table_len != 0 && found.table == NULL) {
+        return false;
+    }
+
+    ctx->init = (uint16_t)st.reg;
+    ctx->poly = (uint16_t)st.poly;
+    ctx->xor_out = (uint16_t)st.xor_out;
+    ctx->ref_in = st.ref_in;
+    ctx->ref_out = st.ref_out;
+    ctx->table_len = st.table_len;
+    ctx->table = found.table;
+    *offset = st.offset;
+
+    return true;
+}
+
+void crc32_lookup_state_export(const crc32_lookup_ctx_t* ctx, uint64_t offset,
+                               uint8_t* buf) {
+    state_t st = {STATE_KIND_CRC32_LOOKUP, ctx->init, ctx->poly, ctx->xor_out,
+                  ctx->ref_in, ctx->ref_out, ctx->table_len, offset};
+
+    state_pack(&st, buf);
+}
+
+bool crc32_lookup_state_import(crc32_lookup_ctx_t* ctx, uint64_t* offset,
+                               const uint8_t* buf) {
+    crc32_lookup_ctx_t found;
+    crc_tier_e tier;
+    state_t st;
+
+    if (!state_unpack(&st, STATE_KIND_CRC32_LOOKUP, buf)
+        || (st.table_len != 0 && !table_tier(st.table_len, &tier))) {
+        return false;
+    }
+
+    // Re-attach the built-in table of the polynomial and bit order
+    found.table = NULL;
+    for (int m = 0; st.table_len != 0 && m < CRC32_NONE_LOOKUP_MODEL; m++) {
+        crc32_lookup_init(&found, (crc32_lookup_param_model_e)m);
+        if (found.poly == st.poly && found.ref_in == st.ref_in
+            && crc32_lookup_set_tier(&found, tier)) {
+            break;
+        }
+        found.table = NULL;
+    }
+    if (st.table_len != 0 && found.table == NULL) {
+        return false;
+    }
+
+    ctx->init = st.reg;
+    ctx->poly = st.poly;
+    ctx->xor_out = st.xor_out;
+    ctx->ref_in = st.ref_in;
+    ctx->ref_out = st.ref_out;
+    ctx->table_len = st.table_len;
+    ctx->table = found.table;
+    *offset = st.offset;
+
+    return true;
+}
+
+bool crc_checkpoint_file(const char* path, const crc_checkpoint_cfg_t* cfg,
+                         crc_checkpoint_result_t* result) {
+    crc_batch_model_t batch;
+    crc_batch_engine_t eng;
+    crc_file_info_t info;
+    uint64_t offset = 0;
+
+    memset(result, 0, sizeof(*result));
+    if (path == NULL || cfg == NULL || cfg->checkpoint_path == NULL
+        || !crc_batch_model_get(&batch, cfg->width, cfg->model)
+        || !crc_file_info(path, &info)) {
+        return false;
+    }
+
+    crc_batch_engine_init(&eng, &batch);
+    uint32_t reg = eng.init;
+    if (checkpoint_load(cfg, &eng, &info, &reg, &offset)) {
+        result->resumed_at = offset;
+    } else {
+        reg = eng.init;
+        offset = 0;
+    }
+
+    uint64_t interval = cfg->interval != 0 ? cfg->interval
+                                           : CRC_CHECKPOINT_INTERVAL;
+    uint64_t end = info.size;
+    if (cfg->max_bytes != 0 && cfg->max_bytes < end - offset) {
+        end = offset + cfg->max_bytes;
+    }
+
+    uint8_t* buf = malloc(CHECKPOINT_CHUNK);
+    FILE* fp = fopen(path, "rb");
+    bool ok = buf != NULL && fp != NULL
+              && crc_fseek(fp, (int64_t)offset, SEEK_SET) == 0;
+    uint64_t next = offset + interval;
+
+    while (ok && offset < end) {
+        uint64_t stop = next < end ? next : end;
+        size_t n = stop - offset < CHECKPOINT_CHUNK ? (size_t)(stop - offset)
+                                                    : CHECKPOINT_CHUNK;
+
+        ok = fread(buf, 1, n, fp) == n;
+        if (ok) {
+            reg = crc_batch_update(&eng, reg, buf, (uint32_t)n);
+            offset += n;
+        }
+        if (ok && offset == next && offset < info.size) {
+            ok = checkpoint_save(cfg, &eng, &info, reg, offset);
+            result->checkpoints++;
+            next += interval;
+        }
+    }
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(buf);
+
+    result->offset = offset;
+    if (ok && offset == info.size) {
+        result->complete = true;
+        result->crc = crc_batch_final(&eng, reg);
+        remove(cfg->checkpoint_path);
+    } else if (ok && offset != result->resumed_at) {
+        // Stopped by max_bytes: keep what was done in this run
+        ok = checkpoint_save(cfg, &eng, &info, reg, offset);
+        result->checkpoints++;
+    }
+
+    return ok;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Serialise a state.
+ *
+ * Layout, little-endian: magic (4), version (2), kind (1), flags (1),
+ * register (4), polynomial (4), final XOR (4), table length (2), reserved (2),
+ * offset (8), then the `CRC32_MODEL` CRC of the preceding bytes (4).
+ *
+ * \param[in]       st: Pointer to the state
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+static void state_pack(const state_t* st, uint8_t* buf) {
+    crc_put_le(buf + 0, STATE_MAGIC, 4);
+    crc_put_le(buf + 4, CRC_STATE_VERSION, 2);
+    crc_put_le(buf + 6, (uint64_t)st->kind, 1);
+    crc_put_le(buf + 7, (st->ref_in ? 1u : 0u) | (st->ref_out ? 2u : 0u), 1);
+    crc_put_le(buf + 8, st->reg, 4);
+    crc_put_le(buf + 12, st->poly, 4);
+    crc_put_le(buf + 16, st->xor_out, 4);
+    crc_put_le(buf + 20, st->table_len, 2);
+    crc_put_le(buf + 22, 0, 2);
+    crc_put_le(buf + 24, st->offset, 8);
+    crc_put_le(buf + 32, crc32_calculate(CRC32_MODEL, buf, 32), 4);
+}
+
+/**
+ * \brief           Deserialise a state of a given context type.
+ *
+ * \param[out]      st: Pointer to the state
+ * \param[in]       kind: Expected context type
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is invalid
+ */
+static bool state_unpack(state_t* st, state_kind_e kind, const uint8_t* buf) {
+    if (crc_get_le(buf + 0, 4) != STATE_MAGIC
+        || crc_get_le(buf + 4, 2) != CRC_STATE_VERSION
+        || crc_get_le(buf + 6, 1) != (uint64_t)kind
+        || (crc_get_le(buf + 7, 1) & ~3u) != 0 || crc_get_le(buf + 22, 2) != 0
+        || crc_get_le(buf + 32, 4) != crc32_calculate(CRC32_MODEL, buf, 32)) {
+        return false;
+    }
+
+    st->kind = kind;
+    st->ref_in = (buf[7] & 1u) != 0;
+    st->ref_out = (buf[7] & 2u) != 0;
+    st->reg = (uint32_t)crc_get_le(buf + 8, 4);
+    st->poly = (uint32_t)crc_get_le(buf + 12, 4);
+    st->xor_out = (uint32_t)crc_get_le(buf + 16, 4);
+    st->table_len = (uint16_t)crc_get_le(buf + 20, 2);
+    st->offset = crc_get_le(buf + 24, 8);
+
+    return true;
+}
+
+/**
+ * \brief           Get the context type matching a driver CRC width.
+ *
+ * \param[in]       width: CRC width in bits: 8, 16 or 32
+ * \return          Type of the plain context of that width
+ */
+static state_kind_e driver_kind(uint8_t width) {
+    if (width == 8) {
+        return STATE_KIND_CRC8;
+    }
+    if (width == 16) {
+        return STATE_KIND_CRC16;
+    }
+
+    return STATE_KIND_CRC32;
+}
+
+/**
+ * \brief           Reverse the bits of a register.
+ *
+ * Converts between the reflected register of the batch engine and the
+ * MSB-first register of the contexts.
+ *
+ * \param[in]       reg: The register
+ * \param[in]       width: Width of the register in bits: 8, 16 or 32
+ * \return          The reversed register
+ */
+static uint32_t reflect_reg(uint32_t reg, uint8_t width) {
+    if (width == 8) {
+        return reverse_bits((uint8_t)reg);
+    }
+    if (width == 16) {
+        return reverse_bits_16((uint16_t)reg);
+    }
+
+    return reverse_bits_32(reg);
+}
+
+/**
+ * \brief           Get the table tier of a lookup table length.
+ *
+ * \param[in]       table_len: Table length of a lookup context
+ * \param[out]      tier: The table tier
+ * \return          `true` if the length is the one of a tier, `false` otherwise
+ */
+static bool table_tier(uint16_t table_len, crc_tier_e* tier) {
+    if (table_len == 16) {
+        *tier = CRC_TIER_NIBBLE;
+        return true;
+    }
+
+    *tier = (crc_tier_e)(table_len / 256);
+
+    return table_len % 256 == 0 && crc_tier_is_valid(*tier);
+}
+
+/**
+ * \brief           Load the checkpoint of a file.
+ *
+ * Layout: the serialised state (`CRC_STATE_SIZE`), file size (8), file
+ * modification time (8), then the `CRC32_MODEL` CRC of the preceding bytes
+ * (4), all little-endian.
+ *
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[in]       eng: Pointer to the engine of the configured model
+ * \param[in]       info: Attributes of the file
+ * \param[out]      reg: Register of the engine at `offset`
+ * \param[out]      offset: Offset to resume from
+ * \return          `true` if a checkpoint of this file and model was loaded,
+ *                  `false` otherwise
+ */
+static bool checkpoint_load(const crc_checkpoint_cfg_t* cfg,
+                            const crc_batch_engine_t* eng,
+                            const crc_file_info_t* info, uint32_t* reg,
+                            uint64_t* offset) {
+    uint8_t buf[CRC_CHECKPOINT_FILE_SIZE + 1];
+    const uint32_t size = CRC_CHECKPOINT_FILE_SIZE;
+    state_t st;
+
+    FILE* fp = fopen(cfg->checkpoint_path, "rb");
+    if (fp == NULL) {
+        return false;
+    }
+    bool ok = fread(buf, 1, sizeof(buf), fp) == size;
+    fclose(fp);
+
+    ok = ok
+         && crc_get_le(buf + size - 4, 4)
+                == crc32_calculate(CRC32_MODEL, buf, size - 4)
+         && state_unpack(&st, driver_kind(cfg->width), buf)
+         && crc_get_le(buf + CRC_STATE_SIZE, 8) == info->size
+         && (int64_t)crc_get_le(buf + CRC_STATE_SIZE + 8, 8) == info->mtime_ns
+         && st.poly == eng->model.poly && st.xor_out == eng->model.xor_out
+         && st.ref_in == eng->model.ref_in && st.ref_out == eng->model.ref_out
+         && st.offset <= info->size;
+    if (!ok) {
+        return false;
+    }
+
+    *reg = eng->reflected ? reflect_reg(st.reg, eng->model.width) : st.reg;
+    *offset = st.offset;
+
+    return true;
+}
+
+/**
+ * \brief           Save the checkpoint of a file.
+ *
+ * The checkpoint is written to a temporary file, flushed to disk and moved
+ * over the previous one.
+ *
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[in]       eng: Pointer to the engine of the configured model
+ * \param[in]       info: Attributes of the file
+ * \param[in]       reg: Register of the engine at `offset`
+ * \param[in]       offset: Number of bytes processed
+ * \return          `true` on success, `false` on I/O errors
+ */
+static bool checkpoint_save(const crc_checkpoint_cfg_t* cfg,
+                            const crc_batch_engine_t* eng,
+                            const crc_file_info_t* info, uint32_t reg,
+                            uint64_t offset) {
+    uint8_t buf[CRC_CHECKPOINT_FILE_SIZE];
+    const uint32_t size = CRC_CHECKPOINT_FILE_SIZE;
+    state_t st;
+
+    st.kind = driver_kind(cfg->width);
+    st.reg = eng->reflected ? reflect_reg(reg, eng->model.width) : reg;
+    st.poly = eng->model.poly;
+    st.xor_out = eng->model.xor_out;
+    st.ref_in = eng->model.ref_in;
+    st.ref_out = eng->model.ref_out;
+    st.table_len = 0;
+    st.offset = offset;
+    state_pack(&st, buf);
+    crc_put_le(buf + CRC_STATE_SIZE, info->size, 8);
+    crc_put_le(buf + CRC_STATE_SIZE + 8, (uint64_t)info->mtime_ns, 8);
+    crc_put_le(buf + size - 4, crc32_calculate(CRC32_MODEL, buf, size - 4), 4);
+
+    size_t len = strlen(cfg->checkpoint_path);
+    char* tmp = malloc(len + 5);
+    if (tmp == NULL) {
+        return false;
+    }
+    memcpy(tmp, cfg->checkpoint_path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE* fp = fopen(tmp, "wb");
+    bool ok = fp != NULL;
+    if (ok) {
+        ok = fwrite(buf, 1, size, fp) == size && crc_file_sync(fp);
+        ok = (fclose(fp) == 0) && ok
+             && crc_file_replace(tmp, cfg->checkpoint_path);
+    }
+    if (!ok) {
+        remove(tmp);
+    }
+    free(tmp);
+
+    return ok;
+}
+
+/* ----------------------------- end of file -------------------------------- */
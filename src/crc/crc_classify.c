@@ -0,0 +1,378 @@
+/**
+ * \file            crc_classify.c
+ * \brief           CRC model and trailer layout classification
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include "crc/crc_classify.h"
+#include "crc/bit_utils.h"
+#include "crc/gf2poly.h"
+#include "crc_batch.h"
+
+/* Private definitions ------------------------------------------------------ */
+#define CLASSIFY_SPAN (CRC_CLASSIFY_OFFSET_MAX + 1)
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Raw register shared by the models of one polynomial.
+ *
+ * The register runs from 0 and is kept in MSB-first order at the positions
+ * of interest of the current frame.
+ */
+typedef struct {
+    crc_batch_engine_t eng;           /*!< Engine of the polynomial, init 0 */
+    gf2poly_powers_t powers;          /*!< Powers of x^8 mod the polynomial */
+    uint32_t alive;                   /*!< Number of live candidates */
+    uint32_t pre[CLASSIFY_SPAN];      /*!< Register after `skip` bytes */
+    uint32_t end[CLASSIFY_SPAN];      /*!< Register before the CRC, by tail */
+    uint32_t xpow[CLASSIFY_SPAN][CLASSIFY_SPAN]; /*!< x^(8 * covered bytes),
+                                                      by skip and tail */
+    uint32_t stamp[CLASSIFY_SPAN][CLASSIFY_SPAN]; /*!< Frame number + 1 of
+                                                       each `xpow` */
+} classify_lane_t;
+
+/**
+ * \brief           Model and layout under test.
+ */
+typedef struct {
+    const crc_model_t* model; /*!< The model */
+    uint32_t lane;            /*!< Lane of the model */
+    uint8_t skip;             /*!< Leading bytes left out of the CRC */
+    uint8_t tail;             /*!< Bytes after the CRC */
+    bool big_endian;          /*!< Byte order of the CRC */
+    bool dead;                /*!< Whether too many frames failed */
+    uint32_t failures;        /*!< Number of frames failed */
+    uint32_t matched;         /*!< Number of frames validated */
+} classify_cand_t;
+
+/**
+ * \brief           Classification shared by the workers.
+ *
+ * Lanes are independent: each worker claims whole lanes and runs them, with
+ * their candidates, over every frame.
+ */
+typedef struct {
+    const crc_classify_cfg_t* cfg; /*!< The configuration */
+    const uint8_t* const* bufs;    /*!< Pointers to the frames */
+    const uint32_t* lens;          /*!< Lengths of the frames */
+    uint32_t n;                    /*!< Number of frames */
+    classify_lane_t* lanes;        /*!< The lanes */
+    classify_cand_t* cands;        /*!< The candidates */
+    uint32_t* order;               /*!< Candidates grouped by lane */
+    uint32_t* first;               /*!< Start of each lane in `order` */
+    crc_chunks_t chunks;           /*!< One chunk per lane */
+} classify_job_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static void* classify_worker(void* arg);
+static void classify_lane_run(classify_lane_t* lane, const uint8_t* buf,
+                              uint32_t len, uint32_t skip_max,
+                              uint32_t tail_max);
+static bool classify_check(classify_lane_t* lane, const classify_cand_t* cand,
+                           const uint8_t* buf, uint32_t len, uint32_t frame);
+
+/* Public functions --------------------------------------------------------- */
+uint32_t crc_classify(const crc_classify_cfg_t* cfg,
+                      const uint8_t* const bufs[], const uint32_t lens[],
+                      uint32_t n, crc_classify_match_t matches[],
+                      uint32_t max_matches) {
+    if (cfg == NULL || bufs == NULL || lens == NULL
+        || cfg->skip_max > CRC_CLASSIFY_OFFSET_MAX
+        || cfg->tail_max > CRC_CLASSIFY_OFFSET_MAX) {
+        return 0;
+    }
+
+    const crc_model_t* models = cfg->models;
+    uint32_t count = cfg->count;
+    if (models == NULL) {
+        models = crc_model_catalog(&count);
+    }
+
+    uint32_t layouts = (cfg->skip_max + 1u) * (cfg->tail_max + 1u) * 2;
+    classify_lane_t* lanes = calloc(count, sizeof(*lanes));
+    classify_cand_t* cands = calloc((size_t)count * layouts, sizeof(*cands));
+    uint32_t* order = malloc((size_t)count * layouts * sizeof(*order));
+    uint32_t* first = calloc((size_t)count + 1, sizeof(*first));
+    uint32_t nlanes = 0;
+    uint32_t ncands = 0;
+
+    if (lanes == NULL || cands == NULL || order == NULL || first == NULL) {
+        free(lanes);
+        free(cands);
+        free(order);
+        free(first);
+        return 0;
+    }
+
+    for (uint32_t m = 0; m < count; m++) {
+        const crc_model_t* model = &models[m];
+        uint32_t k = 0;
+
+        if (model->width != 8 && model->width != 16 && model->width != 32) {
+            continue;
+        }
+        while (k < nlanes
+               && (lanes[k].eng.model.width != model->width
+                   || lanes[k].eng.model.poly != model->poly
+                   || lanes[k].eng.model.ref_in != model->ref_in)) {
+            k++;
+        }
+        if (k == nlanes) {
+            crc_batch_model_t raw = {0, 0, model->poly, model->width,
+                                     model->ref_in, model->ref_in};
+
+            crc_batch_engine_init(&lanes[k].eng, &raw);
+            gf2poly_powers_init(&lanes[k].powers,
+                                gf2poly_xpow(8, model->poly, model->width),
+                                model->poly, model->width);
+            nlanes++;
+        }
+
+        for (uint8_t skip = 0; skip <= cfg->skip_max; skip++) {
+            for (uint8_t tail = 0; tail <= cfg->tail_max; tail++) {
+                for (int be = 0; be <= (model->width > 8); be++) {
+                    classify_cand_t* cand = &cands[ncands++];
+
+                    cand->model = model;
+                    cand->lane = k;
+                    cand->skip = skip;
+                    cand->tail = tail;
+                    cand->big_endian = be != 0;
+                    lanes[k].alive++;
+                }
+            }
+        }
+    }
+
+    // Group the candidates by lane, keeping their order within a lane
+    for (uint32_t k = 0; k < nlanes; k++) {
+        first[k + 1] = first[k] + lanes[k].alive;
+        lanes[k].alive = 0;
+    }
+    for (uint32_t c = 0; c < ncands; c++) {
+        uint32_t k = cands[c].lane;
+
+        order[first[k] + lanes[k].alive++] = c;
+    }
+
+    classify_job_t job = {
+        .cfg = cfg,
+        .bufs = bufs,
+        .lens = lens,
+        .n = n,
+        .lanes = lanes,
+        .cands = cands,
+        .order = order,
+        .first = first,
+    };
+    uint32_t threads = cfg->threads != 0 ? cfg->threads : crc_cpu_count();
+
+    crc_chunks_init(&job.chunks, nlanes);
+    threads = threads < CRC_CLASSIFY_THREADS_MAX ? threads
+                                                 : CRC_CLASSIFY_THREADS_MAX;
+    threads = threads < nlanes ? threads : nlanes;
+    crc_parallel_run(classify_worker, &job, 0, threads);
+
+    uint32_t found = 0;
+    for (uint32_t c = 0; c < ncands; c++) {
+        if (cands[c].dead || cands[c].matched == 0) {
+            continue;
+        }
+        if (found < max_matches) {
+            crc_classify_match_t* match = &matches[found];
+
+            match->model = cands[c].model;
+            match->skip = cands[c].skip;
+            match->tail = cands[c].tail;
+            match->big_endian = cands[c].big_endian;
+            match->matched = cands[c].matched;
+        }
+        found++;
+    }
+
+    free(lanes);
+    free(cands);
+    free(order);
+    free(first);
+
+    return found;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Run claimed lanes and their candidates over the frames.
+ *
+ * \param[in,out]   arg: Pointer to the classification
+ * \return          NULL
+ */
+static void* classify_worker(void* arg) {
+    classify_job_t* job = arg;
+    const crc_classify_cfg_t* cfg = job->cfg;
+    uint64_t k;
+
+    while (crc_chunks_claim(&job->chunks, &k)) {
+        classify_lane_t* lane = &job->lanes[k];
+
+        for (uint32_t f = 0; f < job->n && lane->alive != 0; f++) {
+            classify_lane_run(lane, job->bufs[f], job->lens[f], cfg->skip_max,
+                              cfg->tail_max);
+            for (uint32_t i = job->first[k]; i < job->first[k + 1]; i++) {
+                classify_cand_t* cand = &job->cands[job->order[i]];
+
+                if (cand->dead) {
+                    continue;
+                }
+                if (classify_check(lane, cand, job->bufs[f], job->lens[f],
+                                   f)) {
+                    cand->matched++;
+                } else if (++cand->failures > cfg->max_failures) {
+                    cand->dead = true;
+                    lane->alive--;
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           Run the raw register of a lane over a frame.
+ *
+ * A single pass records the register after each possible skip and before
+ * each possible trailer position.
+ *
+ * \param[in,out]   lane: Pointer to the lane
+ * \param[in]       buf: Pointer to the frame
+ * \param[in]       len: Length of the frame in bytes
+ * \param[in]       skip_max: Largest skip of the layouts
+ * \param[in]       tail_max: Largest tail of the layouts
+ */
+static void classify_lane_run(classify_lane_t* lane, const uint8_t* buf,
+                              uint32_t len, uint32_t skip_max,
+                              uint32_t tail_max) {
+    const crc_batch_engine_t* eng = &lane->eng;
+    uint32_t bytes = eng->model.width / 8u;
+    uint32_t pos[2 * CLASSIFY_SPAN];
+    uint32_t* out[2 * CLASSIFY_SPAN];
+    uint32_t targets = 0;
+
+    for (uint32_t s = 0; s <= skip_max && s <= len; s++) {
+        pos[targets] = s;
+        out[targets++] = &lane->pre[s];
+    }
+    for (uint32_t t = tail_max + 1; t-- > 0;) {
+        if (len >= bytes + t) {
+            pos[targets] = len - bytes - t;
+            out[targets++] = &lane->end[t];
+        }
+    }
+
+    // Visit the positions in increasing order: few enough for insertion sort
+    for (uint32_t i = 1; i < targets; i++) {
+        for (uint32_t j = i; j > 0 && pos[j - 1] > pos[j]; j--) {
+            uint32_t p = pos[j];
+            uint32_t* o = out[j];
+
+            pos[j] = pos[j - 1];
+            out[j] = out[j - 1];
+            pos[j - 1] = p;
+            out[j - 1] = o;
+        }
+    }
+
+    uint32_t reg = 0;
+    uint32_t at = 0;
+    for (uint32_t i = 0; i < targets; i++) {
+        reg = crc_batch_update(eng, reg, buf + at, pos[i] - at);
+        at = pos[i];
+        *out[i] = eng->reflected ? reverse_bits_32(reg) >> (32 - bytes * 8)
+                                 : reg;
+    }
+}
+
+/**
+ * \brief           Check a model and layout against a frame.
+ *
+ * With `N(p)` the raw register after `p` bytes and `e` the CRC position,
+ * the register of the model over `[skip, e)` is
+ * `N(e) ^ (N(skip) ^ init) * x^(8 * (e - skip))`.
+ *
+ * \param[in,out]   lane: Pointer to the lane, run over the frame
+ * \param[in]       cand: Pointer to the candidate
+ * \param[in]       buf: Pointer to the frame
+ * \param[in]       len: Length of the frame in bytes
+ * \param[in]       frame: Number of the frame
+ * \return          `true` if the frame is valid for the candidate
+ */
+static bool classify_check(classify_lane_t* lane, const classify_cand_t* cand,
+                           const uint8_t* buf, uint32_t len, uint32_t frame) {
+    const crc_model_t* model = cand->model;
+    uint8_t width = model->width;
+    uint32_t bytes = width / 8u;
+
+    if (len < bytes + cand->tail
+        || len - bytes - cand->tail <= cand->skip) {
+        return false; // No byte left to be covered
+    }
+
+    uint32_t e = len - bytes - cand->tail;
+    uint32_t* xpow = &lane->xpow[cand->skip][cand->tail];
+    uint32_t* stamp = &lane->stamp[cand->skip][cand->tail];
+
+    if (*stamp != frame + 1) {
+        *xpow = (uint32_t)gf2poly_powers_get(&lane->powers, e - cand->skip);
+        *stamp = frame + 1;
+    }
+
+    uint32_t reg = lane->end[cand->tail]
+                   ^ (uint32_t)gf2poly_barrett_mulmod(
+                       &lane->powers.barrett,
+                       lane->pre[cand->skip] ^ model->init, *xpow);
+    if (model->ref_out) {
+        reg = reverse_bits_32(reg) >> (32 - width);
+    }
+
+    uint32_t stored = 0;
+    for (uint32_t b = 0; b < bytes; b++) {
+        uint32_t shift = cand->big_endian ? 8 * (bytes - 1 - b) : 8 * b;
+
+        stored |= (uint32_t)buf[e + b] << shift;
+    }
+
+    return stored == (reg ^ model->xor_out);
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,309 @@
+/**
+ * \file            crc_clmul.c
+ * \brief           CRC engine with carry-less multiply folding for any
+ *                  polynomial
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include "crc/crc_clmul.h"
+#include "crc/bit_utils.h"
+#include "crc/gf2poly.h"
+#include "crc_batch.h"
+#include "crc_cpu.h"
+#if CRC_HAVE_CLMUL
+#include <immintrin.h>
+#endif
+
+/* Private function prototypes ---------------------------------------------- */
+static uint64_t clmul_table_update(const crc_clmul_ctx_t* ctx, uint64_t reg,
+                                   const uint8_t* buf, uint32_t len);
+#if CRC_HAVE_CLMUL
+static uint32_t clmul_fold_hw(const uint64_t fold[4], bool reflected,
+                              uint64_t reg, const uint8_t* buf, uint32_t len,
+                              uint8_t rem[16]);
+#endif
+
+/* Public functions --------------------------------------------------------- */
+bool crc_clmul_init(crc_clmul_ctx_t* ctx, const crc_clmul_param_t* param) {
+    uint8_t width = param->width;
+
+    if (width == 0 || width > 64
+        || (width < 64 && (param->poly >> width) != 0)) {
+        return false;
+    }
+
+    // The register is kept as that of P * x^(64 - width), a 64-bit CRC
+    // whose value is the CRC shifted to the top
+    uint8_t shift = (uint8_t)(64 - width);
+    uint64_t poly = param->poly << shift;
+    uint64_t rpoly = reverse_bits_64(poly);
+
+    ctx->param = *param;
+    ctx->table[0] = 0;
+
+    // Only the single-bit entries are shifted bit by bit: the table is
+    // linear, so every other entry is the XOR of two entries already computed
+    for (uint32_t k = 0; k < 8; k++) {
+        uint64_t crc;
+
+        if (param->ref_in) {
+            crc = (uint64_t)1 << k;
+            for (int j = 0; j < 8; j++) {
+                crc = (crc & 1) ? (crc >> 1) ^ rpoly : crc >> 1;
+            }
+        } else {
+            crc = (uint64_t)1 << (k + 56);
+            for (int j = 0; j < 8; j++) {
+                crc = (crc >> 63) ? (crc << 1) ^ poly : crc << 1;
+            }
+        }
+        ctx->table[1u << k] = crc;
+    }
+    for (uint32_t i = 3; i < 256; i++) {
+        uint32_t low = i & (~i + 1);
+
+        if (low != i) {
+            ctx->table[i] = ctx->table[low] ^ ctx->table[i ^ low];
+        }
+    }
+
+    ctx->clmul = crc_cpu_has_clmul();
+    if (ctx->clmul) {
+        crc_clmul_consts(ctx->fold, param->poly, width, param->ref_in);
+    }
+    crc_clmul_reset(ctx);
+
+    return true;
+}
+
+bool crc_clmul_init_model(crc_clmul_ctx_t* ctx, const crc_model_t* model) {
+    crc_clmul_param_t param;
+
+    param.width = model->width;
+    param.poly = model->poly;
+    param.init = model->init;
+    param.xor_out = model->xor_out;
+    param.ref_in = model->ref_in;
+    param.ref_out = model->ref_out;
+
+    return crc_clmul_init(ctx, &param);
+}
+
+void crc_clmul_reset(crc_clmul_ctx_t* ctx) {
+    uint64_t init = ctx->param.init << (64 - ctx->param.width);
+
+    ctx->reg = ctx->param.ref_in ? reverse_bits_64(init) : init;
+}
+
+void crc_clmul_update(crc_clmul_ctx_t* ctx, const uint8_t* buf, uint32_t len) {
+    uint64_t reg = ctx->reg;
+
+    if (ctx->clmul && len >= CRC_CLMUL_MIN) {
+        uint8_t rem[16];
+        uint32_t done = crc_clmul_fold(ctx->fold, ctx->param.ref_in, reg, buf,
+                                       len, rem);
+
+        reg = clmul_table_update(ctx, 0, rem, sizeof(rem));
+        buf += done;
+        len -= done;
+    }
+
+    ctx->reg = clmul_table_update(ctx, reg, buf, len);
+}
+
+uint64_t crc_clmul_final(const crc_clmul_ctx_t* ctx) {
+    uint8_t shift = (uint8_t)(64 - ctx->param.width);
+    uint64_t reg = ctx->reg;
+
+    // Back to the top of an MSB-first register, then to the output order
+    if (ctx->param.ref_in) {
+        reg = reverse_bits_64(reg);
+    }
+    reg = ctx->param.ref_out ? reverse_bits_64(reg) : reg >> shift;
+
+    return reg ^ ctx->param.xor_out;
+}
+
+uint64_t crc_clmul_calculate(const crc_clmul_param_t* param,
+                             const uint8_t* buf, uint32_t len) {
+    crc_clmul_ctx_t ctx;
+
+    if (!crc_clmul_init(&ctx, param)) {
+        return 0;
+    }
+    crc_clmul_update(&ctx, buf, len);
+
+    return crc_clmul_final(&ctx);
+}
+
+void crc_clmul_consts(uint64_t fold[4], uint64_t poly, uint8_t width,
+                      bool reflected) {
+    static const uint32_t dist[2] = {512, 128}; // By 4 blocks, by 1
+
+    // A block H * x^64 + L moves `d` bits on as H * x^(d + 64) + L * x^d.
+    // Reflected, the 127-bit products come out one bit low, which one power
+    // of x less in the constants makes up for.
+    for (uint32_t i = 0; i < 2; i++) {
+        if (reflected) {
+            fold[2 * i] = reverse_bits_64(
+                gf2poly_xpow(dist[i] + 63, poly, width));
+            fold[2 * i + 1] = reverse_bits_64(
+                gf2poly_xpow(dist[i] - 1, poly, width));
+        } else {
+            fold[2 * i] = gf2poly_xpow(dist[i] + 64, poly, width);
+            fold[2 * i + 1] = gf2poly_xpow(dist[i], poly, width);
+        }
+    }
+}
+
+uint32_t crc_clmul_fold(const uint64_t fold[4], bool reflected, uint64_t reg,
+                        const uint8_t* buf, uint32_t len, uint8_t rem[16]) {
+#if CRC_HAVE_CLMUL
+    return clmul_fold_hw(fold, reflected, reg, buf, len, rem);
+#else
+    (void)fold;
+    (void)reflected;
+    (void)reg;
+    (void)buf;
+    (void)len;
+    (void)rem;
+    return 0;
+#endif
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Run the register over a buffer with the byte-wise table.
+ *
+ * \param[in]       ctx: Pointer to the context
+ * \param[in]       reg: Register value before the buffer
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          Register value after the buffer
+ */
+static uint64_t clmul_table_update(const crc_clmul_ctx_t* ctx, uint64_t reg,
+                                   const uint8_t* buf, uint32_t len) {
+    const uint64_t* t = ctx->table;
+
+    if (ctx->param.ref_in) {
+        for (uint32_t i = 0; i < len; i++) {
+            reg = (reg >> 8) ^ t[(reg ^ buf[i]) & 0xFF];
+        }
+    } else {
+        for (uint32_t i = 0; i < len; i++) {
+            reg = (reg << 8) ^ t[(reg >> 56) ^ buf[i]];
+        }
+    }
+
+    return reg;
+}
+
+#if CRC_HAVE_CLMUL
+/**
+ * \brief           Fold with PCLMULQDQ, as in `crc_clmul_fold`.
+ *
+ * Four blocks are folded in parallel to hide the multiply latency, then
+ * into one, which takes the remaining whole blocks.
+ *
+ * \param[in]       fold: Constants from `crc_clmul_consts`
+ * \param[in]       reflected: Whether the register is reflected
+ * \param[in]       reg: The register
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \param[out]      rem: The remainder block
+ * \return          Number of bytes folded
+ */
+CRC_TARGET_CLMUL
+static uint32_t clmul_fold_hw(const uint64_t fold[4], bool reflected,
+                              uint64_t reg, const uint8_t* buf, uint32_t len,
+                              uint8_t rem[16]) {
+    if (len < 64) {
+        return 0;
+    }
+
+    // MSB-first blocks are big-endian 128-bit numbers; reflected blocks are
+    // taken as they are, with the halves' roles swapped in the constants
+    __m128i order = reflected ? _mm_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7,
+                                             6, 5, 4, 3, 2, 1, 0)
+                              : _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                             11, 12, 13, 14, 15);
+    __m128i k4 = reflected ? _mm_set_epi64x((long long)fold[1],
+                                            (long long)fold[0])
+                           : _mm_set_epi64x((long long)fold[0],
+                                            (long long)fold[1]);
+    __m128i k1 = reflected ? _mm_set_epi64x((long long)fold[3],
+                                            (long long)fold[2])
+                           : _mm_set_epi64x((long long)fold[2],
+                                            (long long)fold[3]);
+    __m128i x[4];
+    uint32_t left = len - 64;
+
+#define CLMUL_LOAD(p) \
+    _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(p)), order)
+#define CLMUL_FOLD(v, k)                                                       \
+    _mm_xor_si128(_mm_clmulepi64_si128((v), (k), 0x00),                        \
+                  _mm_clmulepi64_si128((v), (k), 0x11))
+
+    for (uint32_t i = 0; i < 4; i++) {
+        x[i] = CLMUL_LOAD(buf + 16 * i);
+    }
+    x[0] = _mm_xor_si128(x[0], reflected ? _mm_set_epi64x(0, (long long)reg)
+                                         : _mm_set_epi64x((long long)reg, 0));
+    buf += 64;
+
+    for (; left >= 64; left -= 64, buf += 64) {
+        for (uint32_t i = 0; i < 4; i++) {
+            x[i] = _mm_xor_si128(CLMUL_FOLD(x[i], k4),
+                                 CLMUL_LOAD(buf + 16 * i));
+        }
+    }
+
+    __m128i acc = x[0];
+    for (uint32_t i = 1; i < 4; i++) {
+        acc = _mm_xor_si128(CLMUL_FOLD(acc, k1), x[i]);
+    }
+    for (; left >= 16; left -= 16, buf += 16) {
+        acc = _mm_xor_si128(CLMUL_FOLD(acc, k1), CLMUL_LOAD(buf));
+    }
+
+#undef CLMUL_LOAD
+#undef CLMUL_FOLD
+
+    // The byte order is its own inverse
+    _mm_storeu_si128((__m128i*)(void*)rem, _mm_shuffle_epi8(acc, order));
+
+    return len - left;
+}
+#endif
+
+/* ----------------------------- end of file -------------------------------- */
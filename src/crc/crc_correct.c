@@ -0,0 +1,340 @@
+/**
+ * \file            crc_correct.c
+ * \brief           Single- and double-bit error correction for CRC16 and CRC32
+ *                  frames
+ * \date            2026-10-18
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdlib.h>
+#include "crc/crc_correct.h"
+#include "crc/bit_utils.h"
+
+/* Private configuration ---------------------------------------------------- */
+/**
+ * \brief           Maximum frame length for which double-bit errors are
+ *                  indexed. The index grows with the square of the length.
+ */
+#ifndef CRC_CORRECT_DOUBLE_MAX_LEN
+#define CRC_CORRECT_DOUBLE_MAX_LEN 128
+#endif
+
+/* Private definitions ------------------------------------------------------ */
+#define LOC_EMPTY     0xFFFFFFFFu /*!< loc_a of an unused entry */
+#define LOC_AMBIGUOUS 0xFFFFFFFEu /*!< loc_a of a syndrome shared by errors */
+#define LOC_NONE      0xFFFFFFFFu /*!< loc_b of a single-bit error */
+
+/* Private function prototypes ---------------------------------------------- */
+static bool correct_build(crc_correct_t* corr);
+static void correct_insert(crc_correct_t* corr, uint32_t syndrome,
+                           uint32_t loc_a, uint32_t loc_b);
+static const crc_correct_entry_t* correct_find(const crc_correct_t* corr,
+                                               uint32_t syndrome);
+static void correct_flip(uint8_t* buf, uint32_t len, uint32_t loc);
+
+/* Public functions --------------------------------------------------------- */
+bool crc16_correct_init(crc_correct_t* corr, crc16_param_model_e model,
+                        uint32_t max_len, bool double_bit) {
+    if (corr == NULL || (uint32_t)model >= CRC16_NONE_MODEL
+        || max_len <= sizeof(uint16_t) || max_len > (UINT32_MAX / 16)
+        || (double_bit && max_len > CRC_CORRECT_DOUBLE_MAX_LEN)) {
+        return false;
+    }
+
+    corr->width = 16;
+    corr->model = (uint8_t)model;
+    corr->double_bit = double_bit;
+    corr->max_len = max_len;
+    corr->entries = NULL;
+    corr->mask = 0;
+
+    return true;
+}
+
+bool crc32_correct_init(crc_correct_t* corr, crc32_param_model_e model,
+                        uint32_t max_len, bool double_bit) {
+    if (corr == NULL || (uint32_t)model >= CRC32_NONE_MODEL
+        || max_len <= sizeof(uint32_t) || max_len > (UINT32_MAX / 16)
+        || (double_bit && max_len > CRC_CORRECT_DOUBLE_MAX_LEN)) {
+        return false;
+    }
+
+    corr->width = 32;
+    corr->model = (uint8_t)model;
+    corr->double_bit = double_bit;
+    corr->max_len = max_len;
+    corr->entries = NULL;
+    corr->mask = 0;
+
+    return true;
+}
+
+int crc_correct_buf(crc_correct_t* corr, uint8_t* buf, uint32_t len) {
+    uint32_t trailer = corr->width / 8;
+
+    if (buf == NULL || len <= trailer || len > corr->max_len) {
+        return -1;
+    }
+
+    // Syndrome: calculated CRC XOR stored (little-endian) CRC
+    uint32_t syndrome;
+    if (corr->width == 16) {
+        uint16_t stored = (uint16_t)((buf[len - 1] << 8) | buf[len - 2]);
+        syndrome = stored
+                   ^ crc16_calculate((crc16_param_model_e)corr->model, buf,
+                                     len - trailer);
+    } else {
+        uint32_t stored = ((uint32_t)buf[len - 1] << 24)
+                          | ((uint32_t)buf[len - 2] << 16)
+                          | ((uint32_t)buf[len - 3] << 8) | buf[len - 4];
+        syndrome = stored
+                   ^ crc32_calculate((crc32_param_model_e)corr->model, buf,
+                                     len - trailer);
+    }
+
+    if (syndrome == 0) {
+        return 0;
+    }
+
+    if (corr->entries == NULL && !correct_build(corr)) {
+        return -1;
+    }
+
+    const crc_correct_entry_t* entry = correct_find(corr, syndrome);
+    if (entry == NULL || entry->loc_a == LOC_AMBIGUOUS) {
+        return -1;
+    }
+
+    // Errors located before the start of this (shorter) frame are not real
+    if (entry->loc_a / 8 >= len
+        || (entry->loc_b != LOC_NONE && entry->loc_b / 8 >= len)) {
+        return -1;
+    }
+
+    correct_flip(buf, len, entry->loc_a);
+    if (entry->loc_b == LOC_NONE) {
+        return 1;
+    }
+    correct_flip(buf, len, entry->loc_b);
+
+    return 2;
+}
+
+void crc_correct_deinit(crc_correct_t* corr) {
+    free(corr->entries);
+    corr->entries = NULL;
+    corr->mask = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Build the syndrome index of a context.
+ *
+ * \param[in,out]   corr: Pointer to the error correction context
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool correct_build(crc_correct_t* corr) {
+    uint32_t trailer = corr->width / 8;
+    uint32_t bits = corr->max_len * 8;
+    uint32_t top = 1u << (corr->width - 1);
+    uint32_t mask = corr->width == 32 ? 0xFFFFFFFFu : 0xFFFFu;
+    uint32_t poly;
+    bool ref_in;
+    bool ref_out;
+
+    if (corr->width == 16) {
+        crc16_ctx_t ctx;
+        crc16_init(&ctx, (crc16_param_model_e)corr->model);
+        poly = ctx.poly;
+        ref_in = ctx.ref_in;
+        ref_out = ctx.ref_out;
+    } else {
+        crc32_ctx_t ctx;
+        crc32_init(&ctx, (crc32_param_model_e)corr->model);
+        poly = ctx.poly;
+        ref_in = ctx.ref_in;
+        ref_out = ctx.ref_out;
+    }
+
+    uint64_t count = bits;
+    if (corr->double_bit) {
+        count += (uint64_t)bits * (bits - 1) / 2;
+    }
+    uint64_t capacity = 1;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+
+    uint32_t* syndromes = malloc(bits * sizeof(uint32_t));
+    uint32_t* locs = malloc(bits * sizeof(uint32_t));
+    corr->entries = malloc(capacity * sizeof(crc_correct_entry_t));
+    if (syndromes == NULL || locs == NULL || corr->entries == NULL) {
+        free(syndromes);
+        free(locs);
+        crc_correct_deinit(corr);
+        return false;
+    }
+    corr->mask = (uint32_t)(capacity - 1);
+    for (uint64_t i = 0; i < capacity; i++) {
+        corr->entries[i].loc_a = LOC_EMPTY;
+    }
+
+    // Trailer bits flip the stored CRC directly
+    uint32_t n = 0;
+    for (uint32_t t = 0; t < trailer; t++) {
+        for (uint32_t k = 0; k < 8; k++) {
+            syndromes[n] = 1u << (t * 8 + k);
+            locs[n] = (trailer - 1 - t) * 8 + k;
+            n++;
+        }
+    }
+
+    // A data bit followed by d bits leaves x^(W + d) mod P in the register
+    uint32_t reg = poly;
+    for (uint32_t d = 0; n < bits; d++) {
+        uint32_t bit = ref_in ? 7 - d % 8 : d % 8;
+        uint32_t out = reg;
+        if (ref_out) {
+            out = corr->width == 16 ? reverse_bits_16((uint16_t)reg)
+                                    : reverse_bits_32(reg);
+        }
+        syndromes[n] = out;
+        locs[n] = (trailer + d / 8) * 8 + bit;
+        n++;
+        reg = (reg & top) ? ((reg << 1) ^ poly) & mask : (reg << 1) & mask;
+    }
+
+    // Single-bit errors first: they win over double-bit errors
+    for (uint32_t i = 0; i < bits; i++) {
+        correct_insert(corr, syndromes[i], locs[i], LOC_NONE);
+    }
+    if (corr->double_bit) {
+        for (uint32_t i = 0; i < bits; i++) {
+            for (uint32_t j = i + 1; j < bits; j++) {
+                correct_insert(corr, syndromes[i] ^ syndromes[j], locs[i],
+                               locs[j]);
+            }
+        }
+    }
+
+    free(syndromes);
+    free(locs);
+
+    return true;
+}
+
+/**
+ * \brief           Hash a syndrome to an index slot.
+ *
+ * \param[in]       syndrome: The syndrome
+ * \param[in]       mask: Index capacity - 1
+ * \return          Slot of the syndrome
+ */
+static uint32_t correct_hash(uint32_t syndrome, uint32_t mask) {
+    return (uint32_t)((syndrome * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+/**
+ * \brief           Insert an error pattern into the syndrome index.
+ *
+ * A syndrome shared by two patterns of the same weight is marked ambiguous.
+ *
+ * \param[in,out]   corr: Pointer to the error correction context
+ * \param[in]       syndrome: Syndrome of the pattern
+ * \param[in]       loc_a: First bit location
+ * \param[in]       loc_b: Second bit location, or `LOC_NONE`
+ */
+static void correct_insert(crc_correct_t* corr, uint32_t syndrome,
+                           uint32_t loc_a, uint32_t loc_b) {
+    if (syndrome == 0) {
+        return; // Undetectable pattern
+    }
+
+    uint32_t slot = correct_hash(syndrome, corr->mask);
+    for (;;) {
+        crc_correct_entry_t* entry = &corr->entries[slot];
+
+        if (entry->loc_a == LOC_EMPTY) {
+            entry->syndrome = syndrome;
+            entry->loc_a = loc_a;
+            entry->loc_b = loc_b;
+            return;
+        }
+        if (entry->syndrome == syndrome) {
+            // Keep the lighter pattern, give up on equal weights
+            bool entry_single = entry->loc_a != LOC_AMBIGUOUS
+                                && entry->loc_b == LOC_NONE;
+            if (!(entry_single && loc_b != LOC_NONE)) {
+                entry->loc_a = LOC_AMBIGUOUS;
+            }
+            return;
+        }
+        slot = (slot + 1) & corr->mask;
+    }
+}
+
+/**
+ * \brief           Look a syndrome up in the index.
+ *
+ * \param[in]       corr: Pointer to the error correction context
+ * \param[in]       syndrome: The syndrome
+ * \return          Matching entry, or NULL if the syndrome is unknown
+ */
+static const crc_correct_entry_t* correct_find(const crc_correct_t* corr,
+                                               uint32_t syndrome) {
+    uint32_t slot = correct_hash(syndrome, corr->mask);
+
+    for (;;) {
+        const crc_correct_entry_t* entry = &corr->entries[slot];
+
+        if (entry->loc_a == LOC_EMPTY) {
+            return NULL;
+        }
+        if (entry->syndrome == syndrome) {
+            return entry;
+        }
+        slot = (slot + 1) & corr->mask;
+    }
+}
+
+/**
+ * \brief           Flip a bit given by its location from the frame end.
+ *
+ * \param[in,out]   buf: Pointer to the frame
+ * \param[in]       len: Length of the frame in bytes
+ * \param[in]       loc: Bit location, `byte * 8 + bit` from the frame end
+ */
+static void correct_flip(uint8_t* buf, uint32_t len, uint32_t loc) {
+    buf[len - 1 - loc / 8] ^= (uint8_t)(1u << (loc % 8));
+}
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,138 @@
+/**
+ * \file            crc_cpu.h
+ * \brief           Private CPU feature detection of the CRC library
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_CPU_H__
+#define __CRC_CPU_H__
+
+/*
+ * Unlike crc_port.h, this header needs no atomics, threads or file system
+ * interfaces, so that the core CRC paths can use it on any C11 compiler.
+ */
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+
+/* Private configuration ---------------------------------------------------- */
+/**
+ * \brief           Whether the carry-less multiply (PCLMULQDQ) code paths are
+ *                  built; they only run on CPUs that have the instructions.
+ */
+#ifndef CRC_CFG_USE_CLMUL
+#define CRC_CFG_USE_CLMUL 1
+#endif
+
+/**
+ * \brief           Whether the byte shuffle (PSHUFB) code paths are built;
+ *                  they only run on CPUs that have the instructions.
+ */
+#ifndef CRC_CFG_USE_SSSE3
+#define CRC_CFG_USE_SSSE3 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Public definitions ------------------------------------------------------- */
+/**
+ * \brief           Hint the CPU to fetch the cache line at `addr` for reading.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define CRC_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define CRC_PREFETCH(addr) ((void)(addr))
+#endif
+
+/**
+ * \brief           Whether the x86-64 carry-less multiply paths are compiled,
+ *                  and the attribute enabling their instructions in a
+ *                  function.
+ */
+#if CRC_CFG_USE_CLMUL && defined(__x86_64__) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define CRC_HAVE_CLMUL   1
+#define CRC_TARGET_CLMUL __attribute__((target("pclmul,sse4.1")))
+#else
+#define CRC_HAVE_CLMUL   0
+#define CRC_TARGET_CLMUL
+#endif
+
+/**
+ * \brief           Whether the x86-64 byte shuffle paths are compiled, and
+ *                  the attribute enabling their instructions in a function.
+ */
+#if CRC_CFG_USE_SSSE3 && defined(__x86_64__) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define CRC_HAVE_SSSE3   1
+#define CRC_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define CRC_HAVE_SSSE3   0
+#define CRC_TARGET_SSSE3
+#endif
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Check whether the CPU runs the carry-less multiply paths.
+ *
+ * \return          `true` if `CRC_TARGET_CLMUL` functions can be called
+ */
+static inline bool crc_cpu_has_clmul(void) {
+#if CRC_HAVE_CLMUL
+    return __builtin_cpu_supports("pclmul")
+           && __builtin_cpu_supports("sse4.1");
+#else
+    return false;
+#endif
+}
+
+/**
+ * \brief           Check whether the CPU runs the byte shuffle paths.
+ *
+ * \return          `true` if `CRC_TARGET_SSSE3` functions can be called
+ */
+static inline bool crc_cpu_has_ssse3(void) {
+#if CRC_HAVE_SSSE3
+    return __builtin_cpu_supports("ssse3");
+#else
+    return false;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_CPU_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
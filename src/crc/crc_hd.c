@@ -0,0 +1,404 @@
+/**
+ * \file            crc_hd.c
+ * \brief           Hamming distance analysis of CRC polynomials
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include "crc/crc_hd.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Marks a missing hash table entry.
+ */
+#define HD_NONE UINT32_MAX
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Open-addressing hash table from residues to positions.
+ *
+ * A key of 0 marks an empty slot: x^i mod G is never 0 when G has an x^0
+ * term, and two residues below the period of G never cancel.
+ */
+typedef struct {
+    uint32_t* key; /*!< Residue, or XOR of two residues */
+    uint32_t* val; /*!< Position, or two 16-bit positions `i << 16 | j` */
+    uint32_t bits; /*!< log2 of the number of slots */
+} hd_hash_t;
+
+/**
+ * \brief           Search for the shortest multiple of G of one weight,
+ *                  shared by all workers.
+ *
+ * A multiple is divided down to its x^0 term, so it is `1 + x^t` plus
+ * `weight - 2` terms in between; the search is for the smallest top term
+ * `t`.
+ */
+typedef struct {
+    const uint32_t* res;       /*!< Residues x^i mod G */
+    const hd_hash_t* single;   /*!< Residue to position */
+    const hd_hash_t* pairs;    /*!< Residue pair XOR to positions, or NULL */
+    uint8_t weight;            /*!< Weight searched for */
+    uint32_t bound;            /*!< Top terms to search are below this */
+    atomic_uint next;          /*!< Next top term to be claimed */
+    atomic_uint best;          /*!< Smallest top term found, or `bound` */
+} hd_search_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static bool hd_hash_init(hd_hash_t* hash, uint64_t count);
+static void hd_hash_deinit(hd_hash_t* hash);
+static void hd_hash_put(hd_hash_t* hash, uint32_t key, uint32_t val);
+static uint32_t hd_hash_get(const hd_hash_t* hash, uint32_t key);
+static uint32_t hd_search(hd_search_t* job, uint32_t first, uint32_t threads);
+static void* hd_worker(void* arg);
+static bool hd_test(hd_search_t* job, uint32_t t);
+static bool hd_enum(const hd_search_t* job, uint32_t t, uint32_t v,
+                    uint32_t from, uint32_t left);
+
+/* Public functions --------------------------------------------------------- */
+bool crc_hd_analyze(const crc_hd_cfg_t* cfg, crc_hd_table_t* table) {
+    if (cfg == NULL || table == NULL || cfg->width < 2 || cfg->width > 32
+        || (cfg->width < 32 && (cfg->poly >> cfg->width) != 0)
+        || (cfg->poly & 1) == 0 || cfg->max_len == 0
+        || cfg->max_len > UINT32_MAX - 1 - cfg->width
+        || cfg->weight_max == 1 || cfg->weight_max > CRC_HD_WEIGHT_MAX) {
+        return false;
+    }
+
+    uint8_t width = cfg->width;
+    uint8_t weight_max = cfg->weight_max != 0 ? cfg->weight_max
+                                              : CRC_HD_WEIGHT_DEFAULT;
+    uint32_t len = cfg->max_len + width; // Codeword bits
+    uint32_t mask = (uint32_t)(((uint64_t)1 << width) - 1);
+    uint32_t top[CRC_HD_WEIGHT_MAX + 1];
+    uint32_t* res = malloc((size_t)len * sizeof(*res));
+    hd_hash_t single = {0};
+    hd_hash_t pairs = {0};
+    bool ok = false;
+
+    if (res == NULL) {
+        return false;
+    }
+
+    // Weight 2: x^t + 1 is a multiple of G at the period of G
+    uint32_t bound = len;
+
+    res[0] = 1;
+    for (uint32_t i = 1; i < len; i++) {
+        uint32_t r = res[i - 1];
+
+        res[i] = ((r << 1) ^ ((r >> (width - 1)) & 1 ? cfg->poly : 0)) & mask;
+        if (res[i] == 1 && bound == len) {
+            bound = i;
+        }
+    }
+    top[2] = bound;
+
+    // Below the period the residues are distinct
+    if (!hd_hash_init(&single, bound)) {
+        goto out;
+    }
+    for (uint32_t i = 0; i < bound; i++) {
+        hd_hash_put(&single, res[i], i);
+    }
+
+    // An even number of terms means G has the factor x + 1, whose multiples
+    // all have even weight
+    uint64_t full = ((uint64_t)1 << width) | cfg->poly;
+    bool even = false;
+
+    while (full != 0) {
+        even = !even;
+        full &= full - 1;
+    }
+    even = !even;
+
+    uint32_t threads = cfg->threads != 0 ? cfg->threads : crc_cpu_count();
+
+    threads = threads < CRC_HD_THREADS_MAX ? threads : CRC_HD_THREADS_MAX;
+    for (uint8_t w = 3; w <= weight_max; w++) {
+        hd_search_t job;
+
+        top[w] = bound;
+        if ((even && (w & 1) != 0) || bound <= width) {
+            continue;
+        }
+
+        // Pairs of positions below the bound, inserted by increasing larger
+        // position so that the first pair of each XOR is kept
+        uint64_t npairs = (uint64_t)(bound - 1) * (bound - 2) / 2;
+
+        if (w >= 4 && pairs.key == NULL && npairs <= CRC_HD_PAIRS_MAX
+            && bound <= 0x10000) {
+            if (!hd_hash_init(&pairs, npairs)) {
+                goto out;
+            }
+            for (uint32_t j = 2; j < bound; j++) {
+                for (uint32_t i = 1; i < j; i++) {
+                    hd_hash_put(&pairs, res[i] ^ res[j], i << 16 | j);
+                }
+            }
+        }
+
+        job.res = res;
+        job.single = &single;
+        job.pairs = pairs.key != NULL ? &pairs : NULL;
+        job.weight = w;
+        job.bound = bound;
+        top[w] = hd_search(&job, width, threads);
+        bound = top[w] < bound ? top[w] : bound;
+    }
+
+    // The HD is at least d up to the first multiple of weight below d
+    uint32_t first = len;
+
+    table->max_len = cfg->max_len;
+    table->weight_max = weight_max;
+    table->len[2] = cfg->max_len;
+    for (uint8_t d = 3; d <= weight_max + 1; d++) {
+        first = top[d - 1] < first ? top[d - 1] : first;
+        table->len[d] = first - width;
+    }
+    ok = true;
+
+out:
+    hd_hash_deinit(&pairs);
+    hd_hash_deinit(&single);
+    free(res);
+
+    return ok;
+}
+
+uint8_t crc_hd_at(const crc_hd_table_t* table, uint32_t len) {
+    uint8_t d = 2;
+
+    while (d <= table->weight_max && table->len[d + 1] >= len) {
+        d++;
+    }
+
+    return d;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Allocate an empty hash table.
+ *
+ * \param[out]      hash: Pointer to the hash table
+ * \param[in]       count: Number of entries to hold
+ * \return          `true` on success, `false` on allocation errors
+ */
+static bool hd_hash_init(hd_hash_t* hash, uint64_t count) {
+    hash->bits = 4;
+    while (((uint64_t)1 << hash->bits) < 2 * count) {
+        hash->bits++;
+    }
+    if (hash->bits > 31) {
+        return false;
+    }
+    hash->key = calloc((size_t)1 << hash->bits, sizeof(*hash->key));
+    hash->val = malloc(((size_t)1 << hash->bits) * sizeof(*hash->val));
+    if (hash->key == NULL || hash->val == NULL) {
+        hd_hash_deinit(hash);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief           Release a hash table.
+ *
+ * \param[in,out]   hash: Pointer to the hash table
+ */
+static void hd_hash_deinit(hd_hash_t* hash) {
+    free(hash->key);
+    free(hash->val);
+    hash->key = NULL;
+    hash->val = NULL;
+}
+
+/**
+ * \brief           Insert a key unless it is already present.
+ *
+ * \param[in,out]   hash: Pointer to the hash table
+ * \param[in]       key: Non-zero key
+ * \param[in]       val: Value
+ */
+static void hd_hash_put(hd_hash_t* hash, uint32_t key, uint32_t val) {
+    uint32_t mask = (uint32_t)(((uint64_t)1 << hash->bits) - 1);
+    uint32_t slot = (key * 0x9E3779B1u) >> (32 - hash->bits);
+
+    while (hash->key[slot] != 0) {
+        if (hash->key[slot] == key) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    hash->key[slot] = key;
+    hash->val[slot] = val;
+}
+
+/**
+ * \brief           Look up a key.
+ *
+ * \param[in]       hash: Pointer to the hash table
+ * \param[in]       key: Key
+ * \return          The value, or `HD_NONE` if the key is missing
+ */
+static uint32_t hd_hash_get(const hd_hash_t* hash, uint32_t key) {
+    uint32_t mask = (uint32_t)(((uint64_t)1 << hash->bits) - 1);
+    uint32_t slot = (key * 0x9E3779B1u) >> (32 - hash->bits);
+
+    while (hash->key[slot] != 0) {
+        if (hash->key[slot] == key) {
+            return hash->val[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return HD_NONE;
+}
+
+/**
+ * \brief           Find the smallest top term of a multiple of G of the
+ *                  job's weight.
+ *
+ * \param[in,out]   job: Pointer to the search, `next` and `best` are set here
+ * \param[in]       first: Smallest possible top term, the degree of G
+ * \param[in]       threads: Number of workers
+ * \return          The smallest top term, or `bound` if there is none
+ */
+static uint32_t hd_search(hd_search_t* job, uint32_t first, uint32_t threads) {
+    atomic_init(&job->next, first);
+    atomic_init(&job->best, job->bound);
+    threads = threads < job->bound - first ? threads : job->bound - first;
+    crc_parallel_run(hd_worker, job, 0, threads);
+
+    return atomic_load(&job->best);
+}
+
+/**
+ * \brief           Search worker: test top terms in increasing order until
+ *                  a multiple is found at a smaller one.
+ *
+ * \param[in]       arg: Pointer to the `hd_search_t` job
+ * \return          NULL
+ */
+static void* hd_worker(void* arg) {
+    hd_search_t* job = arg;
+
+    for (;;) {
+        uint32_t t = atomic_fetch_add(&job->next, 1);
+        uint32_t best = atomic_load(&job->best);
+
+        if (t >= best) {
+            break;
+        }
+        if (!hd_test(job, t)) {
+            continue;
+        }
+        while (t < best
+               && !atomic_compare_exchange_weak(&job->best, &best, t)) {
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           Test for a multiple of G with top term `t`.
+ *
+ * The terms below `t` must XOR to `1 ^ x^t mod G`. All but the last one or
+ * two are enumerated and the rest is looked up. A lookup never returns a
+ * term already used: the two would cancel into a multiple of lower weight
+ * below the bound, which the bound rules out.
+ *
+ * \param[in,out]   job: Pointer to the search
+ * \param[in]       t: Top term
+ * \return          `true` if a multiple was found
+ */
+static bool hd_test(hd_search_t* job, uint32_t t) {
+    uint32_t v = 1 ^ job->res[t];
+    uint32_t left = job->weight - 2; // Terms between x^0 and x^t
+
+    left -= job->pairs != NULL && left >= 2 ? 2 : 1;
+    if (left == 0) {
+        return hd_enum(job, t, v, 1, 0);
+    }
+
+    // Give up on this top term as soon as a smaller one is found
+    for (uint32_t a = 1; a < t; a++) {
+        if (atomic_load_explicit(&job->best, memory_order_relaxed) < t) {
+            return false;
+        }
+        if (hd_enum(job, t, v ^ job->res[a], a + 1, left - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * \brief           Enumerate the remaining terms and look up the last ones.
+ *
+ * \param[in]       job: Pointer to the search
+ * \param[in]       t: Top term
+ * \param[in]       v: XOR still to be matched
+ * \param[in]       from: Smallest term to enumerate
+ * \param[in]       left: Number of terms still to enumerate
+ * \return          `true` if a multiple was found
+ */
+static bool hd_enum(const hd_search_t* job, uint32_t t, uint32_t v,
+                    uint32_t from, uint32_t left) {
+    if (left == 0) {
+        if (job->pairs != NULL && job->weight >= 4) {
+            uint32_t pos = hd_hash_get(job->pairs, v);
+
+            return pos != HD_NONE && (pos & 0xFFFF) < t;
+        }
+        uint32_t pos = hd_hash_get(job->single, v);
+
+        return pos != HD_NONE && pos > 0 && pos < t;
+    }
+    for (uint32_t a = from; a < t; a++) {
+        if (hd_enum(job, t, v ^ job->res[a], a + 1, left - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ----------------------------- end of file -------------------------------- */
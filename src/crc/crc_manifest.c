@@ -0,0 +1,747 @@
+/**
+ * \file            crc_manifest.c
+ * \brief           Directory-tree checksum manifest with a persistent
+ *                  mtime/size cache
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc_manifest.h"
+#include "crc_batch.h"
+
+#if !defined(_WIN32)
+#include <dirent.h>
+#endif
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Magic number of the cache file, "CRCM".
+ */
+#define CACHE_MAGIC       0x4D435243u
+
+/**
+ * \brief           Size of the cache file header in bytes.
+ */
+#define CACHE_HEAD_SIZE   16
+
+/**
+ * \brief           Size of a cache file record in bytes.
+ */
+#define CACHE_RECORD_SIZE 28
+
+/**
+ * \brief           Number of bytes read from a file at a time.
+ */
+#define READ_CHUNK_BYTES  (256 * 1024)
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Cached checksum of a file version.
+ */
+typedef struct {
+    uint64_t inode;   /*!< File serial number */
+    uint64_t size;    /*!< File size in bytes */
+    int64_t mtime_ns; /*!< Modification time in nanoseconds */
+    uint32_t crc;     /*!< Checksum of the file content */
+    bool used;        /*!< Whether the slot is used */
+} cache_entry_t;
+
+/**
+ * \brief           Job of a walk worker: scan a directory or read a file.
+ */
+typedef struct {
+    char* rel;            /*!< Path relative to the root */
+    crc_file_info_t info; /*!< Attributes of a file */
+    bool dir;             /*!< Whether the path is a directory to be scanned */
+} walk_job_t;
+
+/**
+ * \brief           Walk shared by all workers.
+ */
+typedef struct {
+    const char* root;         /*!< Root directory of the tree */
+    crc_batch_engine_t eng;   /*!< Table engine of the model */
+    cache_entry_t* cache;     /*!< Cache hash table, NULL if empty */
+    uint64_t cache_mask;      /*!< Cache capacity - 1 */
+    crc_mutex_t lock;         /*!< Protects the fields below */
+    crc_cond_t cond;          /*!< Signals queued or finished jobs */
+    walk_job_t* queue;        /*!< Directories and files to be processed */
+    uint64_t queued;          /*!< Number of jobs in `queue` */
+    uint64_t queue_cap;       /*!< Capacity of `queue` */
+    uint64_t pending;         /*!< Jobs queued or being processed */
+    bool failed;              /*!< Set on allocation errors */
+} walk_t;
+
+/**
+ * \brief           Per-worker state.
+ */
+typedef struct {
+    walk_t* walk;                  /*!< Shared walk */
+    crc_manifest_entry_t* entries; /*!< Entries found by this worker */
+    uint64_t count;                /*!< Number of entries */
+    uint64_t cap;                  /*!< Capacity of `entries` */
+    uint64_t hashed;               /*!< Files read and hashed */
+    uint64_t cached;               /*!< Files served from the cache */
+    uint64_t errors;               /*!< Files or directories not readable */
+    uint8_t* buf;                  /*!< Read buffer */
+} walk_worker_t;
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           CRC16 model names, indexed by model.
+ */
+static const char* const crc16_model_name[CRC16_NONE_MODEL] = {
+    "CRC16_IBM",    "CRC16_MAXIM",  "CRC16_USB",
+    "CRC16_MODBUS", "CRC16_CCITT",  "CRC16_CCITT_FALSE",
+    "CRC16_X25",    "CRC16_XMODEM", "CRC16_DNP",
+};
+
+/**
+ * \brief           CRC32 model names, indexed by model.
+ */
+static const char* const crc32_model_name[CRC32_NONE_MODEL] = {
+    "CRC32",
+    "CRC32_MPEG2",
+};
+
+/* Private function prototypes ---------------------------------------------- */
+#if !defined(_WIN32)
+static uint64_t cache_hash(uint64_t inode, uint64_t size, int64_t mtime_ns);
+static void cache_load(walk_t* walk, const crc_manifest_cfg_t* cfg);
+static bool cache_save(const crc_manifest_t* mf, const char* path);
+static void* walk_worker(void* arg);
+static void walk_dir(walk_worker_t* worker, const char* rel);
+static bool walk_push(walk_t* walk, char* rel, const crc_file_info_t* info);
+static bool walk_file(walk_worker_t* worker, char* rel,
+                      const crc_file_info_t* info);
+static bool cache_find(const walk_t* walk, const crc_file_info_t* info,
+                       uint32_t* crc);
+static char* path_join(const char* dir, const char* name);
+static int entry_cmp(const void* a, const void* b);
+#endif
+
+/* Public functions --------------------------------------------------------- */
+bool crc_manifest_build(crc_manifest_t* mf, const char* root,
+                        const crc_manifest_cfg_t* cfg) {
+    memset(mf, 0, sizeof(*mf));
+    if (root == NULL || cfg == NULL
+        || crc_manifest_model_name(cfg->width, cfg->model) == NULL) {
+        return false;
+    }
+
+#if defined(_WIN32)
+    return false; // No directory walk, see crc_manifest.h
+#else
+    crc_batch_model_t batch;
+    walk_worker_t workers[CRC_MANIFEST_THREADS_MAX];
+    walk_t walk;
+    uint32_t threads;
+    bool ok;
+
+    if (cfg->width == 16) {
+        crc16_batch_model(&batch, (crc16_param_model_e)cfg->model);
+    } else {
+        crc32_batch_model(&batch, (crc32_param_model_e)cfg->model);
+    }
+
+    memset(&walk, 0, sizeof(walk));
+    walk.root = root;
+    crc_batch_engine_init(&walk.eng, &batch);
+    crc_mutex_init(&walk.lock);
+    crc_cond_init(&walk.cond);
+    cache_load(&walk, cfg);
+
+    char* top = calloc(1, 1); // The root, relative to itself
+    ok = top != NULL && walk_push(&walk, top, NULL);
+
+    threads = cfg->threads != 0 ? cfg->threads : crc_cpu_count();
+    threads = threads < CRC_MANIFEST_THREADS_MAX ? threads
+                                                 : CRC_MANIFEST_THREADS_MAX;
+    memset(workers, 0, threads * sizeof(workers[0]));
+    for (uint32_t i = 0; ok && i < threads; i++) {
+        workers[i].walk = &walk;
+        workers[i].buf = malloc(READ_CHUNK_BYTES);
+        ok = workers[i].buf != NULL;
+    }
+
+    if (ok) {
+        crc_parallel_run(walk_worker, workers, sizeof(workers[0]), threads);
+    }
+    ok = ok && !walk.failed;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        mf->count += workers[i].count;
+        mf->hashed += workers[i].hashed;
+        mf->cached += workers[i].cached;
+        mf->errors += workers[i].errors;
+    }
+    if (ok && mf->count != 0) {
+        mf->entries = malloc(mf->count * sizeof(mf->entries[0]));
+        ok = mf->entries != NULL;
+    }
+    mf->width = cfg->width;
+    mf->model = cfg->model;
+
+    // Hand the entries over to the manifest, or release them on failure
+    uint64_t at = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        for (uint64_t k = 0; k < workers[i].count; k++) {
+            if (ok) {
+                mf->entries[at++] = workers[i].entries[k];
+            } else {
+                free(workers[i].entries[k].path);
+            }
+        }
+        free(workers[i].entries);
+        free(workers[i].buf);
+    }
+    mf->count = at;
+
+    if (ok) {
+        qsort(mf->entries, mf->count, sizeof(mf->entries[0]), entry_cmp);
+    }
+    if (ok && cfg->cache_path != NULL) {
+        ok = cache_save(mf, cfg->cache_path);
+    }
+
+    for (uint64_t i = 0; i < walk.queued; i++) {
+        free(walk.queue[i].rel);
+    }
+    free(walk.queue);
+    free(walk.cache);
+    crc_cond_deinit(&walk.cond);
+    crc_mutex_deinit(&walk.lock);
+    if (!ok) {
+        crc_manifest_deinit(mf);
+    }
+
+    return ok;
+#endif
+}
+
+bool crc_manifest_write(const crc_manifest_t* mf, const char* path) {
+    const char* name = crc_manifest_model_name(mf->width, mf->model);
+    int digits = mf->width / 4;
+
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL) {
+        return false;
+    }
+
+    bool ok = name != NULL;
+    for (uint64_t i = 0; ok && i < mf->count; i++) {
+        const char* p = mf->entries[i].path;
+
+        if (strpbrk(p, "\\\n") != NULL) {
+            ok = fputc('\\', fp) != EOF;
+        }
+        ok = ok
+             && fprintf(fp, "%s %0*lX  ", name, digits,
+                        (unsigned long)mf->entries[i].crc)
+                    > 0;
+        for (; ok && *p != '\0'; p++) {
+            if (*p == '\\') {
+                ok = fputs("\\\\", fp) != EOF;
+            } else if (*p == '\n') {
+                ok = fputs("\\n", fp) != EOF;
+            } else {
+                ok = fputc(*p, fp) != EOF;
+            }
+        }
+        ok = ok && fputc('\n', fp) != EOF;
+    }
+
+    return (fclose(fp) == 0) && ok;
+}
+
+const char* crc_manifest_model_name(uint8_t width, uint8_t model) {
+    if (width == 16 && model < CRC16_NONE_MODEL) {
+        return crc16_model_name[model];
+    }
+    if (width == 32 && model < CRC32_NONE_MODEL) {
+        return crc32_model_name[model];
+    }
+
+    return NULL;
+}
+
+void crc_manifest_deinit(crc_manifest_t* mf) {
+    for (uint64_t i = 0; i < mf->count; i++) {
+        free(mf->entries[i].path);
+    }
+    free(mf->entries);
+    mf->entries = NULL;
+    mf->count = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+#if !defined(_WIN32)
+/**
+ * \brief           Hash the key of a cache entry (splitmix64 finalizer).
+ *
+ * \param[in]       inode: File serial number
+ * \param[in]       size: File size in bytes
+ * \param[in]       mtime_ns: Modification time in nanoseconds
+ * \return          64-bit hash value
+ */
+static uint64_t cache_hash(uint64_t inode, uint64_t size, int64_t mtime_ns) {
+    uint64_t h = inode * 0x9E3779B97F4A7C15u ^ size ^ (uint64_t)mtime_ns;
+
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9u;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBu;
+
+    return h ^ (h >> 31);
+}
+
+/**
+ * \brief           Load the cache file into the cache hash table.
+ *
+ * A missing, corrupt or foreign cache file is ignored, as is a cache too
+ * large for memory: every file is then hashed.
+ *
+ * \param[in,out]   walk: Pointer to the walk
+ * \param[in]       cfg: Pointer to the manifest configuration
+ */
+static void cache_load(walk_t* walk, const crc_manifest_cfg_t* cfg) {
+    uint8_t head[CACHE_HEAD_SIZE];
+    uint8_t rec[CACHE_RECORD_SIZE];
+    crc32_ctx_t ctx;
+
+    FILE* fp = cfg->cache_path != NULL ? fopen(cfg->cache_path, "rb") : NULL;
+    if (fp == NULL) {
+        return;
+    }
+
+    uint64_t count = 0;
+    crc_file_info_t info;
+    bool valid = crc_file_info(cfg->cache_path, &info)
+                 && info.size >= CACHE_HEAD_SIZE + 4
+                 && fread(head, 1, CACHE_HEAD_SIZE, fp) == CACHE_HEAD_SIZE
+                 && crc_get_le(head + 0, 4) == CACHE_MAGIC
+                 && crc_get_le(head + 4, 2) == CRC_MANIFEST_CACHE_VERSION
+                 && head[6] == cfg->width && head[7] == cfg->model;
+
+    if (valid) {
+        uint64_t cap = 16;
+
+        // Trust no count the file cannot hold
+        count = crc_get_le(head + 8, 8);
+        valid = count <= (info.size - CACHE_HEAD_SIZE - 4) / CACHE_RECORD_SIZE;
+        while (valid && count > cap / 2 && cap < ((uint64_t)1 << 40)) {
+            cap <<= 1;
+        }
+        valid = valid && count <= cap / 2;
+        walk->cache = valid ? calloc(cap, sizeof(walk->cache[0])) : NULL;
+        valid = walk->cache != NULL;
+        walk->cache_mask = cap - 1;
+    }
+
+    crc32_init(&ctx, CRC32_MODEL);
+    crc32_update(&ctx, head, CACHE_HEAD_SIZE);
+    for (uint64_t i = 0; valid && i < count; i++) {
+        valid = fread(rec, 1, CACHE_RECORD_SIZE, fp) == CACHE_RECORD_SIZE;
+        crc32_update(&ctx, rec, CACHE_RECORD_SIZE);
+
+        cache_entry_t e = {
+            .inode = crc_get_le(rec + 0, 8),
+            .size = crc_get_le(rec + 8, 8),
+            .mtime_ns = (int64_t)crc_get_le(rec + 16, 8),
+            .crc = (uint32_t)crc_get_le(rec + 24, 4),
+            .used = true,
+        };
+        uint64_t slot = cache_hash(e.inode, e.size, e.mtime_ns);
+        while (walk->cache[slot & walk->cache_mask].used) {
+            slot++;
+        }
+        walk->cache[slot & walk->cache_mask] = e;
+    }
+    valid = valid && fread(rec, 1, 5, fp) == 4
+            && (uint32_t)crc_get_le(rec, 4) == crc32_final(&ctx);
+    fclose(fp);
+
+    if (!valid) {
+        free(walk->cache);
+        walk->cache = NULL;
+    }
+}
+
+/**
+ * \brief           Write the entries of a manifest to the cache file.
+ *
+ * The cache is written to a temporary file, flushed to disk and moved over
+ * the old one, so an interrupted run leaves the previous cache intact.
+ *
+ * \param[in]       mf: Pointer to the manifest
+ * \param[in]       path: Path of the cache file
+ * \return          `true` on success, `false` on I/O or allocation errors
+ */
+static bool cache_save(const crc_manifest_t* mf, const char* path) {
+    uint8_t head[CACHE_HEAD_SIZE];
+    uint8_t rec[CACHE_RECORD_SIZE];
+    crc32_ctx_t ctx;
+    size_t len = strlen(path);
+    char* tmp = malloc(len + 5);
+
+    if (tmp == NULL) {
+        return false;
+    }
+    memcpy(tmp, path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE* fp = fopen(tmp, "wb");
+    if (fp == NULL) {
+        free(tmp);
+        return false;
+    }
+
+    crc_put_le(head + 0, CACHE_MAGIC, 4);
+    crc_put_le(head + 4, CRC_MANIFEST_CACHE_VERSION, 2);
+    head[6] = mf->width;
+    head[7] = mf->model;
+    crc_put_le(head + 8, mf->count, 8);
+    crc32_init(&ctx, CRC32_MODEL);
+    crc32_update(&ctx, head, CACHE_HEAD_SIZE);
+    bool ok = fwrite(head, 1, CACHE_HEAD_SIZE, fp) == CACHE_HEAD_SIZE;
+
+    for (uint64_t i = 0; ok && i < mf->count; i++) {
+        const crc_manifest_entry_t* e = &mf->entries[i];
+
+        crc_put_le(rec + 0, e->inode, 8);
+        crc_put_le(rec + 8, e->size, 8);
+        crc_put_le(rec + 16, (uint64_t)e->mtime_ns, 8);
+        crc_put_le(rec + 24, e->crc, 4);
+        crc32_update(&ctx, rec, CACHE_RECORD_SIZE);
+        ok = fwrite(rec, 1, CACHE_RECORD_SIZE, fp) == CACHE_RECORD_SIZE;
+    }
+    crc_put_le(rec, crc32_final(&ctx), 4);
+    ok = ok && fwrite(rec, 1, 4, fp) == 4 && crc_file_sync(fp);
+    ok = (fclose(fp) == 0) && ok && crc_file_replace(tmp, path);
+    if (!ok) {
+        remove(tmp);
+    }
+    free(tmp);
+
+    return ok;
+}
+
+/**
+ * \brief           Run queued jobs until the whole tree is done.
+ *
+ * Files are queued one by one, so that the files of a single large directory
+ * are read by all workers rather than by the one scanning it.
+ *
+ * \param[in,out]   arg: Pointer to the worker state
+ * \return          NULL
+ */
+static void* walk_worker(void* arg) {
+    walk_worker_t* worker = arg;
+    walk_t* walk = worker->walk;
+
+    for (;;) {
+        crc_mutex_lock(&walk->lock);
+        while (walk->queued == 0 && walk->pending != 0 && !walk->failed) {
+            crc_cond_wait(&walk->cond, &walk->lock);
+        }
+        if (walk->queued == 0 || walk->failed) {
+            crc_mutex_unlock(&walk->lock);
+            break;
+        }
+        walk_job_t job = walk->queue[--walk->queued];
+        crc_mutex_unlock(&walk->lock);
+
+        bool ok = true;
+        if (job.dir) {
+            walk_dir(worker, job.rel);
+            free(job.rel);
+        } else {
+            ok = walk_file(worker, job.rel, &job.info);
+        }
+
+        crc_mutex_lock(&walk->lock);
+        walk->failed = walk->failed || !ok;
+        if (--walk->pending == 0 || !ok) {
+            crc_cond_broadcast(&walk->cond); // The tree is done or failed
+        }
+        crc_mutex_unlock(&walk->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           Scan one directory: queue subdirectories and the files to
+ *                  be read, add cached files.
+ *
+ * \param[in,out]   worker: Pointer to the worker state
+ * \param[in]       rel: Directory path relative to the root
+ */
+static void walk_dir(walk_worker_t* worker, const char* rel) {
+    walk_t* walk = worker->walk;
+    char* dir = rel[0] != '\0' ? path_join(walk->root, rel) : NULL;
+    DIR* dp = opendir(rel[0] != '\0' ? dir : walk->root);
+    struct dirent* de;
+    bool ok = rel[0] == '\0' || dir != NULL;
+
+    if (dp == NULL) {
+        worker->errors++;
+    }
+
+    while (ok && dp != NULL && (de = readdir(dp)) != NULL) {
+        struct stat st;
+
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0) {
+            continue;
+        }
+
+        char* child = rel[0] != '\0' ? path_join(rel, de->d_name)
+                                     : path_join("", de->d_name);
+        char* full = child != NULL ? path_join(walk->root, child) : NULL;
+
+        ok = full != NULL;
+        if (ok && lstat(full, &st) != 0) {
+            worker->errors++;
+        } else if (ok && S_ISDIR(st.st_mode)) {
+            ok = walk_push(walk, child, NULL);
+            child = NULL;
+        } else if (ok && S_ISREG(st.st_mode)) {
+            crc_file_info_t info = {
+                .size = (uint64_t)st.st_size,
+                .mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000
+                            + st.st_mtim.tv_nsec,
+                .inode = (uint64_t)st.st_ino,
+            };
+
+            // Cached files take no reading: only the others are shared out
+            ok = cache_find(walk, &info, NULL) ? walk_file(worker, child, &info)
+                                               : walk_push(walk, child, &info);
+            child = NULL;
+        }
+        free(child);
+        free(full);
+    }
+
+    if (dp != NULL) {
+        closedir(dp);
+    }
+    free(dir);
+
+    if (!ok) {
+        crc_mutex_lock(&walk->lock);
+        walk->failed = true;
+        crc_cond_broadcast(&walk->cond);
+        crc_mutex_unlock(&walk->lock);
+    }
+}
+
+/**
+ * \brief           Queue a directory to be scanned or a file to be read.
+ *
+ * \param[in,out]   walk: Pointer to the walk
+ * \param[in]       rel: Path relative to the root, owned by the queue on
+ *                  success and freed on failure
+ * \param[in]       info: Attributes of the file, NULL for a directory
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool walk_push(walk_t* walk, char* rel, const crc_file_info_t* info) {
+    walk_job_t job = {.rel = rel, .dir = info == NULL};
+    bool ok = true;
+
+    crc_mutex_lock(&walk->lock);
+    if (walk->queued == walk->queue_cap) {
+        uint64_t cap = walk->queue_cap != 0 ? walk->queue_cap * 2 : 64;
+        walk_job_t* queue = realloc(walk->queue, cap * sizeof(queue[0]));
+
+        ok = queue != NULL;
+        if (ok) {
+            walk->queue = queue;
+            walk->queue_cap = cap;
+        }
+    }
+    if (ok) {
+        if (info != NULL) {
+            job.info = *info;
+        }
+        walk->queue[walk->queued++] = job;
+        walk->pending++;
+        crc_cond_broadcast(&walk->cond);
+    } else {
+        free(rel);
+    }
+    crc_mutex_unlock(&walk->lock);
+
+    return ok;
+}
+
+/**
+ * \brief           Add a regular file to the worker's entries.
+ *
+ * The checksum is taken from the cache if the file's inode, size and
+ * modification time match, otherwise the file is read.
+ *
+ * \param[in,out]   worker: Pointer to the worker state
+ * \param[in]       rel: Path relative to the root, owned by the entry on
+ *                  success and freed on failure
+ * \param[in]       info: Attributes of the file
+ * \return          `true` on success, `false` if out of memory
+ */
+static bool walk_file(walk_worker_t* worker, char* rel,
+                      const crc_file_info_t* info) {
+    walk_t* walk = worker->walk;
+    crc_manifest_entry_t entry = {
+        .path = rel,
+        .size = info->size,
+        .mtime_ns = info->mtime_ns,
+        .inode = info->inode,
+    };
+
+    if (cache_find(walk, info, &entry.crc)) {
+        worker->cached++;
+    } else {
+        char* full = path_join(walk->root, rel);
+        FILE* fp = full != NULL ? fopen(full, "rb") : NULL;
+        uint32_t reg = walk->eng.init;
+        size_t n;
+
+        free(full);
+        if (full == NULL) {
+            free(rel);
+            return false;
+        }
+        if (fp == NULL) {
+            worker->errors++;
+            free(rel);
+            return true;
+        }
+        while ((n = fread(worker->buf, 1, READ_CHUNK_BYTES, fp)) != 0) {
+            reg = crc_batch_update(&walk->eng, reg, worker->buf, (uint32_t)n);
+        }
+        bool error = ferror(fp) != 0;
+        fclose(fp);
+        if (error) {
+            worker->errors++;
+            free(rel);
+            return true;
+        }
+        entry.crc = crc_batch_final(&walk->eng, reg);
+        worker->hashed++;
+    }
+
+    if (worker->count == worker->cap) {
+        uint64_t cap = worker->cap != 0 ? worker->cap * 2 : 256;
+        crc_manifest_entry_t* entries = realloc(
+            worker->entries, cap * sizeof(entries[0]));
+
+        if (entries == NULL) {
+            free(rel);
+            return false;
+        }
+        worker->entries = entries;
+        worker->cap = cap;
+    }
+    worker->entries[worker->count++] = entry;
+
+    return true;
+}
+
+/**
+ * \brief           Look a file version up in the cache.
+ *
+ * \param[in]       walk: Pointer to the walk
+ * \param[in]       info: Attributes of the file
+ * \param[out]      crc: Cached checksum, may be NULL
+ * \return          `true` if the file's inode, size and modification time
+ *                  are cached
+ */
+static bool cache_find(const walk_t* walk, const crc_file_info_t* info,
+                       uint32_t* crc) {
+    uint64_t slot = cache_hash(info->inode, info->size, info->mtime_ns);
+    const cache_entry_t* e;
+
+    if (walk->cache == NULL) {
+        return false;
+    }
+    while ((e = &walk->cache[slot++ & walk->cache_mask])->used) {
+        if (e->inode == info->inode && e->size == info->size
+            && e->mtime_ns == info->mtime_ns) {
+            if (crc != NULL) {
+                *crc = e->crc;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * \brief           Join two path components with a '/'.
+ *
+ * \param[in]       dir: Leading component, may be empty
+ * \param[in]       name: Trailing component
+ * \return          Newly allocated path, or NULL if out of memory
+ */
+static char* path_join(const char* dir, const char* name) {
+    size_t dir_len = strlen(dir);
+    size_t name_len = strlen(name);
+    char* path = malloc(dir_len + name_len + 2);
+
+    if (path == NULL) {
+        return NULL;
+    }
+    memcpy(path, dir, dir_len);
+    if (dir_len != 0) {
+        path[dir_len++] = '/';
+    }
+    memcpy(path + dir_len, name, name_len + 1);
+
+    return path;
+}
+
+/**
+ * \brief           Compare two manifest entries by path for `qsort`.
+ *
+ * \param[in]       a: Pointer to the first entry
+ * \param[in]       b: Pointer to the second entry
+ * \return          Negative, zero or positive as `a` sorts before, equal to
+ *                  or after `b`
+ */
+static int entry_cmp(const void* a, const void* b) {
+    return strcmp(((const crc_manifest_entry_t*)a)->path,
+                  ((const crc_manifest_entry_t*)b)->path);
+}
+#endif
+
+/* ----------------------------- end of file -------------------------------- */
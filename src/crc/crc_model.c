@@ -0,0 +1,233 @@
+/**
+ * \file            crc_model.c
+ * \brief           Generic CRC model descriptor and model catalogue
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
+#include "crc/crc_model.h"
+#include "crc_batch.h"
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           Built-in catalogue, sorted by width then name.
+ */
+static const crc_model_t catalog[] = {
+    {"CRC-8/AUTOSAR", 8, CRC_MODEL_NONE, 0x2F, 0xFF, 0xFF, false, false, 0xDF},
+    {"CRC-8/BLUETOOTH", 8, CRC_MODEL_NONE, 0xA7, 0x00, 0x00, true, true, 0x26},
+    {"CRC-8/CDMA2000", 8, CRC_MODEL_NONE, 0x9B, 0xFF, 0x00, false, false, 0xDA},
+    {"CRC-8/DARC", 8, CRC_MODEL_NONE, 0x39, 0x00, 0x00, true, true, 0x15},
+    {"CRC-8/DVB-S2", 8, CRC_MODEL_NONE, 0xD5, 0x00, 0x00, false, false, 0xBC},
+    {"CRC-8/GSM-A", 8, CRC_MODEL_NONE, 0x1D, 0x00, 0x00, false, false, 0x37},
+    {"CRC-8/GSM-B", 8, CRC_MODEL_NONE, 0x49, 0x00, 0xFF, false, false, 0x94},
+    {"CRC-8/HITAG", 8, CRC_MODEL_NONE, 0x1D, 0xFF, 0x00, false, false, 0xB4},
+    {"CRC-8/I-432-1", 8, CRC8_ITU_MODEL, 0x07, 0x00, 0x55, false, false, 0xA1},
+    {"CRC-8/I-CODE", 8, CRC_MODEL_NONE, 0x1D, 0xFD, 0x00, false, false, 0x7E},
+    {"CRC-8/LTE", 8, CRC_MODEL_NONE, 0x9B, 0x00, 0x00, false, false, 0xEA},
+    {"CRC-8/MAXIM-DOW", 8, CRC8_MAXIM_MODEL, 0x31, 0x00, 0x00, true, true,
+     0xA1},
+    {"CRC-8/MIFARE-MAD", 8, CRC_MODEL_NONE, 0x1D, 0xC7, 0x00, false, false,
+     0x99},
+    {"CRC-8/NRSC-5", 8, CRC_MODEL_NONE, 0x31, 0xFF, 0x00, false, false, 0xF7},
+    {"CRC-8/OPENSAFETY", 8, CRC_MODEL_NONE, 0x2F, 0x00, 0x00, false, false,
+     0x3E},
+    {"CRC-8/ROHC", 8, CRC8_ROHC_MODEL, 0x07, 0xFF, 0x00, true, true, 0xD0},
+    {"CRC-8/SAE-J1850", 8, CRC_MODEL_NONE, 0x1D, 0xFF, 0xFF, false, false,
+     0x4B},
+    {"CRC-8/SMBUS", 8, CRC8_MODEL, 0x07, 0x00, 0x00, false, false, 0xF4},
+    {"CRC-8/TECH-3250", 8, CRC_MODEL_NONE, 0x1D, 0xFF, 0x00, true, true, 0x97},
+    {"CRC-8/WCDMA", 8, CRC_MODEL_NONE, 0x9B, 0x00, 0x00, true, true, 0x25},
+    {"CRC-16/ARC", 16, CRC16_IBM_MODEL, 0x8005, 0x0000, 0x0000, true, true,
+     0xBB3D},
+    {"CRC-16/CDMA2000", 16, CRC_MODEL_NONE, 0xC867, 0xFFFF, 0x0000, false,
+     false, 0x4C06},
+    {"CRC-16/CMS", 16, CRC_MODEL_NONE, 0x8005, 0xFFFF, 0x0000, false, false,
+     0xAEE7},
+    {"CRC-16/DDS-110", 16, CRC_MODEL_NONE, 0x8005, 0x800D, 0x0000, false, false,
+     0x9ECF},
+    {"CRC-16/DECT-R", 16, CRC_MODEL_NONE, 0x0589, 0x0000, 0x0001, false, false,
+     0x007E},
+    {"CRC-16/DECT-X", 16, CRC_MODEL_NONE, 0x0589, 0x0000, 0x0000, false, false,
+     0x007F},
+    {"CRC-16/DNP", 16, CRC16_DNP_MODEL, 0x3D65, 0x0000, 0xFFFF, true, true,
+     0xEA82},
+    {"CRC-16/EN-13757", 16, CRC_MODEL_NONE, 0x3D65, 0x0000, 0xFFFF, false,
+     false, 0xC2B7},
+    {"CRC-16/GENIBUS", 16, CRC_MODEL_NONE, 0x1021, 0xFFFF, 0xFFFF, false, false,
+     0xD64E},
+    {"CRC-16/GSM", 16, CRC_MODEL_NONE, 0x1021, 0x0000, 0xFFFF, false, false,
+     0xCE3C},
+    {"CRC-16/IBM-3740", 16, CRC16_CCITT_FALSE_MODEL, 0x1021, 0xFFFF, 0x0000,
+     false, false, 0x29B1},
+    {"CRC-16/IBM-SDLC", 16, CRC16_X25_MODEL, 0x1021, 0xFFFF, 0xFFFF, true, true,
+     0x906E},
+    {"CRC-16/ISO-IEC-14443-3-A", 16, CRC_MODEL_NONE, 0x1021, 0xC6C6, 0x0000,
+     true, true, 0xBF05},
+    {"CRC-16/KERMIT", 16, CRC16_CCITT_MODEL, 0x1021, 0x0000, 0x0000, true, true,
+     0x2189},
+    {"CRC-16/LJ1200", 16, CRC_MODEL_NONE, 0x6F63, 0x0000, 0x0000, false, false,
+     0xBDF4},
+    {"CRC-16/M17", 16, CRC_MODEL_NONE, 0x5935, 0xFFFF, 0x0000, false, false,
+     0x772B},
+    {"CRC-16/MAXIM-DOW", 16, CRC16_MAXIM_MODEL, 0x8005, 0x0000, 0xFFFF, true,
+     true, 0x44C2},
+    {"CRC-16/MCRF4XX", 16, CRC_MODEL_NONE, 0x1021, 0xFFFF, 0x0000, true, true,
+     0x6F91},
+    {"CRC-16/MODBUS", 16, CRC16_MODBUS_MODEL, 0x8005, 0xFFFF, 0x0000, true,
+     true, 0x4B37},
+    {"CRC-16/NRSC-5", 16, CRC_MODEL_NONE, 0x080B, 0xFFFF, 0x0000, true, true,
+     0xA066},
+    {"CRC-16/OPENSAFETY-A", 16, CRC_MODEL_NONE, 0x5935, 0x0000, 0x0000, false,
+     false, 0x5D38},
+    {"CRC-16/OPENSAFETY-B", 16, CRC_MODEL_NONE, 0x755B, 0x0000, 0x0000, false,
+     false, 0x20FE},
+    {"CRC-16/PROFIBUS", 16, CRC_MODEL_NONE, 0x1DCF, 0xFFFF, 0xFFFF, false,
+     false, 0xA819},
+    {"CRC-16/RIELLO", 16, CRC_MODEL_NONE, 0x1021, 0xB2AA, 0x0000, true, true,
+     0x63D0},
+    {"CRC-16/SPI-FUJITSU", 16, CRC_MODEL_NONE, 0x1021, 0x1D0F, 0x0000, false,
+     false, 0xE5CC},
+    {"CRC-16/T10-DIF", 16, CRC_MODEL_NONE, 0x8BB7, 0x0000, 0x0000, false, false,
+     0xD0DB},
+    {"CRC-16/TELEDISK", 16, CRC_MODEL_NONE, 0xA097, 0x0000, 0x0000, false,
+     false, 0x0FB3},
+    {"CRC-16/TMS37157", 16, CRC_MODEL_NONE, 0x1021, 0x89EC, 0x0000, true, true,
+     0x26B1},
+    {"CRC-16/UMTS", 16, CRC_MODEL_NONE, 0x8005, 0x0000, 0x0000, false, false,
+     0xFEE8},
+    {"CRC-16/USB", 16, CRC16_USB_MODEL, 0x8005, 0xFFFF, 0xFFFF, true, true,
+     0xB4C8},
+    {"CRC-16/XMODEM", 16, CRC16_XMODEM_MODEL, 0x1021, 0x0000, 0x0000, false,
+     false, 0x31C3},
+    {"CRC-32/AIXM", 32, CRC_MODEL_NONE, 0x814141AB, 0x00000000, 0x00000000,
+     false, false, 0x3010BF7F},
+    {"CRC-32/AUTOSAR", 32, CRC_MODEL_NONE, 0xF4ACFB13, 0xFFFFFFFF, 0xFFFFFFFF,
+     true, true, 0x1697D06A},
+    {"CRC-32/BASE91-D", 32, CRC_MODEL_NONE, 0xA833982B, 0xFFFFFFFF, 0xFFFFFFFF,
+     true, true, 0x87315576},
+    {"CRC-32/BZIP2", 32, CRC_MODEL_NONE, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF,
+     false, false, 0xFC891918},
+    {"CRC-32/CD-ROM-EDC", 32, CRC_MODEL_NONE, 0x8001801B, 0x00000000,
+     0x00000000, true, true, 0x6EC2EDC4},
+    {"CRC-32/CKSUM", 32, CRC_MODEL_NONE, 0x04C11DB7, 0x00000000, 0xFFFFFFFF,
+     false, false, 0x765E7680},
+    {"CRC-32/ISCSI", 32, CRC_MODEL_NONE, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF,
+     true, true, 0xE3069283},
+    {"CRC-32/ISO-HDLC", 32, CRC32_MODEL, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF,
+     true, true, 0xCBF43926},
+    {"CRC-32/JAMCRC", 32, CRC_MODEL_NONE, 0x04C11DB7, 0xFFFFFFFF, 0x00000000,
+     true, true, 0x340BC6D9},
+    {"CRC-32/MEF", 32, CRC_MODEL_NONE, 0x741B8CD7, 0xFFFFFFFF, 0x00000000, true,
+     true, 0xD2C22F51},
+    {"CRC-32/MPEG-2", 32, CRC32_MPEG2_MODEL, 0x04C11DB7, 0xFFFFFFFF, 0x00000000,
+     false, false, 0x0376E6E7},
+    {"CRC-32/XFER", 32, CRC_MODEL_NONE, 0x000000AF, 0x00000000, 0x00000000,
+     false, false, 0xBD0BE338},
+};
+
+/* Public functions --------------------------------------------------------- */
+const crc_model_t* crc_model_catalog(uint32_t* count) {
+    *count = sizeof(catalog) / sizeof(catalog[0]);
+
+    return catalog;
+}
+
+const crc_model_t* crc_model_find(const char* name) {
+    for (size_t i = 0; i < sizeof(catalog) / sizeof(catalog[0]); i++) {
+        if (strcmp(catalog[i].name, name) == 0) {
+            return &catalog[i];
+        }
+    }
+
+    return NULL;
+}
+
+uint32_t crc_model_calculate(const crc_model_t* model, const uint8_t* buf,
+                             uint32_t len) {
+    crc_batch_model_t batch;
+    crc_batch_engine_t eng;
+
+    batch.init = model->init;
+    batch.xor_out = model->xor_out;
+    batch.poly = model->poly;
+    batch.width = model->width;
+    batch.ref_in = model->ref_in;
+    batch.ref_out = model->ref_out;
+    crc_batch_engine_init(&eng, &batch);
+
+    return crc_batch_final(&eng, crc_batch_update(&eng, eng.init, buf, len));
+}
+
+bool crc8_init_model(crc8_ctx_t* ctx, const crc_model_t* model) {
+    if (model->width != 8) {
+        return false;
+    }
+
+    ctx->init = (uint8_t)model->init;
+    ctx->xor_out = (uint8_t)model->xor_out;
+    ctx->poly = (uint8_t)model->poly;
+    ctx->ref_in = model->ref_in;
+    ctx->ref_out = model->ref_out;
+
+    return true;
+}
+
+bool crc16_init_model(crc16_ctx_t* ctx, const crc_model_t* model) {
+    if (model->width != 16) {
+        return false;
+    }
+
+    ctx->init = (uint16_t)model->init;
+    ctx->xor_out = (uint16_t)model->xor_out;
+    ctx->poly = (uint16_t)model->poly;
+    ctx->ref_in = model->ref_in;
+    ctx->ref_out = model->ref_out;
+
+    return true;
+}
+
+bool crc32_init_model(crc32_ctx_t* ctx, const crc_model_t* model) {
+    if (model->width != 32) {
+        return false;
+    }
+
+    ctx->init = model->init;
+    ctx->xor_out = model->xor_out;
+    ctx->poly = model->poly;
+    ctx->ref_in = model->ref_in;
+    ctx->ref_out = model->ref_out;
+
+    return true;
+}
+
+/* ----------------------------- end of file -------------------------------- */
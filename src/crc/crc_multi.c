@@ -0,0 +1,229 @@
+/**
+ * \file            crc_multi.c
+ * \brief           Several CRC models computed in one pass
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc_multi.h"
+#include "crc/bit_utils.h"
+#include "crc/gf2poly.h"
+#include "crc_batch.h"
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Private state of a multi-model context.
+ *
+ * Models sharing a width, polynomial and input reflection share one lane,
+ * which runs their raw register from 0. Reflected lanes run a reflected
+ * register; MSB-first lanes run a register aligned to the top of 32 bits,
+ * with a table aligned the same way, so that every width shares one kernel.
+ */
+typedef struct {
+    crc_batch_engine_t eng[CRC_MULTI_MAX]; /*!< Engine of each model */
+    uint8_t lane_of[CRC_MULTI_MAX];        /*!< Lane of each model */
+    uint32_t table[CRC_MULTI_MAX][256];    /*!< Kernel table of each lane */
+    uint32_t reg[CRC_MULTI_MAX];           /*!< Raw register of each lane */
+    uint8_t model_of[CRC_MULTI_MAX];       /*!< First model of each lane */
+    uint8_t align[CRC_MULTI_MAX];          /*!< Register shift of each lane */
+    uint32_t lanes;                        /*!< Number of lanes */
+    uint32_t reflected;                    /*!< Number of reflected lanes,
+                                                placed first */
+    uint64_t len;                          /*!< Number of bytes fed */
+} multi_state_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static void multi_bytes(multi_state_t* st, const uint8_t* buf, uint32_t len);
+
+/* Public functions --------------------------------------------------------- */
+bool crc_multi_init(crc_multi_t* multi, const crc_multi_model_t models[],
+                    uint32_t n) {
+    crc_batch_model_t batch[CRC_MULTI_MAX];
+
+    if (multi == NULL || models == NULL || n == 0 || n > CRC_MULTI_MAX) {
+        return false;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (!crc_batch_model_get(&batch[i], models[i].width,
+                                 models[i].model)) {
+            return false;
+        }
+    }
+
+    multi_state_t* st = calloc(1, sizeof(*st));
+    if (st == NULL) {
+        return false;
+    }
+
+    // One lane per raw register, reflected lanes first so that the kernel
+    // needs no per-lane branch
+    for (int pass = 1; pass >= 0; pass--) {
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t k = 0;
+
+            if (batch[i].ref_in != (pass == 1)) {
+                continue;
+            }
+            crc_batch_engine_init(&st->eng[i], &batch[i]);
+            while (k < st->lanes
+                   && (batch[st->model_of[k]].width != batch[i].width
+                       || batch[st->model_of[k]].poly != batch[i].poly
+                       || batch[st->model_of[k]].ref_in != batch[i].ref_in)) {
+                k++;
+            }
+            if (k == st->lanes) {
+                st->model_of[k] = (uint8_t)i;
+                st->align[k] = batch[i].ref_in ? 0
+                                               : (uint8_t)(32 - batch[i].width);
+                for (uint32_t b = 0; b < 256; b++) {
+                    st->table[k][b] = st->eng[i].table[b] << st->align[k];
+                }
+                st->lanes++;
+            }
+            st->lane_of[i] = (uint8_t)k;
+        }
+        if (pass == 1) {
+            st->reflected = st->lanes;
+        }
+    }
+
+    multi->count = n;
+    multi->state = st;
+    crc_multi_reset(multi);
+
+    return true;
+}
+
+void crc_multi_reset(crc_multi_t* multi) {
+    multi_state_t* st = multi->state;
+
+    memset(st->reg, 0, sizeof(st->reg));
+    st->len = 0;
+}
+
+void crc_multi_update(crc_multi_t* multi, const uint8_t* buf, uint32_t len) {
+    multi_bytes(multi->state, buf, len);
+}
+
+void crc_multi_final(const crc_multi_t* multi, uint32_t crcs[]) {
+    const multi_state_t* st = multi->state;
+    uint32_t xpow[CRC_MULTI_MAX];
+
+    // register(init, data) = register(0, data) ^ init * x^(8 * len)
+    for (uint32_t k = 0; k < st->lanes; k++) {
+        const crc_batch_model_t* model = &st->eng[st->model_of[k]].model;
+
+        xpow[k] = (uint32_t)gf2poly_xpow8n(st->len, model->poly,
+                                           model->width);
+    }
+
+    for (uint32_t i = 0; i < multi->count; i++) {
+        const crc_batch_engine_t* eng = &st->eng[i];
+        uint32_t k = st->lane_of[i];
+        uint8_t width = eng->model.width;
+        uint32_t reg = st->reg[k] >> st->align[k];
+
+        if (eng->model.init != 0) {
+            uint32_t init = eng->model.init;
+
+            init = (uint32_t)gf2poly_mulmod(init, xpow[k], eng->model.poly,
+                                            width);
+            reg ^= eng->reflected ? reverse_bits_32(init) >> (32 - width)
+                                  : init;
+        }
+        crcs[i] = crc_batch_final(eng, reg);
+    }
+}
+
+void crc_multi_calculate(crc_multi_t* multi, const uint8_t* buf, uint32_t len,
+                         uint32_t crcs[]) {
+    crc_multi_reset(multi);
+    crc_multi_update(multi, buf, len);
+    crc_multi_final(multi, crcs);
+}
+
+void crc_multi_deinit(crc_multi_t* multi) {
+    free(multi->state);
+    multi->state = NULL;
+    multi->count = 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Advance every lane over the data.
+ *
+ * Each 64-bit word is loaded once; its bytes are then fed to all lanes in
+ * turn, so the independent register chains of the lanes are interleaved.
+ *
+ * \param[in,out]   st: Pointer to the state
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ */
+static void multi_bytes(multi_state_t* st, const uint8_t* buf, uint32_t len) {
+    uint32_t reg[CRC_MULTI_MAX];
+    uint32_t refl = st->reflected;
+    uint32_t count = st->lanes;
+    uint32_t i = 0;
+
+    memcpy(reg, st->reg, count * sizeof(reg[0]));
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word = crc_get_le(buf + i, 8);
+
+        for (uint32_t b = 0; b < 8; b++) {
+            uint8_t byte = (uint8_t)(word >> (8 * b));
+
+            for (uint32_t k = 0; k < refl; k++) {
+                reg[k] = (reg[k] >> 8) ^ st->table[k][(reg[k] ^ byte) & 0xFF];
+            }
+            for (uint32_t k = refl; k < count; k++) {
+                reg[k] = (reg[k] << 8) ^ st->table[k][(reg[k] >> 24) ^ byte];
+            }
+        }
+    }
+    for (; i < len; i++) {
+        for (uint32_t k = 0; k < refl; k++) {
+            reg[k] = (reg[k] >> 8) ^ st->table[k][(reg[k] ^ buf[i]) & 0xFF];
+        }
+        for (uint32_t k = refl; k < count; k++) {
+            reg[k] = (reg[k] << 8) ^ st->table[k][(reg[k] >> 24) ^ buf[i]];
+        }
+    }
+
+    memcpy(st->reg, reg, count * sizeof(reg[0]));
+    st->len += len;
+}
+
+/* ----------------------------- end of file -------------------------------- */
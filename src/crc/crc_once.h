@@ -0,0 +1,151 @@
+/**
+ * \file            crc_once.h
+ * \brief           Private one-time initialization guard of the CRC library
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_ONCE_H__
+#define __CRC_ONCE_H__
+
+/*
+ * Unlike crc_port.h, this header needs neither C11 atomics nor POSIX: it
+ * falls back to the MSVC interlocked intrinsics, and on compilers with
+ * neither to a plain flag, where the first calls must not race.
+ */
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#if !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           One-time initialization guard, see `crc_once`.
+ *
+ * Works whether or not the library threads are enabled, since callers may
+ * have threads of their own. Statically initialize with `CRC_ONCE_INIT`.
+ */
+#if !defined(__STDC_NO_ATOMICS__)
+typedef atomic_int crc_once_t;
+#elif defined(_MSC_VER)
+typedef volatile long crc_once_t;
+#else
+typedef volatile int crc_once_t;
+#endif
+
+#define CRC_ONCE_INIT 0
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Read the state of a guard: 0 idle, 1 running, 2 done.
+ *
+ * \param[in]       once: Pointer to the guard
+ * \return          The state, with acquire ordering
+ */
+static inline int crc_once_state(crc_once_t* once) {
+#if !defined(__STDC_NO_ATOMICS__)
+    return atomic_load_explicit(once, memory_order_acquire);
+#elif defined(_MSC_VER)
+    return (int)_InterlockedCompareExchange(once, 0, 0);
+#else
+    return *once;
+#endif
+}
+
+/**
+ * \brief           Move a guard from one state to the next.
+ *
+ * \param[in,out]   once: Pointer to the guard
+ * \param[in]       from: Expected state
+ * \param[in]       to: New state, published with release ordering
+ * \return          `true` if the guard was in state `from`
+ */
+static inline bool crc_once_move(crc_once_t* once, int from, int to) {
+#if !defined(__STDC_NO_ATOMICS__)
+    return atomic_compare_exchange_strong(once, &from, to);
+#elif defined(_MSC_VER)
+    return _InterlockedCompareExchange(once, to, from) == from;
+#else
+    if (*once != from) {
+        return false;
+    }
+    *once = to;
+    return true;
+#endif
+}
+
+/**
+ * \brief           Run a function exactly once per guard.
+ *
+ * Callers racing the first call yield until it has returned; afterwards the
+ * call is a single load.
+ *
+ * \param[in,out]   once: Pointer to the guard
+ * \param[in]       fn: Initialization function
+ */
+static inline void crc_once(crc_once_t* once, void (*fn)(void)) {
+    if (crc_once_state(once) == 2) {
+        return;
+    }
+    if (crc_once_move(once, 0, 1)) {
+        fn();
+        crc_once_move(once, 1, 2);
+        return;
+    }
+    while (crc_once_state(once) != 2) {
+        // Another caller is running `fn`
+#if defined(_WIN32)
+        SwitchToThread();
+#elif defined(__unix__) || defined(__APPLE__)
+        sched_yield();
+#endif
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_ONCE_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
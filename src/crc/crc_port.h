@@ -0,0 +1,661 @@
+/**
+ * \file            crc_port.h
+ * \brief           Private portability helpers of the CRC library
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_PORT_H__
+#define __CRC_PORT_H__
+
+/*
+ * This header must be included before any system header: it selects the
+ * POSIX interfaces (64-bit file offsets, threads, `stat`) used by the library.
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+#include "crc_cpu.h"
+
+/* Private configuration ---------------------------------------------------- */
+/**
+ * \brief           Whether worker threads are available (set by the build).
+ *
+ * Without threads, `crc_thread_create` runs the worker synchronously.
+ */
+#ifndef CRC_CFG_USE_THREADS
+#define CRC_CFG_USE_THREADS 0
+#endif
+
+/*
+ * The lock-free parts of the library need C11 atomics, even without threads.
+ * MSVC only provides them with /experimental:c11atomics, set by the build.
+ */
+#if defined(__STDC_NO_ATOMICS__)
+#error "C11 atomics are required (MSVC: /experimental:c11atomics)"
+#endif
+#include <stdatomic.h>
+
+/**
+ * \brief           Thread API behind `crc_thread_*`, `crc_mutex_*` and
+ *                  `crc_cond_*`: Win32 on Windows, POSIX threads elsewhere.
+ */
+#if CRC_CFG_USE_THREADS && defined(_WIN32)
+#define CRC_THREADS_WIN32 1
+#define CRC_THREADS_POSIX 0
+#elif CRC_CFG_USE_THREADS
+#define CRC_THREADS_WIN32 0
+#define CRC_THREADS_POSIX 1
+#include <pthread.h>
+#else
+#define CRC_THREADS_WIN32 0
+#define CRC_THREADS_POSIX 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Public definitions ------------------------------------------------------- */
+/**
+ * \brief           Most workers started by `crc_parallel_run`.
+ */
+#define CRC_PARALLEL_MAX 64
+
+/**
+ * \brief           64-bit file positioning, used as `fseek` / `ftell`.
+ */
+#if defined(_WIN32)
+#define crc_fseek _fseeki64
+#define crc_ftell _ftelli64
+#else
+#define crc_fseek fseeko
+#define crc_ftell ftello
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           File attributes used to detect changed files.
+ */
+typedef struct {
+    uint64_t size;    /*!< File size in bytes */
+    int64_t mtime_ns; /*!< Modification time in nanoseconds since the epoch */
+    uint64_t inode;   /*!< File serial number, 0 if not available */
+} crc_file_info_t;
+
+#if CRC_THREADS_WIN32
+typedef HANDLE crc_thread_t;
+typedef SRWLOCK crc_mutex_t;
+typedef CONDITION_VARIABLE crc_cond_t;
+#elif CRC_THREADS_POSIX
+typedef pthread_t crc_thread_t;
+typedef pthread_mutex_t crc_mutex_t;
+typedef pthread_cond_t crc_cond_t;
+#else
+typedef int crc_thread_t;
+typedef int crc_mutex_t;
+typedef int crc_cond_t;
+#endif
+
+/**
+ * \brief           Worker function run by `crc_thread_create`.
+ */
+typedef void* (*crc_thread_fn)(void* arg);
+
+#if CRC_THREADS_WIN32
+/**
+ * \brief           Start arguments of a Win32 thread, see `crc_thread_entry`.
+ */
+typedef struct {
+    crc_thread_fn fn; /*!< Worker function */
+    void* arg;        /*!< Argument passed to the worker */
+} crc_thread_start_t;
+#endif
+
+/**
+ * \brief           Work cut into chunks that workers claim one at a time.
+ */
+typedef struct {
+    uint64_t count;            /*!< Number of chunks */
+    atomic_uint_fast64_t next; /*!< Next chunk to be claimed */
+    atomic_bool failed;        /*!< Set by a worker on error */
+} crc_chunks_t;
+
+/* Public functions --------------------------------------------------------- */
+#if CRC_THREADS_WIN32
+/**
+ * \brief           Win32 entry point running a `crc_thread_fn` worker.
+ *
+ * \param[in]       param: Start arguments, allocated by `crc_thread_create`
+ * \return          0
+ */
+static inline DWORD WINAPI crc_thread_entry(LPVOID param) {
+    crc_thread_start_t start = *(crc_thread_start_t*)param;
+
+    free(param);
+    start.fn(start.arg);
+
+    return 0;
+}
+#endif
+
+/**
+ * \brief           Start a worker thread.
+ *
+ * \param[out]      thread: Pointer to the thread handle
+ * \param[in]       fn: Worker function
+ * \param[in]       arg: Argument passed to the worker
+ * \return          `true` on success, `false` if the thread cannot be started
+ */
+static inline bool crc_thread_create(crc_thread_t* thread, crc_thread_fn fn,
+                                     void* arg) {
+#if CRC_THREADS_WIN32
+    crc_thread_start_t* start = malloc(sizeof(*start));
+
+    if (start == NULL) {
+        return false;
+    }
+    start->fn = fn;
+    start->arg = arg;
+    *thread = CreateThread(NULL, 0, crc_thread_entry, start, 0, NULL);
+    if (*thread == NULL) {
+        free(start);
+        return false;
+    }
+    return true;
+#elif CRC_THREADS_POSIX
+    return pthread_create(thread, NULL, fn, arg) == 0;
+#else
+    *thread = 0;
+    fn(arg);
+    return true;
+#endif
+}
+
+/**
+ * \brief           Wait for a worker thread to finish.
+ *
+ * \param[in]       thread: Thread handle from `crc_thread_create`
+ */
+static inline void crc_thread_join(crc_thread_t thread) {
+#if CRC_THREADS_WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#elif CRC_THREADS_POSIX
+    pthread_join(thread, NULL);
+#else
+    (void)thread;
+#endif
+}
+
+/**
+ * \brief           Give the rest of the time slice to another thread.
+ *
+ * Available without the library threads, for spinning on state shared with
+ * the caller's own threads.
+ */
+static inline void crc_thread_yield(void) {
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/**
+ * \brief           Lower the priority of the calling thread to the lowest.
+ *
+ * For background workers that must yield the CPU to foreground threads. On
+ * Windows the thread priority is lowered, on Linux the nice value, which is
+ * per thread there; elsewhere the call does nothing.
+ */
+static inline void crc_thread_lower_priority(void) {
+#if defined(_WIN32)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+    setpriority(PRIO_PROCESS, 0, 19);
+#endif
+}
+
+/**
+ * \brief           Run workers in parallel and wait for all of them.
+ *
+ * Worker `i` gets `args + i * stride`; a `stride` of 0 shares one argument.
+ * The workers must split the work among themselves, since workers that
+ * cannot be started leave their share to the others, and worker 0 runs on
+ * the calling thread if none can.
+ *
+ * \param[in]       fn: Worker function
+ * \param[in,out]   args: Argument of the first worker
+ * \param[in]       stride: Distance in bytes between the worker arguments
+ * \param[in]       count: Number of workers, at most `CRC_PARALLEL_MAX`
+ */
+static inline void crc_parallel_run(crc_thread_fn fn, void* args,
+                                    size_t stride, uint32_t count) {
+    crc_thread_t thread[CRC_PARALLEL_MAX];
+    uint32_t started = 0;
+
+    count = count < CRC_PARALLEL_MAX ? count : CRC_PARALLEL_MAX;
+    while (started < count
+           && crc_thread_create(&thread[started], fn,
+                                (char*)args + started * stride)) {
+        started++;
+    }
+    if (started == 0 && count != 0) {
+        fn(args);
+    }
+    for (uint32_t i = 0; i < started; i++) {
+        crc_thread_join(thread[i]);
+    }
+}
+
+/**
+ * \brief           Prepare work for `crc_chunks_claim`.
+ *
+ * \param[out]      chunks: Pointer to the work
+ * \param[in]       count: Number of chunks
+ */
+static inline void crc_chunks_init(crc_chunks_t* chunks, uint64_t count) {
+    chunks->count = count;
+    atomic_init(&chunks->next, 0);
+    atomic_init(&chunks->failed, false);
+}
+
+/**
+ * \brief           Claim the next chunk of work.
+ *
+ * \param[in,out]   chunks: Pointer to the work
+ * \param[out]      chunk: Index of the claimed chunk
+ * \return          `true` on success, `false` once all chunks are claimed or
+ *                  a worker has failed
+ */
+static inline bool crc_chunks_claim(crc_chunks_t* chunks, uint64_t* chunk) {
+    if (atomic_load(&chunks->failed)) {
+        return false;
+    }
+    *chunk = atomic_fetch_add(&chunks->next, 1);
+
+    return *chunk < chunks->count;
+}
+
+/**
+ * \brief           Stop the other workers after an error.
+ *
+ * \param[in,out]   chunks: Pointer to the work
+ */
+static inline void crc_chunks_fail(crc_chunks_t* chunks) {
+    atomic_store(&chunks->failed, true);
+}
+
+/**
+ * \brief           Check whether a worker has failed.
+ *
+ * \param[in]       chunks: Pointer to the work
+ * \return          `true` if `crc_chunks_fail` was called
+ */
+static inline bool crc_chunks_failed(crc_chunks_t* chunks) {
+    return atomic_load(&chunks->failed);
+}
+
+/**
+ * \brief           Initialize a mutex.
+ *
+ * \param[out]      mutex: Pointer to the mutex
+ */
+static inline void crc_mutex_init(crc_mutex_t* mutex) {
+#if CRC_THREADS_WIN32
+    InitializeSRWLock(mutex);
+#elif CRC_THREADS_POSIX
+    pthread_mutex_init(mutex, NULL);
+#else
+    *mutex = 0;
+#endif
+}
+
+/**
+ * \brief           Lock a mutex.
+ *
+ * \param[in,out]   mutex: Pointer to the mutex
+ */
+static inline void crc_mutex_lock(crc_mutex_t* mutex) {
+#if CRC_THREADS_WIN32
+    AcquireSRWLockExclusive(mutex);
+#elif CRC_THREADS_POSIX
+    pthread_mutex_lock(mutex);
+#else
+    (void)mutex;
+#endif
+}
+
+/**
+ * \brief           Unlock a mutex.
+ *
+ * \param[in,out]   mutex: Pointer to the mutex
+ */
+static inline void crc_mutex_unlock(crc_mutex_t* mutex) {
+#if CRC_THREADS_WIN32
+    ReleaseSRWLockExclusive(mutex);
+#elif CRC_THREADS_POSIX
+    pthread_mutex_unlock(mutex);
+#else
+    (void)mutex;
+#endif
+}
+
+/**
+ * \brief           Release a mutex.
+ *
+ * \param[in,out]   mutex: Pointer to the mutex
+ */
+static inline void crc_mutex_deinit(crc_mutex_t* mutex) {
+#if CRC_THREADS_POSIX
+    pthread_mutex_destroy(mutex);
+#else
+    (void)mutex;
+#endif
+}
+
+/**
+ * \brief           Initialize a condition variable.
+ *
+ * \param[out]      cond: Pointer to the condition variable
+ */
+static inline void crc_cond_init(crc_cond_t* cond) {
+#if CRC_THREADS_WIN32
+    InitializeConditionVariable(cond);
+#elif CRC_THREADS_POSIX
+    pthread_cond_init(cond, NULL);
+#else
+    *cond = 0;
+#endif
+}
+
+/**
+ * \brief           Wait on a condition variable.
+ *
+ * Without threads there is nobody to wait for: callers must only wait while
+ * another worker can still make progress.
+ *
+ * \param[in,out]   cond: Pointer to the condition variable
+ * \param[in,out]   mutex: Pointer to the locked mutex
+ */
+static inline void crc_cond_wait(crc_cond_t* cond, crc_mutex_t* mutex) {
+#if CRC_THREADS_WIN32
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+#elif CRC_THREADS_POSIX
+    pthread_cond_wait(cond, mutex);
+#else
+    (void)cond;
+    (void)mutex;
+#endif
+}
+
+/**
+ * \brief           Wake up all waiters of a condition variable.
+ *
+ * \param[in,out]   cond: Pointer to the condition variable
+ */
+static inline void crc_cond_broadcast(crc_cond_t* cond) {
+#if CRC_THREADS_WIN32
+    WakeAllConditionVariable(cond);
+#elif CRC_THREADS_POSIX
+    pthread_cond_broadcast(cond);
+#else
+    (void)cond;
+#endif
+}
+
+/**
+ * \brief           Release a condition variable.
+ *
+ * \param[in,out]   cond: Pointer to the condition variable
+ */
+static inline void crc_cond_deinit(crc_cond_t* cond) {
+#if CRC_THREADS_POSIX
+    pthread_cond_destroy(cond);
+#else
+    (void)cond;
+#endif
+}
+
+/**
+ * \brief           Get the number of online CPUs, 1 without threads.
+ *
+ * \return          Number of CPUs that workers can run on
+ */
+static inline uint32_t crc_cpu_count(void) {
+#if CRC_THREADS_WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors
+                                         : 1;
+#elif CRC_THREADS_POSIX && defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * \brief           Get the attributes of a file.
+ *
+ * \param[in]       path: Path of the file
+ * \param[out]      info: Pointer to the attributes
+ * \return          `true` on success, `false` if the file cannot be queried
+ */
+static inline bool crc_file_info(const char* path, crc_file_info_t* info) {
+#if defined(_WIN32)
+    struct _stat64 st;
+
+    if (_stat64(path, &st) != 0) {
+        return false;
+    }
+    info->size = (uint64_t)st.st_size;
+    info->mtime_ns = (int64_t)st.st_mtime * 1000000000;
+    info->inode = 0;
+#else
+    struct stat st;
+
+    if (stat(path, &st) != 0) {
+        return false;
+    }
+    info->size = (uint64_t)st.st_size;
+    info->mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000
+                     + st.st_mtim.tv_nsec;
+    info->inode = (uint64_t)st.st_ino;
+#endif
+
+    return true;
+}
+
+/**
+ * \brief           Flush a file opened for writing down to the disk.
+ *
+ * \param[in,out]   fp: The file
+ * \return          `true` on success, `false` on I/O errors
+ */
+static inline bool crc_file_sync(FILE* fp) {
+    if (fflush(fp) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _commit(_fileno(fp)) == 0;
+#else
+    return fsync(fileno(fp)) == 0;
+#endif
+}
+
+/**
+ * \brief           Move a file over another one, replacing it atomically.
+ *
+ * ISO C `rename` fails on Windows when the target exists.
+ *
+ * \param[in]       from: Path of the new file
+ * \param[in]       to: Path of the file to be replaced
+ * \return          `true` on success, `false` otherwise
+ */
+static inline bool crc_file_replace(const char* from, const char* to) {
+#if defined(_WIN32)
+    return MoveFileExA(from, to,
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)
+           != 0;
+#else
+    return rename(from, to) == 0;
+#endif
+}
+
+/**
+ * \brief           Store a value in little-endian byte order.
+ *
+ * \param[out]      buf: Destination
+ * \param[in]       value: Value to store
+ * \param[in]       bytes: Number of bytes to store
+ */
+static inline void crc_put_le(uint8_t* buf, uint64_t value, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; i++) {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * \brief           Load a value stored in little-endian byte order.
+ *
+ * \param[in]       buf: Source
+ * \param[in]       bytes: Number of bytes to load
+ * \return          The value
+ */
+static inline uint64_t crc_get_le(const uint8_t* buf, uint32_t bytes) {
+    uint64_t value = 0;
+
+    for (uint32_t i = 0; i < bytes; i++) {
+        value |= (uint64_t)buf[i] << (8 * i);
+    }
+
+    return value;
+}
+
+/**
+ * \brief           Get the current time in seconds.
+ *
+ * \return          Seconds since an arbitrary epoch
+ */
+static inline double crc_time_now(void) {
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \brief           Get the CPU time used by the calling thread in seconds.
+ *
+ * Falls back to `crc_time_now` where the thread clock is not available.
+ *
+ * \return          Seconds of CPU time since an arbitrary epoch
+ */
+static inline double crc_thread_cpu_time(void) {
+#if defined(_WIN32)
+    FILETIME created, exited, kernel, user;
+
+    if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel,
+                        &user)) {
+        return crc_time_now();
+    }
+
+    // 100 ns units
+    uint64_t ticks = ((uint64_t)kernel.dwHighDateTime << 32)
+                     + kernel.dwLowDateTime
+                     + ((uint64_t)user.dwHighDateTime << 32)
+                     + user.dwLowDateTime;
+
+    return (double)ticks * 1e-7;
+#else
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return crc_time_now();
+    }
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * \brief           Suspend the calling thread.
+ *
+ * \param[in]       seconds: Time to sleep in seconds
+ */
+static inline void crc_sleep(double seconds) {
+    if (seconds <= 0) {
+        return;
+    }
+#if defined(_WIN32)
+    Sleep((DWORD)(seconds * 1000));
+#else
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)seconds;
+    ts.tv_nsec = (long)((seconds - (double)ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_PORT_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
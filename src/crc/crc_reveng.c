@@ -0,0 +1,597 @@
+/**
+ * \file            crc_reveng.c
+ * \brief           CRC model parameter reverse-engineering
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc_reveng.h"
+#include "crc/bit_utils.h"
+#include "crc/gf2poly.h"
+#include "crc_batch.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Number of candidate polynomials tested per pass over the
+ *                  GCD, as independent chains.
+ */
+#define REVENG_BATCH 8
+
+/**
+ * \brief           Number of candidate polynomials a worker claims at a time.
+ */
+#define REVENG_CHUNK 4096
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Sample index sorted by length.
+ */
+typedef struct {
+    uint32_t len; /*!< Length of the sample */
+    uint32_t idx; /*!< Index of the sample */
+} reveng_order_t;
+
+/**
+ * \brief           Search for the divisors of a GCD shared by all workers.
+ */
+typedef struct {
+    const uint64_t* g;          /*!< The GCD, bit i holds x^i */
+    int32_t deg;                /*!< Degree of the GCD */
+    uint8_t width;              /*!< Degree of the divisors */
+    uint64_t count;             /*!< Number of candidates */
+    atomic_uint_fast64_t next;  /*!< Next candidate to be claimed */
+    atomic_uint found;          /*!< Number of divisors found */
+    uint32_t polys[CRC_REVENG_POLYS_MAX]; /*!< Divisors found */
+} reveng_search_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static int reveng_order_cmp(const void* a, const void* b);
+static uint32_t reveng_polys(const crc_reveng_cfg_t* cfg,
+                             const crc_reveng_sample_t samples[],
+                             uint32_t pairs[][2], uint32_t npairs,
+                             uint64_t* buf[2], uint32_t words, bool ref_in,
+                             bool ref_out, uint32_t polys[]);
+static void reveng_pair(uint64_t* q, uint32_t words,
+                        const crc_reveng_sample_t* a,
+                        const crc_reveng_sample_t* b, uint8_t width,
+                        bool ref_in, bool ref_out);
+static void* reveng_worker(void* arg);
+static bool reveng_solve(const crc_reveng_sample_t samples[], uint32_t n,
+                         uint8_t width, uint32_t poly, bool ref_in,
+                         bool ref_out, crc_model_t* model);
+static int32_t poly_deg(const uint64_t* a, uint32_t words);
+static void poly_mod(uint64_t* a, int32_t da, const uint64_t* b, int32_t db);
+static uint32_t reflect(uint32_t data, uint8_t width);
+
+/* Public functions --------------------------------------------------------- */
+uint32_t crc_reveng(const crc_reveng_cfg_t* cfg,
+                    const crc_reveng_sample_t samples[], uint32_t n,
+                    crc_model_t models[], uint32_t max_models) {
+    static const bool refs[4][2] = {
+        {false, false}, {true, true}, {false, true}, {true, false}};
+    uint32_t pairs[CRC_REVENG_PAIRS_MAX][2];
+    uint32_t npairs = 0;
+    uint32_t maxlen = 0;
+    uint32_t found = 0;
+
+    if (cfg == NULL || samples == NULL
+        || (cfg->width != 8 && cfg->width != 16 && cfg->width != 32)) {
+        return 0;
+    }
+
+    // Pair up samples of equal length, they cancel init and xor_out
+    reveng_order_t* order = malloc((size_t)n * sizeof(*order) + 1);
+    if (order == NULL) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        order[i].len = samples[i].len;
+        order[i].idx = i;
+    }
+    qsort(order, n, sizeof(*order), reveng_order_cmp);
+    for (uint32_t i = 1; i < n && npairs < CRC_REVENG_PAIRS_MAX; i++) {
+        if (order[i].len == order[i - 1].len) {
+            pairs[npairs][0] = order[i - 1].idx;
+            pairs[npairs][1] = order[i].idx;
+            maxlen = order[i].len > maxlen ? order[i].len : maxlen;
+            npairs++;
+        }
+    }
+    free(order);
+
+    uint32_t words = (uint32_t)((8ull * maxlen + cfg->width) / 64 + 1);
+    uint64_t* buf[2] = {NULL, NULL};
+    bool ok = true;
+
+    for (int i = 0; i < 2 && cfg->poly == 0; i++) {
+        buf[i] = malloc((size_t)words * sizeof(uint64_t));
+        ok = ok && buf[i] != NULL;
+    }
+
+    for (int r = 0; r < 4 && ok; r++) {
+        uint32_t polys[CRC_REVENG_POLYS_MAX];
+        uint32_t count = 1;
+
+        if (cfg->poly != 0) {
+            polys[0] = cfg->poly;
+        } else {
+            count = reveng_polys(cfg, samples, pairs, npairs, buf, words,
+                                 refs[r][0], refs[r][1], polys);
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            crc_model_t model;
+
+            if (!reveng_solve(samples, n, cfg->width, polys[i], refs[r][0],
+                              refs[r][1], &model)) {
+                continue;
+            }
+            if (found < max_models) {
+                models[found] = model;
+            }
+            found++;
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        free(buf[i]);
+    }
+
+    return ok ? found : 0;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Order samples by length, then by index.
+ *
+ * \param[in]       a: Pointer to the first `reveng_order_t`
+ * \param[in]       b: Pointer to the second `reveng_order_t`
+ * \return          Negative, zero or positive as for `qsort`
+ */
+static int reveng_order_cmp(const void* a, const void* b) {
+    const reveng_order_t* x = a;
+    const reveng_order_t* y = b;
+
+    if (x->len != y->len) {
+        return x->len < y->len ? -1 : 1;
+    }
+
+    return x->idx < y->idx ? -1 : x->idx > y->idx;
+}
+
+/**
+ * \brief           Find the candidate polynomials for a reflection setting.
+ *
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[in]       samples: The samples
+ * \param[in]       pairs: Indexes of the equal-length sample pairs
+ * \param[in]       npairs: Number of pairs
+ * \param[in,out]   buf: Two scratch polynomials of `words` words
+ * \param[in]       words: Size of the scratch polynomials
+ * \param[in]       ref_in: Whether the input is reflected
+ * \param[in]       ref_out: Whether the output is reflected
+ * \param[out]      polys: The candidate polynomials, sorted
+ * \return          Number of candidates
+ */
+static uint32_t reveng_polys(const crc_reveng_cfg_t* cfg,
+                             const crc_reveng_sample_t samples[],
+                             uint32_t pairs[][2], uint32_t npairs,
+                             uint64_t* buf[2], uint32_t words, bool ref_in,
+                             bool ref_out, uint32_t polys[]) {
+    uint64_t* g = buf[0];
+    uint64_t* q = buf[1];
+    uint8_t width = cfg->width;
+
+    // Every (a ^ b) * x^width ^ (crc(a) ^ crc(b)) is a multiple of the
+    // polynomial
+    memset(g, 0, (size_t)words * sizeof(uint64_t));
+    for (uint32_t p = 0; p < npairs; p++) {
+        uint64_t* a = g;
+        uint64_t* b = q;
+
+        reveng_pair(q, words, &samples[pairs[p][0]], &samples[pairs[p][1]],
+                    width, ref_in, ref_out);
+
+        int32_t da = poly_deg(a, words);
+        int32_t db = poly_deg(b, words);
+        while (db >= 0) {
+            if (da >= db) {
+                poly_mod(a, da, b, db);
+                da = poly_deg(a, words);
+            }
+            uint64_t* s = a;
+            int32_t ds = da;
+
+            a = b;
+            da = db;
+            b = s;
+            db = ds;
+        }
+        if (a != g) {
+            memcpy(g, a, (size_t)words * sizeof(uint64_t));
+        }
+    }
+
+    int32_t deg = poly_deg(g, words);
+    if (deg < width) {
+        return 0; // No pair, or inconsistent samples
+    }
+    if (deg == width) {
+        polys[0] = (uint32_t)(g[0] & (((uint64_t)1 << width) - 1));
+        return 1;
+    }
+    if (width == 32 && !cfg->exhaustive) {
+        return 0;
+    }
+
+    // Search the divisors of the right degree; a CRC polynomial has x^0
+    reveng_search_t job;
+    uint32_t threads = cfg->threads != 0 ? cfg->threads : crc_cpu_count();
+
+    job.g = g;
+    job.deg = deg;
+    job.width = width;
+    job.count = (uint64_t)1 << (width - 1);
+    atomic_init(&job.next, 0);
+    atomic_init(&job.found, 0);
+
+    uint64_t chunks = (job.count + REVENG_CHUNK - 1) / REVENG_CHUNK;
+    threads = threads < CRC_REVENG_THREADS_MAX ? threads
+                                               : CRC_REVENG_THREADS_MAX;
+    threads = threads < chunks ? threads : (uint32_t)chunks;
+    crc_parallel_run(reveng_worker, &job, 0, threads);
+
+    uint32_t count = atomic_load(&job.found);
+    count = count < CRC_REVENG_POLYS_MAX ? count : CRC_REVENG_POLYS_MAX;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t j = i;
+
+        for (; j > 0 && polys[j - 1] > job.polys[i]; j--) {
+            polys[j] = polys[j - 1];
+        }
+        polys[j] = job.polys[i];
+    }
+
+    return count;
+}
+
+/**
+ * \brief           Build the multiple of the polynomial given by two samples
+ *                  of equal length.
+ *
+ * \param[out]      q: The multiple, bit i holds x^i
+ * \param[in]       words: Size of `q` in words
+ * \param[in]       a: Pointer to the first sample
+ * \param[in]       b: Pointer to the second sample
+ * \param[in]       width: CRC width in bits
+ * \param[in]       ref_in: Whether the input is reflected
+ * \param[in]       ref_out: Whether the output is reflected
+ */
+static void reveng_pair(uint64_t* q, uint32_t words,
+                        const crc_reveng_sample_t* a,
+                        const crc_reveng_sample_t* b, uint8_t width,
+                        bool ref_in, bool ref_out) {
+    uint32_t len = a->len;
+    uint32_t mask = width == 32 ? 0xFFFFFFFFu : ((uint32_t)1 << width) - 1;
+    uint32_t diff = (a->crc ^ b->crc) & mask;
+
+    memset(q, 0, (size_t)words * sizeof(uint64_t));
+    for (uint32_t k = 0; k < len; k++) {
+        uint8_t byte = a->buf[k] ^ b->buf[k];
+
+        if (ref_in) {
+            byte = reverse_bits(byte);
+        }
+        // The first byte carries the highest powers of x
+        uint64_t bit = (uint64_t)width + 8ull * (len - 1 - k);
+        for (uint32_t j = 0; j < 8; j++) {
+            if ((byte >> j) & 1) {
+                q[(bit + j) / 64] |= (uint64_t)1 << ((bit + j) % 64);
+            }
+        }
+    }
+    q[0] ^= ref_out ? reflect(diff, width) : diff;
+}
+
+/**
+ * \brief           Search worker: test candidate polynomials for dividing
+ *                  the GCD.
+ *
+ * The remainder of the GCD is computed for `REVENG_BATCH` candidates at
+ * once, sharing the bit extraction; the chains are independent and
+ * branch-free, so the compiler can vectorize them.
+ *
+ * \param[in]       arg: Pointer to the `reveng_search_t` job
+ * \return          NULL
+ */
+static void* reveng_worker(void* arg) {
+    reveng_search_t* job = arg;
+    uint8_t width = job->width;
+    uint64_t top = (uint64_t)1 << width;
+
+    for (;;) {
+        uint64_t first = atomic_fetch_add(&job->next, REVENG_CHUNK);
+
+        if (first >= job->count
+            || atomic_load(&job->found) >= CRC_REVENG_POLYS_MAX) {
+            break;
+        }
+        uint64_t last = first + REVENG_CHUNK < job->count
+                            ? first + REVENG_CHUNK
+                            : job->count;
+
+        for (uint64_t k = first; k < last; k += REVENG_BATCH) {
+            uint64_t full[REVENG_BATCH];
+            uint64_t rem[REVENG_BATCH];
+
+            for (uint32_t c = 0; c < REVENG_BATCH; c++) {
+                uint64_t idx = k + c < last ? k + c : k;
+
+                full[c] = top | (2 * idx + 1);
+                rem[c] = 0;
+            }
+            for (int32_t i = job->deg; i >= 0; i--) {
+                uint64_t bit = (job->g[i / 64] >> (i % 64)) & 1;
+
+                for (uint32_t c = 0; c < REVENG_BATCH; c++) {
+                    rem[c] = (rem[c] << 1) | bit;
+                    rem[c] ^= (0 - ((rem[c] >> width) & 1)) & full[c];
+                }
+            }
+            for (uint32_t c = 0; c < REVENG_BATCH && k + c < last; c++) {
+                if (rem[c] == 0) {
+                    uint32_t slot = atomic_fetch_add(&job->found, 1);
+
+                    if (slot < CRC_REVENG_POLYS_MAX) {
+                        job->polys[slot] = (uint32_t)(full[c] & (top - 1));
+                    }
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           Solve for the initial value and final XOR of a model.
+ *
+ * With `N` the register run from 0 over a message of `len` bytes and
+ * `out` the output reflection, every sample gives `width` equations
+ * `init * x^(8 * len) ^ out(xor_out) = out(crc) ^ N` over GF(2), in the
+ * `2 * width` unknown bits of `init` and `out(xor_out)`. Unknowns are left
+ * free when all samples have the same length, or when the polynomial shares
+ * a factor with `x^(8 * d) + 1` for every difference `d` of the lengths, as
+ * those divisible by `x + 1` do. The first catalogue model then satisfying
+ * the reduced system is preferred; otherwise free unknowns are set to 0.
+ *
+ * \param[in]       samples: The samples
+ * \param[in]       n: Number of samples
+ * \param[in]       width: CRC width in bits
+ * \param[in]       poly: The polynomial
+ * \param[in]       ref_in: Whether the input is reflected
+ * \param[in]       ref_out: Whether the output is reflected
+ * \param[out]      model: The model found
+ * \return          `true` if the samples are consistent with the model
+ */
+static bool reveng_solve(const crc_reveng_sample_t samples[], uint32_t n,
+                         uint8_t width, uint32_t poly, bool ref_in,
+                         bool ref_out, crc_model_t* model) {
+    crc_batch_model_t raw = {0, 0, poly, width, ref_in, ref_in};
+    crc_batch_engine_t eng;
+    uint32_t mask = width == 32 ? 0xFFFFFFFFu : ((uint32_t)1 << width) - 1;
+    uint64_t coef[64] = {0}; // Rows by highest unknown, 0 if none
+    uint64_t rhs = 0;        // Right-hand side bit of each row
+    uint32_t col[32];
+    uint32_t col_len = 0;
+    bool col_valid = false;
+
+    crc_batch_engine_init(&eng, &raw);
+
+    for (uint32_t s = 0; s < n; s++) {
+        uint32_t reg = crc_batch_update(&eng, 0, samples[s].buf,
+                                        samples[s].len);
+        uint32_t crc = samples[s].crc & mask;
+
+        if (eng.reflected) {
+            reg = reflect(reg, width);
+        }
+        uint32_t r = (ref_out ? reflect(crc, width) : crc) ^ reg;
+
+        // Column j: x^j * x^(8 * len), shared by samples of equal length
+        if (!col_valid || col_len != samples[s].len) {
+            uint64_t xl = gf2poly_xpow8n(samples[s].len, poly, width);
+
+            for (uint32_t j = 0; j < width; j++) {
+                col[j] = (uint32_t)gf2poly_mulmod((uint64_t)1 << j, xl, poly,
+                                                  width);
+            }
+            col_len = samples[s].len;
+            col_valid = true;
+        }
+
+        for (uint32_t b = 0; b < width; b++) {
+            uint64_t row = (uint64_t)1 << (width + b);
+            uint64_t bit = (r >> b) & 1;
+
+            for (uint32_t j = 0; j < width; j++) {
+                row |= (uint64_t)((col[j] >> b) & 1) << j;
+            }
+            // Reduce by the rows already kept
+            while (row != 0) {
+                uint32_t p = 63;
+
+                while (!((row >> p) & 1)) {
+                    p--;
+                }
+                if (coef[p] == 0) {
+                    coef[p] = row;
+                    rhs |= bit << p;
+                    break;
+                }
+                row ^= coef[p];
+                bit ^= (rhs >> p) & 1;
+            }
+            if (row == 0 && bit != 0) {
+                return false; // Inconsistent samples
+            }
+        }
+    }
+
+    uint32_t catalog_count;
+    const crc_model_t* catalog = crc_model_catalog(&catalog_count);
+
+    // Any catalogue model within the solutions, before picking one of them
+    for (uint32_t i = 0; i < catalog_count; i++) {
+        const crc_model_t* c = &catalog[i];
+        uint64_t xc;
+        bool ok = true;
+
+        if (c->width != width || c->poly != poly || c->ref_in != ref_in
+            || c->ref_out != ref_out) {
+            continue;
+        }
+        xc = c->init
+             | (uint64_t)(ref_out ? reflect(c->xor_out, width) : c->xor_out)
+                   << width;
+        for (uint32_t p = 0; ok && p < 2u * width; p++) {
+            if (coef[p] != 0) {
+                uint64_t v = coef[p] & xc;
+                uint64_t parity = (rhs >> p) & 1;
+
+                for (; v != 0; v &= v - 1) {
+                    parity ^= 1;
+                }
+                ok = parity == 0;
+            }
+        }
+        if (ok) {
+            *model = *c;
+            return true;
+        }
+    }
+
+    // Back-substitute from the lowest unknown up
+    uint64_t x = 0;
+    for (uint32_t p = 0; p < 2u * width; p++) {
+        if (coef[p] != 0) {
+            uint64_t v = coef[p] & x;
+            uint64_t parity = (rhs >> p) & 1;
+
+            for (; v != 0; v &= v - 1) {
+                parity ^= 1;
+            }
+            x |= parity << p;
+        }
+    }
+
+    uint32_t out = (uint32_t)(x >> width) & mask;
+
+    model->name = NULL;
+    model->width = width;
+    model->model = CRC_MODEL_NONE;
+    model->poly = poly;
+    model->init = (uint32_t)x & mask;
+    model->xor_out = ref_out ? reflect(out, width) : out;
+    model->ref_in = ref_in;
+    model->ref_out = ref_out;
+    model->check = crc_model_calculate(model, (const uint8_t*)"123456789", 9);
+
+    return true;
+}
+
+/**
+ * \brief           Get the degree of a polynomial.
+ *
+ * \param[in]       a: The polynomial, bit i holds x^i
+ * \param[in]       words: Size of the polynomial in words
+ * \return          The degree, -1 for the zero polynomial
+ */
+static int32_t poly_deg(const uint64_t* a, uint32_t words) {
+    for (uint32_t w = words; w-- > 0;) {
+        if (a[w] != 0) {
+            int32_t bit = 63;
+
+            while (!((a[w] >> bit) & 1)) {
+                bit--;
+            }
+            return (int32_t)(64 * w) + bit;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * \brief           Reduce a polynomial modulo another one, in place.
+ *
+ * \param[in,out]   a: The dividend, replaced by the remainder
+ * \param[in]       da: Degree of the dividend
+ * \param[in]       b: The divisor
+ * \param[in]       db: Degree of the divisor, at least 0
+ */
+static void poly_mod(uint64_t* a, int32_t da, const uint64_t* b, int32_t db) {
+    uint32_t bw = (uint32_t)db / 64 + 1;
+
+    for (int32_t i = da; i >= db; i--) {
+        if (!((a[i / 64] >> (i % 64)) & 1)) {
+            continue;
+        }
+
+        uint32_t s = (uint32_t)(i - db);
+        uint32_t ws = s / 64;
+        uint32_t bs = s % 64;
+
+        // Words above the one of bit i only receive zeros
+        for (uint32_t j = 0; j < bw && j + ws <= (uint32_t)i / 64; j++) {
+            a[j + ws] ^= b[j] << bs;
+            if (bs != 0 && j + ws + 1 <= (uint32_t)i / 64) {
+                a[j + ws + 1] ^= b[j] >> (64 - bs);
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Reverse the low `width` bits of a value.
+ *
+ * \param[in]       data: Value to be reversed
+ * \param[in]       width: Number of bits to reverse
+ * \return          The reversed value
+ */
+static uint32_t reflect(uint32_t data, uint8_t width) {
+    return reverse_bits_32(data) >> (32 - width);
+}
+
+/* ----------------------------- end of file -------------------------------- */
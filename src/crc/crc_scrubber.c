@@ -0,0 +1,511 @@
+/**
+ * \file            crc_scrubber.c
+ * \brief           Rate-limited background integrity scrubber
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc/crc_scrubber.h"
+#include "crc_batch.h"
+
+/* Private typedefs --------------------------------------------------------- */
+/**
+ * \brief           Registered region and the progress of its current pass.
+ */
+typedef struct {
+    uint32_t id;            /*!< Identifier of the region */
+    crc_batch_engine_t eng; /*!< Engine of the model */
+    const uint8_t* buf;     /*!< Memory to verify, NULL for a file */
+    char* path;             /*!< File to verify, owned */
+    uint64_t offset;        /*!< Offset of the range in the file */
+    uint64_t len;           /*!< Length of the range in bytes */
+    uint32_t expected;      /*!< Expected checksum */
+    uint32_t reg;           /*!< Running register of the current pass */
+    uint64_t pos;           /*!< Bytes verified in the current pass */
+    FILE* fp;               /*!< File open during a pass */
+    bool removed;           /*!< Removed while being verified, freed by the
+                                 slice */
+} scrubber_entry_t;
+
+/**
+ * \brief           Private state of a scrubber.
+ */
+typedef struct {
+    crc_mutex_t work;           /*!< Serializes slices, see `scrubber_slice` */
+    crc_mutex_t lock;           /*!< Protects everything below */
+    scrubber_entry_t* busy;     /*!< Region of the slice in progress */
+    scrubber_entry_t** entries; /*!< Registered regions */
+    uint32_t count;             /*!< Number of registered regions */
+    uint32_t capacity;          /*!< Capacity of `entries` */
+    uint32_t cursor;            /*!< Index of the region being verified */
+    uint32_t next_id;           /*!< Identifier of the next region */
+    uint8_t* io;                /*!< Read buffer of one slice */
+    crc_scrubber_stats_t stats; /*!< Statistics */
+    crc_thread_t thread;        /*!< Worker thread */
+    bool running;               /*!< Whether the worker was started */
+    atomic_bool stop;           /*!< Set to stop the worker */
+} scrubber_state_t;
+
+/* Private function prototypes ---------------------------------------------- */
+static bool scrubber_slice(scrubber_state_t* st, uint32_t slice,
+                           uint32_t* done, uint32_t* id, uint32_t* expected,
+                           uint32_t* actual);
+static void scrubber_rewind(scrubber_entry_t* entry);
+static double scrubber_sleep(scrubber_state_t* st, double seconds);
+static void* scrubber_worker(void* arg);
+
+/* Public functions --------------------------------------------------------- */
+bool crc_scrubber_init(crc_scrubber_t* scrubber,
+                       const crc_scrubber_cfg_t* cfg) {
+    if (scrubber == NULL || cfg == NULL || cfg->cpu_share < 0
+        || cfg->cpu_share > 1) {
+        return false;
+    }
+
+    scrubber->cfg = *cfg;
+    if (scrubber->cfg.slice == 0) {
+        scrubber->cfg.slice = CRC_SCRUBBER_SLICE;
+    }
+
+    scrubber_state_t* st = calloc(1, sizeof(*st));
+    if (st == NULL) {
+        return false;
+    }
+    st->io = malloc(scrubber->cfg.slice);
+    if (st->io == NULL) {
+        free(st);
+        return false;
+    }
+    crc_mutex_init(&st->work);
+    crc_mutex_init(&st->lock);
+    atomic_init(&st->stop, false);
+    st->next_id = 1;
+    scrubber->state = st;
+
+    return true;
+}
+
+bool crc_scrubber_add(crc_scrubber_t* scrubber,
+                      const crc_scrubber_region_t* region, uint32_t* id) {
+    crc_batch_model_t batch;
+
+    if (scrubber == NULL || region == NULL || id == NULL || region->len == 0
+        || (region->buf == NULL && region->path == NULL)
+        || !crc_batch_model_get(&batch, region->width, region->model)) {
+        return false;
+    }
+
+    scrubber_entry_t* entry = calloc(1, sizeof(*entry));
+    if (entry == NULL) {
+        return false;
+    }
+    if (region->buf == NULL) {
+        size_t size = strlen(region->path) + 1;
+
+        entry->path = malloc(size);
+        if (entry->path == NULL) {
+            free(entry);
+            return false;
+        }
+        memcpy(entry->path, region->path, size);
+    }
+    crc_batch_engine_init(&entry->eng, &batch);
+    entry->buf = region->buf;
+    entry->offset = region->offset;
+    entry->len = region->len;
+    entry->expected = region->expected;
+    entry->reg = entry->eng.init;
+
+    scrubber_state_t* st = scrubber->state;
+    bool ok = true;
+
+    crc_mutex_lock(&st->lock);
+    if (st->count == st->capacity) {
+        uint32_t capacity = st->capacity != 0 ? 2 * st->capacity : 8;
+        scrubber_entry_t** entries = realloc(
+            st->entries, capacity * sizeof(*entries));
+
+        ok = entries != NULL;
+        if (ok) {
+            st->entries = entries;
+            st->capacity = capacity;
+        }
+    }
+    if (ok) {
+        entry->id = st->next_id++;
+        st->entries[st->count++] = entry;
+        *id = entry->id;
+    }
+    crc_mutex_unlock(&st->lock);
+
+    if (!ok) {
+        free(entry->path);
+        free(entry);
+    }
+
+    return ok;
+}
+
+bool crc_scrubber_remove(crc_scrubber_t* scrubber, uint32_t id) {
+    scrubber_state_t* st = scrubber->state;
+    scrubber_entry_t* entry = NULL;
+    bool found = false;
+
+    crc_mutex_lock(&st->lock);
+    for (uint32_t i = 0; i < st->count; i++) {
+        if (st->entries[i]->id == id) {
+            entry = st->entries[i];
+            memmove(&st->entries[i], &st->entries[i + 1],
+                    (st->count - i - 1) * sizeof(st->entries[0]));
+            st->count--;
+            // Regions other than the current one are always at their start
+            if (st->cursor > i) {
+                st->cursor--;
+            }
+            // The slice in progress frees its region once done
+            if (entry == st->busy) {
+                entry->removed = true;
+                entry = NULL;
+            }
+            found = true;
+            break;
+        }
+    }
+    crc_mutex_unlock(&st->lock);
+
+    if (entry == NULL) {
+        return found;
+    }
+    if (entry->fp != NULL) {
+        fclose(entry->fp);
+    }
+    free(entry->path);
+    free(entry);
+
+    return true;
+}
+
+uint64_t crc_scrubber_step(crc_scrubber_t* scrubber, uint64_t max_bytes) {
+    scrubber_state_t* st = scrubber->state;
+    uint64_t total = 0;
+
+    while (total < max_bytes) {
+        uint64_t left = max_bytes - total;
+        uint32_t slice = left < scrubber->cfg.slice ? (uint32_t)left
+                                                    : scrubber->cfg.slice;
+        uint32_t done, id, expected, actual;
+
+        bool mismatch = scrubber_slice(st, slice, &done, &id, &expected,
+                                       &actual);
+
+        // Reported without the lock so the callback may remove the region
+        if (mismatch && scrubber->cfg.on_mismatch != NULL) {
+            scrubber->cfg.on_mismatch(scrubber->cfg.arg, id, expected, actual);
+        }
+        if (done == 0) {
+            break;
+        }
+        total += done;
+    }
+
+    return total;
+}
+
+bool crc_scrubber_start(crc_scrubber_t* scrubber) {
+#if CRC_CFG_USE_THREADS
+    scrubber_state_t* st = scrubber->state;
+
+    if (st->running) {
+        return false;
+    }
+    atomic_store(&st->stop, false);
+    st->running = crc_thread_create(&st->thread, scrubber_worker, scrubber);
+
+    return st->running;
+#else
+    // The worker would run synchronously and never return
+    (void)scrubber;
+    (void)scrubber_worker;
+    return false;
+#endif
+}
+
+void crc_scrubber_stop(crc_scrubber_t* scrubber) {
+    scrubber_state_t* st = scrubber->state;
+
+    if (!st->running) {
+        return;
+    }
+    atomic_store(&st->stop, true);
+    crc_thread_join(st->thread);
+    st->running = false;
+}
+
+void crc_scrubber_stats(crc_scrubber_t* scrubber,
+                        crc_scrubber_stats_t* stats) {
+    scrubber_state_t* st = scrubber->state;
+
+    crc_mutex_lock(&st->lock);
+    *stats = st->stats;
+    crc_mutex_unlock(&st->lock);
+}
+
+void crc_scrubber_deinit(crc_scrubber_t* scrubber) {
+    scrubber_state_t* st = scrubber->state;
+
+    if (st == NULL) {
+        return;
+    }
+    crc_scrubber_stop(scrubber);
+    for (uint32_t i = 0; i < st->count; i++) {
+        if (st->entries[i]->fp != NULL) {
+            fclose(st->entries[i]->fp);
+        }
+        free(st->entries[i]->path);
+        free(st->entries[i]);
+    }
+    crc_mutex_deinit(&st->lock);
+    crc_mutex_deinit(&st->work);
+    free(st->entries);
+    free(st->io);
+    free(st);
+    scrubber->state = NULL;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Verify the next slice of the current region.
+ *
+ * A region is verified from start to end before moving on to the next one,
+ * so that at most one file is open at a time. The region is picked under the
+ * lock, but read and hashed without it so that adding, removing and the
+ * statistics are not held up by I/O; its pass state is only touched by the
+ * slice, and a region removed meanwhile is freed here.
+ *
+ * \param[in,out]   st: Pointer to the scrubber state
+ * \param[in]       slice: Maximum number of bytes to verify
+ * \param[out]      done: Number of bytes verified, 0 if there is no region
+ *                  or on read errors
+ * \param[out]      id: Identifier of the mismatching region
+ * \param[out]      expected: Expected checksum of the mismatching region
+ * \param[out]      actual: Checksum found for the mismatching region
+ * \return          `true` if the slice completed a pass that mismatched
+ */
+static bool scrubber_slice(scrubber_state_t* st, uint32_t slice,
+                           uint32_t* done, uint32_t* id, uint32_t* expected,
+                           uint32_t* actual) {
+    *done = 0;
+
+    crc_mutex_lock(&st->work);
+    crc_mutex_lock(&st->lock);
+    if (st->count == 0) {
+        crc_mutex_unlock(&st->lock);
+        crc_mutex_unlock(&st->work);
+        return false;
+    }
+    if (st->cursor >= st->count) {
+        st->cursor = 0;
+    }
+    scrubber_entry_t* entry = st->entries[st->cursor];
+    st->busy = entry;
+    crc_mutex_unlock(&st->lock);
+
+    uint64_t left = entry->len - entry->pos;
+    uint32_t n = left < slice ? (uint32_t)left : slice;
+    const uint8_t* data = entry->buf != NULL ? entry->buf + entry->pos
+                                             : st->io;
+    bool ok = true;
+
+    if (entry->buf == NULL) {
+        if (entry->fp == NULL) {
+            entry->fp = fopen(entry->path, "rb");
+            if (entry->fp != NULL
+                && crc_fseek(entry->fp, (int64_t)entry->offset, SEEK_SET)
+                       != 0) {
+                fclose(entry->fp);
+                entry->fp = NULL;
+            }
+        }
+        ok = entry->fp != NULL && fread(st->io, 1, n, entry->fp) == n;
+    }
+    if (ok) {
+        entry->reg = crc_batch_update(&entry->eng, entry->reg, data, n);
+        entry->pos += n;
+    }
+
+    bool pass = ok && entry->pos == entry->len;
+    uint32_t crc = pass ? crc_batch_final(&entry->eng, entry->reg) : 0;
+    bool mismatch = pass && crc != entry->expected;
+
+    if (!ok || pass) {
+        scrubber_rewind(entry);
+    }
+
+    crc_mutex_lock(&st->lock);
+    st->busy = NULL;
+    bool removed = entry->removed;
+    if (ok) {
+        st->stats.bytes += n;
+        *done = n;
+    } else {
+        st->stats.errors++;
+    }
+    if (pass) {
+        st->stats.passes++;
+    }
+    mismatch = mismatch && !removed;
+    if (mismatch) {
+        st->stats.mismatches++;
+        *id = entry->id;
+        *expected = entry->expected;
+        *actual = crc;
+    }
+    // A removed region left the cursor on the next one already
+    if ((!ok || pass) && !removed) {
+        st->cursor++;
+    }
+    crc_mutex_unlock(&st->lock);
+    crc_mutex_unlock(&st->work);
+
+    if (removed) {
+        scrubber_rewind(entry);
+        free(entry->path);
+        free(entry);
+    }
+
+    return mismatch;
+}
+
+/**
+ * \brief           Restart the pass of a region from its beginning.
+ *
+ * \param[in,out]   entry: Pointer to the region
+ */
+static void scrubber_rewind(scrubber_entry_t* entry) {
+    if (entry->fp != NULL) {
+        fclose(entry->fp);
+        entry->fp = NULL;
+    }
+    entry->reg = entry->eng.init;
+    entry->pos = 0;
+}
+
+/**
+ * \brief           Sleep in short quanta until the time is up or the worker
+ *                  is stopped.
+ *
+ * \param[in]       st: Pointer to the scrubber state
+ * \param[in]       seconds: Time to sleep in seconds
+ * \return          Time actually slept in seconds
+ */
+static double scrubber_sleep(scrubber_state_t* st, double seconds) {
+    double start = crc_time_now();
+    double now = start;
+
+    while (now - start < seconds && !atomic_load(&st->stop)) {
+        double left = seconds - (now - start);
+
+        crc_sleep(left < CRC_SCRUBBER_SLEEP_MAX ? left
+                                                : CRC_SCRUBBER_SLEEP_MAX);
+        now = crc_time_now();
+    }
+
+    return now - start;
+}
+
+/**
+ * \brief           Background worker: verify slices within the budgets.
+ *
+ * The byte budget is a token bucket holding at most one slice. The CPU
+ * budget is measured in thread CPU time: after a step that used `t` seconds
+ * of CPU the worker sleeps `t * (1 - share) / share` seconds, so time spent
+ * blocked on I/O does not count against it.
+ *
+ * \param[in]       arg: Pointer to the scrubber
+ * \return          NULL
+ */
+static void* scrubber_worker(void* arg) {
+    crc_scrubber_t* scrubber = arg;
+    scrubber_state_t* st = scrubber->state;
+    uint64_t rate = scrubber->cfg.bytes_per_sec;
+    double share = scrubber->cfg.cpu_share;
+    double tokens = 0;
+    double last = crc_time_now();
+
+    crc_thread_lower_priority();
+    while (!atomic_load(&st->stop)) {
+        uint64_t budget = scrubber->cfg.slice;
+        double throttled = 0;
+
+        if (rate != 0) {
+            double now = crc_time_now();
+
+            tokens += (now - last) * (double)rate;
+            last = now;
+            if (tokens > budget) {
+                tokens = (double)budget;
+            }
+            if (tokens < 1) {
+                throttled = scrubber_sleep(st, (1 - tokens) / (double)rate);
+                crc_mutex_lock(&st->lock);
+                st->stats.throttled += throttled;
+                crc_mutex_unlock(&st->lock);
+                continue;
+            }
+            budget = (uint64_t)tokens;
+        }
+
+        double start = crc_thread_cpu_time();
+        uint64_t done = crc_scrubber_step(scrubber, budget);
+        double elapsed = crc_thread_cpu_time() - start;
+
+        tokens -= (double)done;
+        if (done == 0) {
+            // Nothing to verify, or unreadable regions only: idle
+            scrubber_sleep(st, CRC_SCRUBBER_SLEEP_MAX);
+            continue;
+        }
+        if (share > 0 && share < 1) {
+            throttled = scrubber_sleep(st, elapsed * (1 - share) / share);
+            crc_mutex_lock(&st->lock);
+            st->stats.throttled += throttled;
+            crc_mutex_unlock(&st->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/* ----------------------------- end of file -------------------------------- */
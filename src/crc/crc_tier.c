@@ -0,0 +1,214 @@
+/**
+ * \file            crc_tier.c
+ * \brief           Table-size tiers of the lookup-table CRC engines
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include <stddef.h>
+#include "crc/crc_tier.h"
+#include "crc/crc16_lookup.h"
+#include "crc/crc32_lookup.h"
+#include "crc/crc8_lookup.h"
+#include "crc/crc_clmul.h"
+
+/* Private definitions ------------------------------------------------------ */
+/**
+ * \brief           Bytes per timed update.
+ *
+ * Kept below `CRC_CLMUL_MIN`, so that `crc16_lookup_update` runs the tables
+ * rather than the carry-less folding.
+ */
+#define CRC_TIER_CHUNK (CRC_CLMUL_MIN - 1)
+
+/**
+ * \brief           Updates between two reads of the clock.
+ */
+#define CRC_TIER_BURST 64
+
+/* Private variables -------------------------------------------------------- */
+/**
+ * \brief           The table tiers, smallest table first.
+ */
+static const crc_tier_e crc_tiers[CRC_TIER_COUNT] = {
+    CRC_TIER_NIBBLE, CRC_TIER_BYTE, CRC_TIER_SLICE4, CRC_TIER_SLICE8,
+    CRC_TIER_SLICE16,
+};
+
+/* Private function prototypes ---------------------------------------------- */
+static bool tier_max(uint8_t width, uint32_t* max, uint32_t* polys);
+static double tier_measure(uint8_t width, crc_tier_e tier, double seconds);
+
+/* Public functions --------------------------------------------------------- */
+bool crc_tier_is_valid(crc_tier_e tier) {
+    for (uint32_t i = 0; i < CRC_TIER_COUNT; i++) {
+        if (crc_tiers[i] == tier) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32_t crc_tier_table_bytes(uint8_t width, crc_tier_e tier) {
+    uint32_t max, polys;
+
+    if (!tier_max(width, &max, &polys) || !crc_tier_is_valid(tier)) {
+        return 0;
+    }
+
+    uint32_t entries = tier == CRC_TIER_NIBBLE ? 16 : (uint32_t)tier * 256;
+
+    return entries * (width / 8);
+}
+
+uint32_t crc_tier_report(uint8_t width, crc_tier_report_t reports[],
+                         double seconds) {
+    uint32_t max, polys;
+    uint32_t n = 0;
+
+    if (!tier_max(width, &max, &polys)) {
+        return 0;
+    }
+
+    // Both bit orders of each polynomial, `max` 256-entry tables each
+    uint32_t reserved = polys * 2 * max * 256 * (width / 8);
+
+    for (uint32_t i = 0; i < CRC_TIER_COUNT; i++) {
+        if ((uint32_t)crc_tiers[i] <= max) {
+            reports[n].tier = crc_tiers[i];
+            reports[n].table_bytes = crc_tier_table_bytes(width, crc_tiers[i]);
+            reports[n].static_bytes = reserved;
+            reports[n].bytes_per_sec = 0.0;
+            n++;
+        }
+    }
+
+    // Share the time evenly among the tiers
+    for (uint32_t i = 0; seconds > 0.0 && i < n; i++) {
+        reports[i].bytes_per_sec = tier_measure(width, reports[i].tier,
+                                                seconds / n);
+    }
+
+    return n;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Get the largest tier a width can select.
+ *
+ * \param[in]       width: CRC width in bits
+ * \param[out]      max: The `*_LOOKUP_SLICE_MAX` of the width
+ * \param[out]      polys: Number of polynomials with slicing tables, as in
+ *                  the lookup engine of the width
+ * \return          `true` if the width has a lookup engine, `false` otherwise
+ */
+static bool tier_max(uint8_t width, uint32_t* max, uint32_t* polys) {
+    switch (width) {
+    case 8:
+        *max = CRC8_LOOKUP_SLICE_MAX;
+        *polys = 2;
+        return true;
+    case 16:
+        *max = CRC16_LOOKUP_SLICE_MAX;
+        *polys = 3;
+        return true;
+    case 32:
+        *max = CRC32_LOOKUP_SLICE_MAX;
+        *polys = 1;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * \brief           Time the lookup engine of a width at one tier.
+ *
+ * The context is set up, and so the tables built, before the clock starts.
+ *
+ * \param[in]       width: CRC width in bits: 8, 16 or 32
+ * \param[in]       tier: The table tier, allowed for the width
+ * \param[in]       seconds: Measuring time
+ * \return          Throughput in bytes per second
+ */
+static double tier_measure(uint8_t width, crc_tier_e tier, double seconds) {
+    crc8_lookup_ctx_t ctx8;
+    crc16_lookup_ctx_t ctx16;
+    crc32_lookup_ctx_t ctx32;
+    uint8_t buf[CRC_TIER_CHUNK];
+    uint64_t bytes = 0;
+    double elapsed;
+
+    for (uint32_t i = 0; i < CRC_TIER_CHUNK; i++) {
+        buf[i] = (uint8_t)(i * 131 + 17);
+    }
+
+    // Only the tables of the measured width are built
+    switch (width) {
+    case 8:
+        crc8_lookup_init(&ctx8, CRC8_LOOKUP_MODEL);
+        crc8_lookup_set_tier(&ctx8, tier);
+        break;
+    case 16:
+        crc16_lookup_init(&ctx16, CRC16_IBM_LOOKUP_MODEL);
+        crc16_lookup_set_tier(&ctx16, tier);
+        break;
+    default:
+        crc32_lookup_init(&ctx32, CRC32_LOOKUP_MODEL);
+        crc32_lookup_set_tier(&ctx32, tier);
+        break;
+    }
+
+    double start = crc_time_now();
+    do {
+        for (uint32_t i = 0; i < CRC_TIER_BURST; i++) {
+            switch (width) {
+            case 8:
+                crc8_lookup_update(&ctx8, buf, CRC_TIER_CHUNK);
+                break;
+            case 16:
+                crc16_lookup_update(&ctx16, buf, CRC_TIER_CHUNK);
+                break;
+            default:
+                crc32_lookup_update(&ctx32, buf, CRC_TIER_CHUNK);
+                break;
+            }
+        }
+        bytes += CRC_TIER_BURST * CRC_TIER_CHUNK;
+        elapsed = crc_time_now() - start;
+    } while (elapsed < seconds);
+
+    return elapsed > 0.0 ? (double)bytes / elapsed : 0.0;
+}
+
+/* ----------------------------- end of file -------------------------------- */
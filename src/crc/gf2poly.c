@@ -0,0 +1,298 @@
+/**
+ * \file            gf2poly.c
+ * \brief           Polynomial arithmetic over GF(2)
+ * \date            2026-10-19
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+/* includes ----------------------------------------------------------------- */
+#include "crc_port.h" // Must come first, see crc_port.h
+#include "crc/gf2poly.h"
+#if CRC_HAVE_CLMUL
+#include <immintrin.h>
+#endif
+
+/* Private function prototypes ---------------------------------------------- */
+static void gf2poly_clmul_soft(uint64_t a, uint64_t b, uint64_t* hi,
+                               uint64_t* lo);
+#if CRC_HAVE_CLMUL
+static void gf2poly_clmul_hw(uint64_t a, uint64_t b, uint64_t* hi,
+                             uint64_t* lo);
+static uint64_t gf2poly_barrett_hw(const gf2poly_barrett_t* barrett,
+                                   uint64_t hi, uint64_t lo);
+#endif
+static uint64_t gf2poly_mask(uint8_t width);
+static uint64_t gf2poly_shr(uint64_t hi, uint64_t lo, uint8_t n);
+
+/* Public functions --------------------------------------------------------- */
+bool gf2poly_has_clmul(void) {
+    return crc_cpu_has_clmul();
+}
+
+void gf2poly_clmul(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo) {
+#if CRC_HAVE_CLMUL
+    if (crc_cpu_has_clmul()) {
+        gf2poly_clmul_hw(a, b, hi, lo);
+        return;
+    }
+#endif
+    gf2poly_clmul_soft(a, b, hi, lo);
+}
+
+uint64_t gf2poly_mulmod(uint64_t a, uint64_t b, uint64_t poly, uint8_t width) {
+    uint64_t top = (uint64_t)1 << (width - 1);
+    uint64_t mask = gf2poly_mask(width);
+    uint64_t r = 0;
+
+    for (int bit = width - 1; bit >= 0; bit--) {
+        r = (r & top) ? ((r << 1) ^ poly) & mask : (r << 1) & mask;
+        if ((b >> bit) & 1) {
+            r ^= a;
+        }
+    }
+
+    return r;
+}
+
+uint64_t gf2poly_powmod(uint64_t a, uint64_t n, uint64_t poly, uint8_t width) {
+    gf2poly_barrett_t barrett;
+    uint64_t result = 1;
+
+    gf2poly_barrett_init(&barrett, poly, width);
+
+    // Square-and-multiply over the bits of n
+    for (; n != 0; n >>= 1) {
+        if (n & 1) {
+            result = gf2poly_barrett_mulmod(&barrett, result, a);
+        }
+        if (n > 1) {
+            a = gf2poly_barrett_mulmod(&barrett, a, a);
+        }
+    }
+
+    return result;
+}
+
+uint64_t gf2poly_xpow(uint64_t n, uint64_t poly, uint8_t width) {
+    // x mod P is x itself, or the x^0 term of P when P = x + p
+    return gf2poly_powmod(width > 1 ? 2 : poly & 1, n, poly, width);
+}
+
+uint64_t gf2poly_xpow8n(uint64_t n, uint64_t poly, uint8_t width) {
+    return gf2poly_powmod(gf2poly_xpow(8, poly, width), n, poly, width);
+}
+
+uint64_t gf2poly_xinv(uint64_t poly, uint8_t width) {
+    if ((poly & 1) == 0) {
+        return 0;
+    }
+
+    // x * (x^(w-1) + p / x) = x^w + p + 1 = 1 mod P
+    return (poly >> 1) | ((uint64_t)1 << (width - 1));
+}
+
+void gf2poly_barrett_init(gf2poly_barrett_t* barrett, uint64_t poly,
+                          uint8_t width) {
+    uint64_t top = (uint64_t)1 << (width - 1);
+    uint64_t mask = gf2poly_mask(width);
+    uint64_t reg = 0;
+    uint64_t quot = 0;
+
+    // Long division of x^(2w) by P, one dividend bit at a time; the
+    // quotient has degree w, its x^w term is implied
+    for (uint32_t i = 0; i <= 2u * width; i++) {
+        uint64_t out = reg & top;
+
+        reg = ((reg << 1) | (i == 0)) & mask;
+        if (out != 0) {
+            reg ^= poly;
+        }
+        quot = (quot << 1) | (out != 0);
+    }
+
+    barrett->poly = poly & mask;
+    barrett->mu = quot & mask;
+    barrett->width = width;
+}
+
+uint64_t gf2poly_barrett_reduce(const gf2poly_barrett_t* barrett, uint64_t hi,
+                                uint64_t lo) {
+#if CRC_HAVE_CLMUL
+    if (crc_cpu_has_clmul()) {
+        return gf2poly_barrett_hw(barrett, hi, lo);
+    }
+#endif
+    uint8_t width = barrett->width;
+    uint64_t h = gf2poly_shr(hi, lo, width);
+    uint64_t qh;
+    uint64_t ql;
+
+    // q = T / P = (T / x^w) * (x^w + mu) / x^w, exact for deg T < 2w
+    gf2poly_clmul_soft(h, barrett->mu, &qh, &ql);
+    uint64_t q = h ^ gf2poly_shr(qh, ql, width);
+
+    // T - q * P: q * x^w only has terms of x^w and up
+    gf2poly_clmul_soft(q, barrett->poly, &qh, &ql);
+
+    return (lo ^ ql) & gf2poly_mask(width);
+}
+
+uint64_t gf2poly_barrett_mulmod(const gf2poly_barrett_t* barrett, uint64_t a,
+                                uint64_t b) {
+#if CRC_HAVE_CLMUL
+    if (crc_cpu_has_clmul()) {
+        uint64_t hi;
+        uint64_t lo;
+
+        gf2poly_clmul_hw(a, b, &hi, &lo);
+        return gf2poly_barrett_hw(barrett, hi, lo);
+    }
+#endif
+    // Shift-and-add costs less than three software carry-less multiplies
+    return gf2poly_mulmod(a, b, barrett->poly, barrett->width);
+}
+
+void gf2poly_powers_init(gf2poly_powers_t* powers, uint64_t base,
+                         uint64_t poly, uint8_t width) {
+    gf2poly_barrett_init(&powers->barrett, poly, width);
+    powers->pow[0] = base;
+    for (uint32_t k = 1; k < GF2POLY_POWERS; k++) {
+        powers->pow[k] = gf2poly_barrett_mulmod(
+            &powers->barrett, powers->pow[k - 1], powers->pow[k - 1]);
+    }
+}
+
+uint64_t gf2poly_powers_get(const gf2poly_powers_t* powers, uint64_t n) {
+    return gf2poly_powers_mul(powers, 1, n);
+}
+
+uint64_t gf2poly_powers_mul(const gf2poly_powers_t* powers, uint64_t a,
+                            uint64_t n) {
+    for (uint32_t k = 0; n != 0; k++, n >>= 1) {
+        if (n & 1) {
+            a = gf2poly_barrett_mulmod(&powers->barrett, a, powers->pow[k]);
+        }
+    }
+
+    return a;
+}
+
+/* Private functions -------------------------------------------------------- */
+/**
+ * \brief           Portable carry-less multiply, one bit of `b` at a time.
+ *
+ * \param[in]       a: First factor
+ * \param[in]       b: Second factor
+ * \param[out]      hi: High half of the product
+ * \param[out]      lo: Low half of the product
+ */
+static void gf2poly_clmul_soft(uint64_t a, uint64_t b, uint64_t* hi,
+                               uint64_t* lo) {
+    uint64_t h = 0;
+    uint64_t l = a & (0 - (b & 1));
+
+    for (uint32_t i = 1; i < 64; i++) {
+        uint64_t m = 0 - ((b >> i) & 1);
+
+        l ^= (a << i) & m;
+        h ^= (a >> (64 - i)) & m;
+    }
+    *hi = h;
+    *lo = l;
+}
+
+#if CRC_HAVE_CLMUL
+/**
+ * \brief           Carry-less multiply with PCLMULQDQ.
+ *
+ * \param[in]       a: First factor
+ * \param[in]       b: Second factor
+ * \param[out]      hi: High half of the product
+ * \param[out]      lo: Low half of the product
+ */
+CRC_TARGET_CLMUL
+static void gf2poly_clmul_hw(uint64_t a, uint64_t b, uint64_t* hi,
+                             uint64_t* lo) {
+    __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a),
+                                     _mm_cvtsi64_si128((long long)b), 0x00);
+
+    *lo = (uint64_t)_mm_cvtsi128_si64(p);
+    *hi = (uint64_t)_mm_extract_epi64(p, 1);
+}
+
+/**
+ * \brief           Barrett reduction with PCLMULQDQ, as in
+ *                  `gf2poly_barrett_reduce`.
+ *
+ * \param[in]       barrett: Pointer to the constants of P
+ * \param[in]       hi: Coefficients of x^64 and up
+ * \param[in]       lo: Coefficients of x^0 to x^63
+ * \return          The polynomial mod P
+ */
+CRC_TARGET_CLMUL
+static uint64_t gf2poly_barrett_hw(const gf2poly_barrett_t* barrett,
+                                   uint64_t hi, uint64_t lo) {
+    uint8_t width = barrett->width;
+    uint64_t h = gf2poly_shr(hi, lo, width);
+    uint64_t qh;
+    uint64_t ql;
+
+    gf2poly_clmul_hw(h, barrett->mu, &qh, &ql);
+    uint64_t q = h ^ gf2poly_shr(qh, ql, width);
+
+    gf2poly_clmul_hw(q, barrett->poly, &qh, &ql);
+
+    return (lo ^ ql) & gf2poly_mask(width);
+}
+#endif
+
+/**
+ * \brief           Get the mask of the coefficients below x^width.
+ *
+ * \param[in]       width: Degree, 1 to 64
+ * \return          The mask
+ */
+static uint64_t gf2poly_mask(uint8_t width) {
+    return (((uint64_t)1 << (width - 1)) << 1) - 1;
+}
+
+/**
+ * \brief           Divide a 128-bit polynomial by x^n, n from 1 to 64.
+ *
+ * \param[in]       hi: High half of the polynomial
+ * \param[in]       lo: Low half of the polynomial
+ * \param[in]       n: The shift
+ * \return          The low 64 bits of the quotient
+ */
+static uint64_t gf2poly_shr(uint64_t hi, uint64_t lo, uint8_t n) {
+    return n == 64 ? hi : (hi << (64 - n)) | (lo >> n);
+}
+
+/* ----------------------------- end of file -------------------------------- */
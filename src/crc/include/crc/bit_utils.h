@@ -87,6 +87,14 @@ uint16_t reverse_bits_16(uint16_t data);
  * \return          32-bit unsigned integer with the bits reversed.
  */
 uint32_t reverse_bits_32(uint32_t data);
+
+/**
+ * \brief           Reverses the bits of a 64-bit unsigned integer.
+ *
+ * \param[in]       data: 64-bit unsigned integer to be reversed.
+ * \return          64-bit unsigned integer with the bits reversed.
+ */
+uint64_t reverse_bits_64(uint64_t data);
 /**
  * \}
  */
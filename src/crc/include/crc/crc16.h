@@ -87,6 +87,22 @@ typedef struct {
     bool ref_out;     /*!< Whether to reverse the output data bits */
 } crc16_ctx_t;
 
+/**
+ * \brief           CRC16 streaming verification context.
+ *
+ * Tracks a CRC16 over a byte stream so that `crc16_verify_stream` can tell at
+ * any byte boundary whether the bytes seen so far form a frame followed by its
+ * little-endian CRC16 trailer, as written by `crc16_pack_buf`.
+ */
+typedef struct {
+    crc16_ctx_t ctx;  /*!< Running CRC16 context */
+    uint16_t residue; /*!< Expected CRC16 over data + trailer */
+    uint8_t tail[2];  /*!< Last 2 bytes, held back from `ctx` when the
+                           model has no little-endian residue */
+    bool use_residue; /*!< Whether the trailer cancels into `residue` */
+    uint32_t len;     /*!< Number of bytes seen */
+} crc16_stream_t;
+
 /* Public functions --------------------------------------------------------- */
 
 /**
@@ -170,6 +186,86 @@ void crc16_pack_buf(crc16_param_model_e model, uint8_t* buf, uint32_t len);
 bool crc16_verify_buf(crc16_param_model_e model, const uint8_t* buf,
                       uint32_t len);
 
+/**
+ * \brief           Get the residue of a CRC16 model.
+ *
+ * The residue is the CRC16 calculated over data followed by its own CRC16
+ * trailer; it is the same constant for every valid frame. Reflected models
+ * cancel with the little-endian trailer written by `crc16_pack_buf`,
+ * non-reflected models only with a big-endian trailer, for which their residue
+ * is given.
+ *
+ * \param[in]       model: The CRC16 model
+ * \return          The residue of the model
+ */
+uint16_t crc16_residue(crc16_param_model_e model);
+
+/**
+ * \brief           Initialize a CRC16 streaming verification context.
+ *
+ * \param[out]      stream: Pointer to the streaming context to be initialized
+ * \param[in]       model: The CRC16 model to use for verification
+ */
+void crc16_verify_stream_init(crc16_stream_t* stream,
+                              crc16_param_model_e model);
+
+/**
+ * \brief           Feed bytes of a frame to a CRC16 streaming context.
+ *
+ * \param[in,out]   stream: Pointer to the streaming context
+ * \param[in]       buf: Pointer to the received bytes
+ * \param[in]       len: Number of received bytes
+ */
+void crc16_verify_stream_update(crc16_stream_t* stream, const uint8_t* buf,
+                                uint32_t len);
+
+/**
+ * \brief           Check whether the bytes seen so far form a valid frame.
+ *
+ * The frame layout is the one of `crc16_verify_buf`: data followed by the
+ * CRC16 trailer. The check costs the same at any byte boundary and does not
+ * rescan the data.
+ *
+ * \param[in]       stream: Pointer to the streaming context
+ * \return          `true` if the checksum is correct, `false` otherwise
+ */
+bool crc16_verify_stream(const crc16_stream_t* stream);
+
+/**
+ * \brief           Verify an array of frames in one call.
+ *
+ * Each frame has the layout of `crc16_verify_buf`. The model is resolved once
+ * for the whole batch and the CRC chains of several frames are interleaved,
+ * which pays off for large numbers of short frames.
+ *
+ * Bit `i % 64` of `ok_bitmap[i / 64]` is set when frame `i` is valid; all
+ * `(n + 63) / 64` words of the bitmap are written.
+ *
+ * \param[in]       model: The CRC16 model to use for verification
+ * \param[in]       bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ * \param[out]      ok_bitmap: Bitmap of the valid frames
+ * \return          Number of valid frames
+ */
+uint32_t crc16_verify_bufs(crc16_param_model_e model,
+                           const uint8_t* const bufs[], const uint32_t lens[],
+                           uint32_t n, uint64_t* ok_bitmap);
+
+/**
+ * \brief           Pack the CRC16 trailer of an array of frames in one call.
+ *
+ * Each frame is packed as by `crc16_pack_buf`; frames too short to hold the
+ * trailer are left unchanged.
+ *
+ * \param[in]       model: The CRC16 model to use
+ * \param[in,out]   bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ */
+void crc16_pack_bufs(crc16_param_model_e model, uint8_t* const bufs[],
+                     const uint32_t lens[], uint32_t n);
+
 /**
  * \}
  */
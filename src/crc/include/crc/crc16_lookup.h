@@ -44,6 +44,7 @@
 /* includes ----------------------------------------------------------------- */
 #include <stdbool.h>
 #include <stdint.h>
+#include "crc/crc_tier.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,30 @@ extern "C" {
  * \{
  */
 
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Default table tier of `crc16_lookup_init`, a `crc_tier_e`.
+ *
+ * 0, the default, keeps the built-in 16-entry nibble tables. Any other tier
+ * reads as many 256-entry tables of the polynomial and bit order, 512 bytes
+ * each, built on first use. Must not exceed `CRC16_LOOKUP_SLICE_MAX`.
+ */
+#ifndef CRC16_LOOKUP_SLICE
+#define CRC16_LOOKUP_SLICE 0
+#endif
+
+/**
+ * \brief           Largest table tier a CRC16 lookup context can select.
+ *
+ * Bounds the static tables held for the tiers: 3 polynomials by 2 bit orders by
+ * this many 256-entry tables, 24 KiB at 8, 48 KiB at 16 and none at 0, where
+ * only the nibble tier remains. Defaults to the default tier, so slicing is
+ * opt-in: raise it to allow the byte and slicing tiers up to it.
+ */
+#ifndef CRC16_LOOKUP_SLICE_MAX
+#define CRC16_LOOKUP_SLICE_MAX CRC16_LOOKUP_SLICE
+#endif
+
 /* Public typedefs ---------------------------------------------------------- */
 /**
  * \brief           Enumeration of available CRC16 lookup models.
@@ -90,7 +115,8 @@ typedef struct {
     uint16_t poly;      /*!< Polynomial used in CRC16 calculation */
     bool ref_in;        /*!< Whether to reverse the input data bits */
     bool ref_out;       /*!< Whether to reverse the output data bits */
-    uint16_t table_len; /*!< Length of the CRC16 lookup table */
+    uint16_t table_len; /*!< Length of the CRC16 lookup table: 16 for a
+                             nibble table, 256 per slice otherwise */
     uint16_t* table;    /*!< Pointer to the CRC16 lookup table */
 } crc16_lookup_ctx_t;
 
@@ -109,6 +135,18 @@ typedef struct {
 void crc16_lookup_init(crc16_lookup_ctx_t* ctx,
                        crc16_lookup_param_model_e model);
 
+/**
+ * \brief           Select the table tier of a CRC16 lookup context.
+ *
+ * The running CRC is kept, so the tier can change between updates.
+ *
+ * \param[in,out]   ctx: Pointer to an initialized CRC16 lookup context
+ * \param[in]       tier: The table tier
+ * \return          `true` on success, `false` if the tier is invalid or above
+ *                  `CRC16_LOOKUP_SLICE_MAX`, or the context has no table
+ */
+bool crc16_lookup_set_tier(crc16_lookup_ctx_t* ctx, crc_tier_e tier);
+
 /**
  * \brief           Update the CRC16 calculation with new data.
  *
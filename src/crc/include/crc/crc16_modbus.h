@@ -0,0 +1,182 @@
+/**
+ * \file            crc16_modbus.h
+ * \brief           Modbus RTU stream framer driven by CRC16 (MODBUS)
+ * \date            2026-10-18
+ *
+ * This file provides a framer that recovers Modbus RTU frame boundaries from a
+ * byte stream without relying on the 3.5-character inter-frame silence. Every
+ * byte offset whose address and function code look plausible is tracked as a
+ * candidate frame start; the function-code length rules give the candidate's
+ * end, and `CRC16_MODBUS_MODEL` decides whether the candidate is a frame.
+ *
+ * A single running CRC16 is kept over the whole stream. The CRC of a candidate
+ * is derived from the running value at its start and end by CRC linearity, so
+ * no byte is processed more than once regardless of the number of candidates.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the crc16 library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC16_MODBUS_H__
+#define __CRC16_MODBUS_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc16_modbus_manager CRC16 Modbus RTU Framer
+ * \brief           Recovers Modbus RTU frames from a byte stream.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Maximum Modbus RTU frame (ADU) length in bytes.
+ */
+#define CRC16_MODBUS_ADU_MAX   256
+
+/**
+ * \brief           Maximum number of pending candidate events.
+ *
+ * Each byte creates at most one event per direction and an event lives for at
+ * most `CRC16_MODBUS_ADU_MAX` bytes. Candidates beyond this limit are dropped
+ * and counted in `dropped`.
+ */
+#ifndef CRC16_MODBUS_EVENT_MAX
+#define CRC16_MODBUS_EVENT_MAX 1024
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Direction of the Modbus traffic to be framed.
+ *
+ * Requests and responses of the same function code have different lengths.
+ */
+typedef enum {
+    CRC16_MODBUS_REQUEST = 0x01,  /*!< Master to slave frames */
+    CRC16_MODBUS_RESPONSE = 0x02, /*!< Slave to master frames */
+    CRC16_MODBUS_BOTH = 0x03,     /*!< Mixed traffic */
+} crc16_modbus_dir_e;
+
+/**
+ * \brief           Modbus RTU frame found by the framer.
+ */
+typedef struct {
+    uint64_t offset;     /*!< Offset of the frame in the stream */
+    uint16_t len;        /*!< Length of the frame including its CRC */
+    const uint8_t* data; /*!< Frame inside the chunk passed to
+                              `crc16_modbus_framer_feed`, or NULL if the frame
+                              started in an earlier chunk */
+} crc16_modbus_frame_t;
+
+/**
+ * \brief           Callback invoked for every frame found.
+ *
+ * \param[in]       arg: User argument given to `crc16_modbus_framer_init`
+ * \param[in]       frame: The frame found
+ */
+typedef void (*crc16_modbus_frame_fn)(void* arg,
+                                      const crc16_modbus_frame_t* frame);
+
+/**
+ * \brief           Pending action on a candidate frame.
+ */
+typedef struct {
+    uint64_t start;   /*!< Stream offset of the candidate start */
+    uint16_t seed;    /*!< CRC16 init XOR running CRC16 at the start */
+    uint16_t next;    /*!< Next event in the slot + 1, 0 ends the list */
+    uint16_t len;     /*!< Frame length, or base length for a resolve */
+    uint8_t count_at; /*!< Offset of the byte count field, 0 for a check */
+    uint8_t count_sz; /*!< Size of the byte count field in bytes */
+} crc16_modbus_event_t;
+
+/**
+ * \brief           Modbus RTU stream framer context.
+ */
+typedef struct {
+    crc16_modbus_dir_e dir;         /*!< Direction of the framed traffic */
+    crc16_modbus_frame_fn on_frame; /*!< Frame callback */
+    void* arg;                      /*!< Frame callback argument */
+    uint64_t pos;                   /*!< Number of bytes consumed */
+    uint64_t frame_end;             /*!< End offset of the last frame found */
+    uint16_t crc;                   /*!< Running CRC16 register, init 0 */
+    uint16_t crc_prev;              /*!< Running CRC16 before the last byte */
+    uint8_t last;                   /*!< Last byte consumed */
+    uint16_t free_head;             /*!< Free event list + 1, 0 if empty */
+    uint16_t slot[CRC16_MODBUS_ADU_MAX]; /*!< Events due, by offset */
+    crc16_modbus_event_t events[CRC16_MODBUS_EVENT_MAX]; /*!< Event pool */
+    uint16_t table[256];                      /*!< Byte-wise CRC16 table */
+    uint16_t shift[CRC16_MODBUS_ADU_MAX + 1]; /*!< x^(8n) mod P */
+    uint64_t frames;                /*!< Number of frames found */
+    uint64_t skipped;               /*!< Number of bytes outside any frame */
+    uint64_t dropped;               /*!< Candidates dropped, pool exhausted */
+} crc16_modbus_framer_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize a Modbus RTU stream framer.
+ *
+ * \param[out]      framer: Pointer to the framer to be initialized
+ * \param[in]       dir: Direction of the traffic to be framed
+ * \param[in]       on_frame: Callback invoked for every frame found
+ * \param[in]       arg: Argument passed to the callback
+ */
+void crc16_modbus_framer_init(crc16_modbus_framer_t* framer,
+                              crc16_modbus_dir_e dir,
+                              crc16_modbus_frame_fn on_frame, void* arg);
+
+/**
+ * \brief           Feed a chunk of the stream to the framer.
+ *
+ * Chunks can have any size and cut frames anywhere. Frames are reported in
+ * stream order as soon as their last byte has been fed; overlapping candidates
+ * of a reported frame are discarded.
+ *
+ * \param[in,out]   framer: Pointer to the framer
+ * \param[in]       buf: Pointer to the chunk
+ * \param[in]       len: Length of the chunk in bytes
+ */
+void crc16_modbus_framer_feed(crc16_modbus_framer_t* framer,
+                              const uint8_t* buf, uint32_t len);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC16_MODBUS_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,186 @@
+/**
+ * \file            crc16_prefix.h
+ * \brief           CRC16 prefix snapshots for frames sharing a constant header
+ * \date            2026-10-18
+ *
+ * This file provides functions to snapshot a CRC16 context after a fixed
+ * prefix (e.g. a Modbus RTU slave address and function code) and to resume the
+ * calculation over only the variable tail of a frame. A small keyed cache keeps
+ * the snapshots of the most frequently used prefixes.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the crc16 library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC16_PREFIX_H__
+#define __CRC16_PREFIX_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc16_prefix_manager CRC16 Prefix Manager
+ * \brief           Manages CRC16 snapshots of constant frame prefixes.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Maximum prefix length in bytes that can be cached.
+ *
+ * Covers the Modbus RTU address/function header and the 8-byte DNP3 link
+ * header. Longer prefixes bypass the cache.
+ */
+#ifndef CRC16_PREFIX_KEY_MAX
+#define CRC16_PREFIX_KEY_MAX 8
+#endif
+
+/**
+ * \brief           Number of consecutive cache slots probed per lookup.
+ */
+#ifndef CRC16_PREFIX_CACHE_PROBE
+#define CRC16_PREFIX_CACHE_PROBE 4
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           CRC16 context snapshot taken after a fixed prefix.
+ *
+ * The snapshot holds the running (not yet finalized) CRC16 context, so the
+ * same prefix can be resumed any number of times.
+ */
+typedef struct {
+    crc16_ctx_t ctx; /*!< CRC16 context after processing the prefix */
+    uint32_t len;    /*!< Length of the prefix in bytes */
+} crc16_prefix_t;
+
+/**
+ * \brief           Entry of the CRC16 prefix cache.
+ */
+typedef struct {
+    crc16_prefix_t prefix;             /*!< Snapshot of the cached prefix */
+    uint8_t key[CRC16_PREFIX_KEY_MAX]; /*!< Prefix bytes used as key */
+    uint8_t key_len;                   /*!< Number of valid key bytes, 0 if
+                                            the entry is empty */
+    uint8_t model;                     /*!< CRC16 model of the snapshot */
+    uint16_t hits;                     /*!< Saturating hit counter */
+} crc16_prefix_entry_t;
+
+/**
+ * \brief           Keyed cache of CRC16 prefix snapshots.
+ *
+ * The cache keeps the most frequently used prefixes. An entry is only
+ * replaced once its hit counter has decayed to zero, so a burst of one-off
+ * prefixes cannot flush the hot ones.
+ */
+typedef struct {
+    crc16_prefix_entry_t* entries; /*!< Entry storage provided by the caller */
+    uint32_t capacity;             /*!< Number of entries, a power of two */
+    uint32_t hits;                 /*!< Number of lookups served from cache */
+    uint32_t misses;               /*!< Number of lookups that missed */
+} crc16_prefix_cache_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Snapshot the CRC16 context after a fixed prefix.
+ *
+ * \param[out]      prefix: Pointer to the snapshot to be initialized
+ * \param[in]       model: The CRC16 model to use
+ * \param[in]       buf: Pointer to the prefix bytes
+ * \param[in]       len: Length of the prefix in bytes
+ */
+void crc16_prefix_init(crc16_prefix_t* prefix, crc16_param_model_e model,
+                       const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Calculate the CRC16 of prefix + tail from a snapshot.
+ *
+ * Only the tail bytes are processed. The snapshot is left unchanged.
+ *
+ * \param[in]       prefix: Pointer to the prefix snapshot
+ * \param[in]       buf: Pointer to the tail bytes following the prefix
+ * \param[in]       len: Length of the tail in bytes
+ * \return          The CRC16 checksum of the whole frame
+ */
+uint16_t crc16_prefix_calculate(const crc16_prefix_t* prefix,
+                                const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Initialize a CRC16 prefix cache.
+ *
+ * \param[out]      cache: Pointer to the cache to be initialized
+ * \param[in]       entries: Pointer to the entry storage
+ * \param[in]       capacity: Number of entries, must be a power of two
+ * \return          `true` on success, `false` if the arguments are invalid
+ */
+bool crc16_prefix_cache_init(crc16_prefix_cache_t* cache,
+                             crc16_prefix_entry_t* entries, uint32_t capacity);
+
+/**
+ * \brief           Drop all cached prefixes and reset the statistics.
+ *
+ * \param[in,out]   cache: Pointer to the cache
+ */
+void crc16_prefix_cache_clear(crc16_prefix_cache_t* cache);
+
+/**
+ * \brief           Calculate the CRC16 of a frame using the prefix cache.
+ *
+ * The first `prefix_len` bytes of the frame are looked up in the cache. On a
+ * hit only the remaining bytes are processed. Prefixes longer than
+ * `CRC16_PREFIX_KEY_MAX` bypass the cache.
+ *
+ * \param[in,out]   cache: Pointer to the cache
+ * \param[in]       model: The CRC16 model to use
+ * \param[in]       buf: Pointer to the frame
+ * \param[in]       len: Length of the frame in bytes
+ * \param[in]       prefix_len: Length of the constant prefix in bytes
+ * \return          The CRC16 checksum of the whole frame
+ */
+uint16_t crc16_prefix_cache_calculate(crc16_prefix_cache_t* cache,
+                                      crc16_param_model_e model,
+                                      const uint8_t* buf, uint32_t len,
+                                      uint32_t prefix_len);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC16_PREFIX_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -78,6 +78,22 @@ typedef struct {
     bool ref_out;     /*!< Whether to reverse the output data bits */
 } crc32_ctx_t;
 
+/**
+ * \brief           CRC32 streaming verification context.
+ *
+ * Tracks a CRC32 over a byte stream so that `crc32_verify_stream` can tell at
+ * any byte boundary whether the bytes seen so far form a frame followed by its
+ * little-endian CRC32 trailer, as written by `crc32_pack_buf`.
+ */
+typedef struct {
+    crc32_ctx_t ctx;  /*!< Running CRC32 context */
+    uint32_t residue; /*!< Expected CRC32 over data + trailer */
+    uint8_t tail[4];  /*!< Last 4 bytes, held back from `ctx` when the
+                           model has no little-endian residue */
+    bool use_residue; /*!< Whether the trailer cancels into `residue` */
+    uint32_t len;     /*!< Number of bytes seen */
+} crc32_stream_t;
+
 /* Public functions --------------------------------------------------------- */
 /**
  * \brief           Initialize the CRC32 context with the specified model.
@@ -155,6 +171,126 @@ void crc32_pack_buf(crc32_param_model_e model, uint8_t* buf, uint32_t len);
  */
 bool crc32_verify_buf(crc32_param_model_e model, const uint8_t* buf,
                       uint32_t len);
+
+/**
+ * \brief           Get the residue of a CRC32 model.
+ *
+ * The residue is the CRC32 calculated over data followed by its own CRC32
+ * trailer; it is the same constant for every valid frame. Reflected models
+ * cancel with the little-endian trailer written by `crc32_pack_buf`,
+ * non-reflected models only with a big-endian trailer, for which their residue
+ * is given.
+ *
+ * \param[in]       model: The CRC32 model
+ * \return          The residue of the model
+ */
+uint32_t crc32_residue(crc32_param_model_e model);
+
+/**
+ * \brief           Initialize a CRC32 streaming verification context.
+ *
+ * \param[out]      stream: Pointer to the streaming context to be initialized
+ * \param[in]       model: The CRC32 model to use for verification
+ */
+void crc32_verify_stream_init(crc32_stream_t* stream,
+                              crc32_param_model_e model);
+
+/**
+ * \brief           Feed bytes of a frame to a CRC32 streaming context.
+ *
+ * \param[in,out]   stream: Pointer to the streaming context
+ * \param[in]       buf: Pointer to the received bytes
+ * \param[in]       len: Number of received bytes
+ */
+void crc32_verify_stream_update(crc32_stream_t* stream, const uint8_t* buf,
+                                uint32_t len);
+
+/**
+ * \brief           Check whether the bytes seen so far form a valid frame.
+ *
+ * The frame layout is the one of `crc32_verify_buf`: data followed by the
+ * CRC32 trailer. The check costs the same at any byte boundary and does not
+ * rescan the data.
+ *
+ * \param[in]       stream: Pointer to the streaming context
+ * \return          `true` if the checksum is correct, `false` otherwise
+ */
+bool crc32_verify_stream(const crc32_stream_t* stream);
+/**
+ * \brief           Verify an array of frames in one call.
+ *
+ * Each frame has the layout of `crc32_verify_buf`. The model is resolved once
+ * for the whole batch and the CRC chains of several frames are interleaved,
+ * which pays off for large numbers of short frames.
+ *
+ * Bit `i % 64` of `ok_bitmap[i / 64]` is set when frame `i` is valid; all
+ * `(n + 63) / 64` words of the bitmap are written.
+ *
+ * \param[in]       model: The CRC32 model to use for verification
+ * \param[in]       bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ * \param[out]      ok_bitmap: Bitmap of the valid frames
+ * \return          Number of valid frames
+ */
+uint32_t crc32_verify_bufs(crc32_param_model_e model,
+                           const uint8_t* const bufs[], const uint32_t lens[],
+                           uint32_t n, uint64_t* ok_bitmap);
+
+/**
+ * \brief           Pack the CRC32 trailer of an array of frames in one call.
+ *
+ * Each frame is packed as by `crc32_pack_buf`; frames too short to hold the
+ * trailer are left unchanged.
+ *
+ * \param[in]       model: The CRC32 model to use
+ * \param[in,out]   bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ */
+void crc32_pack_bufs(crc32_param_model_e model, uint8_t* const bufs[],
+                     const uint32_t lens[], uint32_t n);
+
+/**
+ * \brief           Calculate the combine operator for a given second length.
+ *
+ * The operator only depends on the model and `len2`; it can be reused by
+ * `crc32_combine_op` for any number of blocks of the same length.
+ *
+ * \param[in]       model: The CRC32 model
+ * \param[in]       len2: Length in bytes of the second block
+ * \return          The combine operator (x^(8 * len2) modulo the polynomial)
+ */
+uint32_t crc32_combine_gen(crc32_param_model_e model, uint64_t len2);
+
+/**
+ * \brief           Combine two CRC32 checksums with a precomputed operator.
+ *
+ * \param[in]       model: The CRC32 model of both checksums
+ * \param[in]       crc1: CRC32 of the first block
+ * \param[in]       crc2: CRC32 of the second block
+ * \param[in]       op: Operator from `crc32_combine_gen` for the length of
+ *                  the second block
+ * \return          CRC32 of the first block followed by the second block
+ */
+uint32_t crc32_combine_op(crc32_param_model_e model, uint32_t crc1,
+                          uint32_t crc2, uint32_t op);
+
+/**
+ * \brief           Combine the CRC32 checksums of two consecutive blocks.
+ *
+ * Calculates the CRC32 of the concatenation of two blocks from their
+ * checksums and the length of the second block only, in O(log(len2)).
+ *
+ * \param[in]       model: The CRC32 model of both checksums
+ * \param[in]       crc1: CRC32 of the first block
+ * \param[in]       crc2: CRC32 of the second block
+ * \param[in]       len2: Length in bytes of the second block
+ * \return          CRC32 of the first block followed by the second block
+ */
+uint32_t crc32_combine(crc32_param_model_e model, uint32_t crc1, uint32_t crc2,
+                       uint64_t len2);
+
 /**
  * \}
  */
@@ -0,0 +1,186 @@
+/**
+ * \file            crc32_assembler.h
+ * \brief           CRC32 of out-of-order stream chunks
+ * \date            2026-10-19
+ *
+ * This file provides an assembler that computes the CRC32 of a stream whose
+ * chunks arrive out of order and from several threads. Each chunk is hashed on
+ * arrival, independently of the others, and folded into a shared accumulator;
+ * nothing is buffered and no chunk waits for its predecessors.
+ *
+ * With I the initial register, T the stream length and P_i the register of
+ * chunk i hashed from 0, the register of the stream is
+ *
+ *     x^(8 T) * (I + sum of P_i * x^(-8 end_i))
+ *
+ * where end_i is the stream offset just past chunk i. The terms of the sum do
+ * not depend on each other nor on T, so every chunk adds its term to a single
+ * word with an atomic XOR, without a lock. Only the record of the byte ranges
+ * received is locked, to reject chunks overlapping earlier ones: it is split
+ * by stream offset into shards with a lock each, so chunks at different
+ * offsets seldom contend. The stream is complete when the chunks received
+ * cover every byte of `[0, T)`; overlapping chunks are rejected.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC32_ASSEMBLER_H__
+#define __CRC32_ASSEMBLER_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc32_assembler_manager CRC32 Chunk Assembler
+ * \brief           Computes the CRC32 of streams received out of order.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Stream length to be given later with
+ *                  `crc32_assembler_set_total`.
+ */
+#define CRC32_ASSEMBLER_TOTAL_UNKNOWN UINT64_MAX
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Out-of-order CRC32 chunk assembler.
+ *
+ * All functions taking a pointer to the assembler may be called from several
+ * threads at once, except `crc32_assembler_init` and
+ * `crc32_assembler_deinit`.
+ */
+typedef struct {
+    crc32_param_model_e model; /*!< CRC32 model of the stream */
+    void* state;               /*!< Shared state, private */
+} crc32_assembler_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize an assembler.
+ *
+ * \param[out]      as: Pointer to the assembler, to be released with
+ *                  `crc32_assembler_deinit`
+ * \param[in]       model: The CRC32 model of the stream
+ * \param[in]       total: Stream length in bytes, or
+ *                  `CRC32_ASSEMBLER_TOTAL_UNKNOWN`
+ * \return          `true` on success, `false` on invalid arguments or
+ *                  allocation errors
+ */
+bool crc32_assembler_init(crc32_assembler_t* as, crc32_param_model_e model,
+                          uint64_t total);
+
+/**
+ * \brief           Give the stream length once it is known.
+ *
+ * \param[in,out]   as: Pointer to the assembler
+ * \param[in]       total: Stream length in bytes
+ * \return          `true` on success, `false` if another length was given
+ *                  or bytes past `total` were already received
+ */
+bool crc32_assembler_set_total(crc32_assembler_t* as, uint64_t total);
+
+/**
+ * \brief           Add a chunk of the stream.
+ *
+ * The chunk is hashed by the calling thread and can be released as soon as
+ * the function returns.
+ *
+ * \param[in,out]   as: Pointer to the assembler
+ * \param[in]       offset: Offset of the chunk in the stream
+ * \param[in]       buf: Pointer to the chunk
+ * \param[in]       len: Length of the chunk in bytes
+ * \return          `true` on success, `false` if the chunk exceeds the
+ *                  stream length, overlaps a chunk already received or on
+ *                  allocation errors; a rejected chunk is ignored
+ */
+bool crc32_assembler_add(crc32_assembler_t* as, uint64_t offset,
+                         const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Add a chunk of the stream by its checksum.
+ *
+ * For chunks already checksummed elsewhere, e.g. by the sender.
+ *
+ * \param[in,out]   as: Pointer to the assembler
+ * \param[in]       offset: Offset of the chunk in the stream
+ * \param[in]       len: Length of the chunk in bytes
+ * \param[in]       crc: The `crc32_calculate` value of the chunk
+ * \return          `true` on success, `false` if the chunk exceeds the
+ *                  stream length, overlaps a chunk already received or on
+ *                  allocation errors; a rejected chunk is ignored
+ */
+bool crc32_assembler_add_crc(crc32_assembler_t* as, uint64_t offset,
+                             uint64_t len, uint32_t crc);
+
+/**
+ * \brief           Get the number of bytes received so far.
+ *
+ * \param[in]       as: Pointer to the assembler
+ * \return          Number of bytes received
+ */
+uint64_t crc32_assembler_bytes(const crc32_assembler_t* as);
+
+/**
+ * \brief           Get the CRC32 of the stream once it is complete.
+ *
+ * The stream is complete once the chunks received cover every byte of
+ * `[0, total)`.
+ *
+ * \param[in]       as: Pointer to the assembler
+ * \param[out]      crc: The `crc32_calculate` value of the stream
+ * \return          `true` if the stream is complete, `false` otherwise
+ */
+bool crc32_assembler_result(const crc32_assembler_t* as, uint32_t* crc);
+
+/**
+ * \brief           Release an assembler.
+ *
+ * \param[in,out]   as: Pointer to the assembler
+ */
+void crc32_assembler_deinit(crc32_assembler_t* as);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC32_ASSEMBLER_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -41,6 +41,7 @@
 /* includes ----------------------------------------------------------------- */
 #include <stdbool.h>
 #include <stdint.h>
+#include "crc/crc_tier.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +53,30 @@ extern "C" {
  * \{
  */
 
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Default table tier of `crc32_lookup_init`, a `crc_tier_e`.
+ *
+ * 0, the default, keeps the built-in 16-entry nibble tables. Any other tier
+ * reads as many 256-entry tables of the polynomial and bit order, 1024 bytes
+ * each, built on first use. Must not exceed `CRC32_LOOKUP_SLICE_MAX`.
+ */
+#ifndef CRC32_LOOKUP_SLICE
+#define CRC32_LOOKUP_SLICE 0
+#endif
+
+/**
+ * \brief           Largest table tier a CRC32 lookup context can select.
+ *
+ * Bounds the static tables held for the tiers: 1 polynomial by 2 bit orders by
+ * this many 256-entry tables, 16 KiB at 8, 32 KiB at 16 and none at 0, where
+ * only the nibble tier remains. Defaults to the default tier, so slicing is
+ * opt-in: raise it to allow the byte and slicing tiers up to it.
+ */
+#ifndef CRC32_LOOKUP_SLICE_MAX
+#define CRC32_LOOKUP_SLICE_MAX CRC32_LOOKUP_SLICE
+#endif
+
 /* Public typedefs ---------------------------------------------------------- */
 /**
  * \brief           Enumeration of available CRC32 lookup models.
@@ -78,7 +103,8 @@ typedef struct {
     uint32_t poly;      /*!< Polynomial used in CRC32 calculation */
     bool ref_in;        /*!< Whether to reverse the input data bits */
     bool ref_out;       /*!< Whether to reverse the output data bits */
-    uint16_t table_len; /*!< Length of the lookup table */
+    uint16_t table_len; /*!< Length of the CRC32 lookup table: 16 for a
+                             nibble table, 256 per slice otherwise */
     uint32_t* table;    /*!< Pointer to the CRC32 lookup table */
 } crc32_lookup_ctx_t;
 
@@ -98,6 +124,18 @@ typedef struct {
 void crc32_lookup_init(crc32_lookup_ctx_t* ctx,
                        crc32_lookup_param_model_e model);
 
+/**
+ * \brief           Select the table tier of a CRC32 lookup context.
+ *
+ * The running CRC is kept, so the tier can change between updates.
+ *
+ * \param[in,out]   ctx: Pointer to an initialized CRC32 lookup context
+ * \param[in]       tier: The table tier
+ * \return          `true` on success, `false` if the tier is invalid or above
+ *                  `CRC32_LOOKUP_SLICE_MAX`, or the context has no table
+ */
+bool crc32_lookup_set_tier(crc32_lookup_ctx_t* ctx, crc_tier_e tier);
+
 /**
  * \brief           Update the CRC32 calculation with new data.
  *
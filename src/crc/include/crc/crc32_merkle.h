@@ -0,0 +1,242 @@
+/**
+ * \file            crc32_merkle.h
+ * \brief           Merkle tree of CRC32 block checksums
+ * \date            2026-10-19
+ *
+ * This file provides a hierarchical CRC32 structure over a data file. Leaves
+ * hold the CRC32 of fixed-size blocks; every parent node holds the CRC32 of
+ * the checksums of its children (its hash) and the flat CRC32 of the bytes it
+ * spans, derived from its children with `crc32_combine_op`. The span of the
+ * root is therefore the plain `crc32_calculate` value of the whole file.
+ *
+ * Any byte range can be verified by reading only the blocks it touches. Two
+ * trees of the same file geometry, e.g. of a local copy and of a replica, are
+ * compared by descending only into nodes whose hashes differ, which locates a
+ * corrupt block in O(log n) node comparisons per differing block.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC32_MERKLE_H__
+#define __CRC32_MERKLE_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc32_merkle_manager CRC32 Merkle Tree
+ * \brief           Manages hierarchical CRC32 checksums of data files.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Version of the serialised tree format.
+ */
+#define CRC32_MERKLE_VERSION    1
+
+/**
+ * \brief           Size of the serialised tree header in bytes.
+ */
+#define CRC32_MERKLE_HEAD_SIZE  32
+
+/**
+ * \brief           Default number of children per node.
+ */
+#define CRC32_MERKLE_FANOUT     16
+
+/**
+ * \brief           Maximum number of tree levels, leaves included.
+ */
+#define CRC32_MERKLE_LEVELS_MAX 64
+
+/**
+ * \brief           Maximum block size in bytes.
+ */
+#ifndef CRC32_MERKLE_BLOCK_MAX
+#define CRC32_MERKLE_BLOCK_MAX  (16 * 1024 * 1024)
+#endif
+
+/**
+ * \brief           Maximum number of worker threads.
+ */
+#ifndef CRC32_MERKLE_THREADS_MAX
+#define CRC32_MERKLE_THREADS_MAX 64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Node of a CRC32 Merkle tree.
+ */
+typedef struct {
+    uint32_t hash; /*!< Block CRC32 for a leaf, CRC32 of the children's
+                        hashes (little-endian) for a parent */
+    uint32_t span; /*!< Flat CRC32 of the bytes spanned by the node */
+} crc32_merkle_node_t;
+
+/**
+ * \brief           CRC32 Merkle tree of a data file.
+ *
+ * Level 0 holds the leaves; the last level holds the root alone.
+ */
+typedef struct {
+    crc32_param_model_e model;  /*!< CRC32 model of all checksums */
+    uint32_t block_size;        /*!< Leaf block size in bytes */
+    uint32_t fanout;            /*!< Number of children per parent */
+    uint32_t levels;            /*!< Number of levels, 0 for an empty file */
+    uint64_t file_size;         /*!< Size of the file in bytes */
+    uint64_t level_off[CRC32_MERKLE_LEVELS_MAX]; /*!< First node of each
+                                                      level in `nodes` */
+    uint64_t level_len[CRC32_MERKLE_LEVELS_MAX]; /*!< Nodes per level */
+    crc32_merkle_node_t* nodes; /*!< All nodes, level by level */
+} crc32_merkle_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Build the Merkle tree of a file.
+ *
+ * The leaves are hashed by several workers; the parent levels are derived
+ * from the leaves without reading the file again.
+ *
+ * \param[out]      tree: Pointer to the tree, to be released with
+ *                  `crc32_merkle_deinit`
+ * \param[in]       path: Path of the data file
+ * \param[in]       model: The CRC32 model to use
+ * \param[in]       block_size: Leaf block size in bytes, at most
+ *                  `CRC32_MERKLE_BLOCK_MAX`
+ * \param[in]       fanout: Number of children per parent, at least 2
+ * \param[in]       threads: Number of workers, 0 for one per CPU
+ * \return          `true` on success, `false` on invalid arguments, I/O or
+ *                  allocation errors
+ */
+bool crc32_merkle_build(crc32_merkle_t* tree, const char* path,
+                        crc32_param_model_e model, uint32_t block_size,
+                        uint32_t fanout, uint32_t threads);
+
+/**
+ * \brief           Get the root hash of a tree.
+ *
+ * \param[in]       tree: Pointer to the tree
+ * \return          Hash of the root node
+ */
+uint32_t crc32_merkle_root(const crc32_merkle_t* tree);
+
+/**
+ * \brief           Get the flat CRC32 of the whole file from a tree.
+ *
+ * \param[in]       tree: Pointer to the tree
+ * \return          The `crc32_calculate` value of the file
+ */
+uint32_t crc32_merkle_flat_crc(const crc32_merkle_t* tree);
+
+/**
+ * \brief           Verify a byte range of a file against its tree.
+ *
+ * Only the blocks overlapping the range are read.
+ *
+ * \param[in]       tree: Pointer to the tree
+ * \param[in]       path: Path of the data file
+ * \param[in]       offset: Offset of the range
+ * \param[in]       len: Length of the range in bytes
+ * \param[out]      bad: Indexes of the mismatching blocks, ascending, or NULL
+ * \param[in]       bad_max: Capacity of `bad`
+ * \param[out]      bad_count: Number of mismatching blocks, may exceed
+ *                  `bad_max`
+ * \return          `true` if the range could be read, `false` otherwise
+ */
+bool crc32_merkle_verify_range(const crc32_merkle_t* tree, const char* path,
+                               uint64_t offset, uint64_t len, uint64_t* bad,
+                               uint64_t bad_max, uint64_t* bad_count);
+
+/**
+ * \brief           Locate the blocks that differ between two trees.
+ *
+ * Only the nodes whose hashes differ are descended into.
+ *
+ * \param[in]       a: Pointer to the first tree
+ * \param[in]       b: Pointer to the second tree
+ * \param[out]      blocks: Indexes of the differing blocks, ascending, or
+ *                  NULL
+ * \param[in]       max: Capacity of `blocks`
+ * \param[out]      count: Number of differing blocks, may exceed `max`
+ * \return          `true` on success, `false` if the trees do not have the
+ *                  same model, block size, fanout and file size
+ */
+bool crc32_merkle_diff(const crc32_merkle_t* a, const crc32_merkle_t* b,
+                       uint64_t* blocks, uint64_t max, uint64_t* count);
+
+/**
+ * \brief           Save a tree in its serialised form.
+ *
+ * Only the leaves are stored, little-endian after a header, followed by a
+ * CRC32 (`CRC32_MODEL`) of all preceding bytes; the parent levels are
+ * rebuilt by `crc32_merkle_load`. An existing file is replaced atomically
+ * once the new one is on disk.
+ *
+ * \param[in]       tree: Pointer to the tree
+ * \param[in]       path: Path of the tree file
+ * \return          `true` on success, `false` on I/O errors
+ */
+bool crc32_merkle_save(const crc32_merkle_t* tree, const char* path);
+
+/**
+ * \brief           Load a tree from its serialised form.
+ *
+ * \param[out]      tree: Pointer to the tree, to be released with
+ *                  `crc32_merkle_deinit`
+ * \param[in]       path: Path of the tree file
+ * \return          `true` on success, `false` on I/O or allocation errors and
+ *                  if the tree file is invalid or corrupt
+ */
+bool crc32_merkle_load(crc32_merkle_t* tree, const char* path);
+
+/**
+ * \brief           Release the nodes of a tree.
+ *
+ * \param[in,out]   tree: Pointer to the tree
+ */
+void crc32_merkle_deinit(crc32_merkle_t* tree);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC32_MERKLE_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,205 @@
+/**
+ * \file            crc32_range.h
+ * \brief           Prefix CRC32 index answering the CRC32 of any byte range
+ * \date            2026-10-19
+ *
+ * This file provides a prefix index for immutable data files: the CRC32 of
+ * every prefix of the file whose length is a multiple of a fixed stride. The
+ * CRC32 of any byte range is then derived from the prefixes around its ends,
+ * with at most two partial strides read from the file and three
+ * `crc32_combine_op` steps, instead of reading the whole range.
+ *
+ * By linearity, the CRC32 of the range [a, b) follows from the CRC32 of the
+ * prefixes [0, a) and [0, b) as `crc32_combine_op(crc_a, crc_b, op)` with the
+ * operator of `b - a` bytes: combining is its own inverse, so it also
+ * "subtracts" a prefix.
+ *
+ * Index layout, all fields little-endian:
+ *
+ * | Offset | Size | Field                                        |
+ * |--------|------|----------------------------------------------|
+ * | 0      | 4    | Magic "CRCR"                                 |
+ * | 4      | 2    | Format version, `CRC32_RANGE_VERSION`        |
+ * | 6      | 1    | CRC32 model                                  |
+ * | 7      | 1    | Reserved, 0                                  |
+ * | 8      | 4    | Stride in bytes                              |
+ * | 12     | 4    | Reserved, 0                                  |
+ * | 16     | 8    | File size in bytes                           |
+ * | 24     | 8    | File modification time in nanoseconds        |
+ * | 32     | 4 n  | CRC32 of each of the n prefixes, from empty  |
+ * | 32+4 n | 4    | CRC32 (`CRC32_MODEL`) of all preceding bytes |
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC32_RANGE_H__
+#define __CRC32_RANGE_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc32_range_manager CRC32 Range Index
+ * \brief           Answers CRC32 queries over byte ranges of data files.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Version of the index file format.
+ */
+#define CRC32_RANGE_VERSION     1
+
+/**
+ * \brief           Size of the index header in bytes.
+ */
+#define CRC32_RANGE_HEAD_SIZE   32
+
+/**
+ * \brief           Maximum stride in bytes.
+ */
+#ifndef CRC32_RANGE_STRIDE_MAX
+#define CRC32_RANGE_STRIDE_MAX  (16 * 1024 * 1024)
+#endif
+
+/**
+ * \brief           Maximum number of worker threads.
+ */
+#ifndef CRC32_RANGE_THREADS_MAX
+#define CRC32_RANGE_THREADS_MAX 64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Prefix CRC32 index of a data file.
+ */
+typedef struct {
+    crc32_param_model_e model; /*!< CRC32 model of the prefixes */
+    uint32_t stride;           /*!< Stride in bytes */
+    uint64_t file_size;        /*!< File size when indexed */
+    int64_t mtime_ns;          /*!< File modification time when indexed */
+    uint64_t count;            /*!< Number of prefixes, `file_size / stride`
+                                    + 1 */
+    uint32_t* prefix;          /*!< CRC32 of the first `i * stride` bytes */
+} crc32_range_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Build the prefix index of a file.
+ *
+ * The strides are hashed by several workers; the prefixes are then chained
+ * with `crc32_combine_op`.
+ *
+ * \param[out]      idx: Pointer to the index, to be released with
+ *                  `crc32_range_deinit`
+ * \param[in]       path: Path of the data file
+ * \param[in]       model: The CRC32 model to use
+ * \param[in]       stride: Stride in bytes, at most `CRC32_RANGE_STRIDE_MAX`
+ * \param[in]       threads: Number of workers, 0 for one per CPU
+ * \return          `true` on success, `false` on invalid arguments, I/O or
+ *                  allocation errors
+ */
+bool crc32_range_build(crc32_range_t* idx, const char* path,
+                       crc32_param_model_e model, uint32_t stride,
+                       uint32_t threads);
+
+/**
+ * \brief           Check whether a file changed since it was indexed.
+ *
+ * Only the size and modification time of the file are compared.
+ *
+ * \param[in]       idx: Pointer to the index
+ * \param[in]       path: Path of the data file
+ * \return          `true` if the file changed or cannot be queried
+ */
+bool crc32_range_stale(const crc32_range_t* idx, const char* path);
+
+/**
+ * \brief           Calculate the CRC32 of a byte range of a file.
+ *
+ * At most two partial strides are read from the file; ranges no longer than
+ * a stride are read directly.
+ *
+ * \param[in]       idx: Pointer to the index of the file
+ * \param[in]       path: Path of the data file, unchanged since indexed
+ * \param[in]       offset: Offset of the range
+ * \param[in]       len: Length of the range in bytes
+ * \param[out]      crc: The `crc32_calculate` value of the range
+ * \return          `true` on success, `false` if the range exceeds the file
+ *                  or on I/O errors
+ */
+bool crc32_range_query(const crc32_range_t* idx, const char* path,
+                       uint64_t offset, uint64_t len, uint32_t* crc);
+
+/**
+ * \brief           Write an index to a file.
+ *
+ * An existing index file is only replaced once the new one is on disk.
+ *
+ * \param[in]       idx: Pointer to the index
+ * \param[in]       path: Path of the index file
+ * \return          `true` on success, `false` on I/O errors
+ */
+bool crc32_range_save(const crc32_range_t* idx, const char* path);
+
+/**
+ * \brief           Read an index from a file.
+ *
+ * \param[out]      idx: Pointer to the index, to be released with
+ *                  `crc32_range_deinit`
+ * \param[in]       path: Path of the index file
+ * \return          `true` on success, `false` if the file is missing,
+ *                  truncated, corrupt or of another version
+ */
+bool crc32_range_load(crc32_range_t* idx, const char* path);
+
+/**
+ * \brief           Release an index.
+ *
+ * \param[in,out]   idx: Pointer to the index
+ */
+void crc32_range_deinit(crc32_range_t* idx);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC32_RANGE_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,178 @@
+/**
+ * \file            crc32_region.h
+ * \brief           Checksummed memory region with dirty-page tracking
+ * \date            2026-10-19
+ *
+ * This file provides a checksummed memory region: the CRC32 of every page of a
+ * caller-owned buffer is kept, along with a bitmap of the pages written since
+ * they were last hashed. When the CRC32 of the region is requested only the
+ * dirty pages are hashed again; the page checksums are kept in a binary tree of
+ * `crc32_combine_op` results, so each dirty page costs one path to the root
+ * instead of a pass over the whole region.
+ *
+ * Pages are marked dirty through `crc32_region_write` / `crc32_region_mark`, or
+ * automatically by write-protecting the region with `mprotect` and catching the
+ * first write to each page (`crc32_region_track`, POSIX only).
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC32_REGION_H__
+#define __CRC32_REGION_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc32_region_manager CRC32 Memory Region
+ * \brief           Keeps the CRC32 of a memory region up to date.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Maximum number of regions tracked with `mprotect` at once.
+ */
+#ifndef CRC32_REGION_TRACK_MAX
+#define CRC32_REGION_TRACK_MAX 16
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Checksummed memory region.
+ */
+typedef struct {
+    crc32_param_model_e model; /*!< CRC32 model of the checksums */
+    uint8_t* base;             /*!< Start of the region, owned by the caller */
+    size_t size;               /*!< Size of the region in bytes */
+    uint32_t page_size;        /*!< Page size in bytes */
+    uint64_t pages;            /*!< Number of pages, the last may be short */
+    uint64_t rehashed;         /*!< Pages hashed by the last
+                                    `crc32_region_crc` */
+    bool tracking;             /*!< Whether writes are tracked by `mprotect` */
+    void* state;               /*!< Page checksums and dirty bitmap,
+                                    private */
+} crc32_region_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize a checksummed region and hash all its pages.
+ *
+ * \param[out]      region: Pointer to the region, to be released with
+ *                  `crc32_region_deinit`
+ * \param[in]       model: The CRC32 model to use
+ * \param[in]       base: Start of the memory
+ * \param[in]       size: Size of the memory in bytes
+ * \param[in]       page_size: Page size in bytes, a multiple of the system
+ *                  page size if the region is to be tracked
+ * \return          `true` on success, `false` on invalid arguments or
+ *                  allocation errors
+ */
+bool crc32_region_init(crc32_region_t* region, crc32_param_model_e model,
+                       uint8_t* base, size_t size, uint32_t page_size);
+
+/**
+ * \brief           Mark a byte range of the region as written.
+ *
+ * May be called from several threads at once.
+ *
+ * \param[in,out]   region: Pointer to the region
+ * \param[in]       offset: Offset of the range
+ * \param[in]       len: Length of the range in bytes
+ */
+void crc32_region_mark(crc32_region_t* region, size_t offset, size_t len);
+
+/**
+ * \brief           Write bytes into the region and mark them.
+ *
+ * \param[in,out]   region: Pointer to the region
+ * \param[in]       offset: Offset to write at
+ * \param[in]       buf: Pointer to the bytes
+ * \param[in]       len: Number of bytes, the range must be inside the region
+ */
+void crc32_region_write(crc32_region_t* region, size_t offset,
+                        const void* buf, size_t len);
+
+/**
+ * \brief           Start or stop tracking writes with `mprotect`.
+ *
+ * While tracking, the region is write-protected; the first write to a page
+ * is caught by a `SIGSEGV` handler, which marks the page and unprotects it.
+ * Faults outside tracked regions are passed on to the previous handler.
+ *
+ * Protection applies to whole system pages, so the region must start and
+ * end on system page boundaries: it may then share no page with other data,
+ * whose writes would fault outside the region.
+ *
+ * \param[in,out]   region: Pointer to the region, its base and size aligned
+ *                  to the system page size
+ * \param[in]       enable: Whether to track writes
+ * \return          `true` on success, `false` if tracking is not supported,
+ *                  the region is not aligned or too many regions are tracked
+ */
+bool crc32_region_track(crc32_region_t* region, bool enable);
+
+/**
+ * \brief           Get the CRC32 of the region.
+ *
+ * The dirty pages are hashed again and folded into the region checksum.
+ * Writers must be quiescent during the call.
+ *
+ * \param[in,out]   region: Pointer to the region
+ * \return          The `crc32_calculate` value of the region
+ */
+uint32_t crc32_region_crc(crc32_region_t* region);
+
+/**
+ * \brief           Release a region, stopping write tracking.
+ *
+ * The memory of the region is left to the caller.
+ *
+ * \param[in,out]   region: Pointer to the region
+ */
+void crc32_region_deinit(crc32_region_t* region);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC32_REGION_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,147 @@
+/**
+ * \file            crc32_scrub.h
+ * \brief           Parallel scrub of files made of CRC32 protected fixed-size
+ *                  records
+ * \date            2026-10-19
+ *
+ * This file provides a scrub engine for files of fixed-size records, each
+ * ending in a CRC32 trailer in the `crc32_pack_buf` layout. The file is split
+ * into chunks of records that worker threads claim one at a time; every worker
+ * streams its chunks through its own file handle and verifies them with
+ * `crc32_verify_bufs`. The offsets of the corrupt records are reported in
+ * ascending order together with the throughput of the scrub.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC32_SCRUB_H__
+#define __CRC32_SCRUB_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc32_scrub_manager CRC32 Record Scrub
+ * \brief           Verifies files of CRC32 protected records in parallel.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Number of bytes a worker reads and verifies at a time.
+ *
+ * Rounded down to whole records, with at least one record per chunk.
+ */
+#ifndef CRC32_SCRUB_CHUNK_BYTES
+#define CRC32_SCRUB_CHUNK_BYTES (1024 * 1024)
+#endif
+
+/**
+ * \brief           Maximum number of worker threads.
+ */
+#ifndef CRC32_SCRUB_THREADS_MAX
+#define CRC32_SCRUB_THREADS_MAX 64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Scrub configuration.
+ */
+typedef struct {
+    crc32_param_model_e model; /*!< CRC32 model of the record trailers */
+    uint32_t record_size;      /*!< Record size in bytes, trailer included */
+    uint32_t threads;          /*!< Number of workers, 0 for one per CPU */
+} crc32_scrub_cfg_t;
+
+/**
+ * \brief           Result of a scrub.
+ */
+typedef struct {
+    uint64_t records;       /*!< Number of records verified */
+    uint64_t bytes;         /*!< Number of bytes verified */
+    uint64_t tail;          /*!< Trailing bytes short of a record, skipped */
+    uint64_t* bad;          /*!< Offsets of the corrupt records, ascending */
+    uint64_t bad_count;     /*!< Number of corrupt records */
+    double seconds;         /*!< Wall-clock duration of the scrub */
+    double gb_per_sec;      /*!< Throughput in 10^9 bytes per second */
+    double records_per_sec; /*!< Throughput in records per second */
+} crc32_scrub_report_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Scrub a file of CRC32 protected records.
+ *
+ * \param[in]       cfg: Pointer to the scrub configuration
+ * \param[in]       path: Path of the file
+ * \param[out]      report: Pointer to the report, to be released with
+ *                  `crc32_scrub_report_free`
+ * \return          `true` on success, `false` on invalid arguments, I/O or
+ *                  allocation errors
+ */
+bool crc32_scrub_file(const crc32_scrub_cfg_t* cfg, const char* path,
+                      crc32_scrub_report_t* report);
+
+/**
+ * \brief           Scrub records held in memory, e.g. a memory-mapped file.
+ *
+ * \param[in]       cfg: Pointer to the scrub configuration
+ * \param[in]       buf: Pointer to the records
+ * \param[in]       len: Length of the buffer in bytes
+ * \param[out]      report: Pointer to the report, to be released with
+ *                  `crc32_scrub_report_free`
+ * \return          `true` on success, `false` on invalid arguments or
+ *                  allocation errors
+ */
+bool crc32_scrub_buf(const crc32_scrub_cfg_t* cfg, const uint8_t* buf,
+                     uint64_t len, crc32_scrub_report_t* report);
+
+/**
+ * \brief           Release the offsets held by a scrub report.
+ *
+ * \param[in,out]   report: Pointer to the report
+ */
+void crc32_scrub_report_free(crc32_scrub_report_t* report);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC32_SCRUB_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,215 @@
+/**
+ * \file            crc32_sidecar.h
+ * \brief           Per-block CRC32 sidecar index with incremental re-
+ *                  verification
+ * \date            2026-10-19
+ *
+ * This file provides a sidecar index for a data file: a header holding the
+ * CRC32 model, the block size and the size and modification time of the file,
+ * followed by a dense array of the CRC32 of every block. When the file is
+ * appended to or partially rewritten only the affected blocks are re-hashed,
+ * and the CRC32 of the whole file is derived from the block checksums with
+ * `crc32_combine_op` without reading the file again.
+ *
+ * Sidecar layout, all fields little-endian:
+ *
+ * | Offset | Size | Field                                        |
+ * |--------|------|----------------------------------------------|
+ * | 0      | 4    | Magic "CRCS"                                 |
+ * | 4      | 2    | Format version, `CRC32_SIDECAR_VERSION`      |
+ * | 6      | 1    | CRC32 model                                  |
+ * | 7      | 1    | Reserved, 0                                  |
+ * | 8      | 4    | Block size in bytes                          |
+ * | 12     | 4    | Reserved, 0                                  |
+ * | 16     | 8    | File size in bytes                           |
+ * | 24     | 8    | File modification time in nanoseconds        |
+ * | 32     | 4 n  | CRC32 of each of the n blocks                |
+ * | 32+4 n | 4    | CRC32 (`CRC32_MODEL`) of all preceding bytes |
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC32_SIDECAR_H__
+#define __CRC32_SIDECAR_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc32_sidecar_manager CRC32 Sidecar Index
+ * \brief           Manages per-block CRC32 indexes of data files.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Version of the sidecar file format.
+ */
+#define CRC32_SIDECAR_VERSION   1
+
+/**
+ * \brief           Size of the sidecar header in bytes.
+ */
+#define CRC32_SIDECAR_HEAD_SIZE 32
+
+/**
+ * \brief           Maximum block size in bytes.
+ */
+#ifndef CRC32_SIDECAR_BLOCK_MAX
+#define CRC32_SIDECAR_BLOCK_MAX (16 * 1024 * 1024)
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Per-block CRC32 index of a data file.
+ */
+typedef struct {
+    crc32_param_model_e model; /*!< CRC32 model of the block checksums */
+    uint32_t block_size;       /*!< Block size in bytes */
+    uint64_t file_size;        /*!< File size when last indexed */
+    int64_t mtime_ns;          /*!< File modification time when indexed */
+    uint64_t blocks;           /*!< Number of blocks, the last may be short */
+    uint32_t* crc;             /*!< CRC32 of each block */
+} crc32_sidecar_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Build the sidecar index of a file.
+ *
+ * \param[out]      sc: Pointer to the index, to be released with
+ *                  `crc32_sidecar_deinit`
+ * \param[in]       path: Path of the data file
+ * \param[in]       model: The CRC32 model to use
+ * \param[in]       block_size: Block size in bytes, at most
+ *                  `CRC32_SIDECAR_BLOCK_MAX`
+ * \return          `true` on success, `false` on invalid arguments, I/O or
+ *                  allocation errors
+ */
+bool crc32_sidecar_build(crc32_sidecar_t* sc, const char* path,
+                         crc32_param_model_e model, uint32_t block_size);
+
+/**
+ * \brief           Check whether a file changed since it was indexed.
+ *
+ * Only the size and modification time of the file are compared.
+ *
+ * \param[in]       sc: Pointer to the index
+ * \param[in]       path: Path of the data file
+ * \return          `true` if the file changed or cannot be queried
+ */
+bool crc32_sidecar_stale(const crc32_sidecar_t* sc, const char* path);
+
+/**
+ * \brief           Bring the index up to date after the file changed.
+ *
+ * The blocks overlapping the rewritten range are re-hashed, as well as the
+ * blocks from the old end of the file to its new end when the size changed.
+ * An append is therefore an update with an empty range.
+ *
+ * \param[in,out]   sc: Pointer to the index
+ * \param[in]       path: Path of the data file
+ * \param[in]       offset: Offset of the rewritten range
+ * \param[in]       len: Length of the rewritten range, 0 if none
+ * \return          `true` on success, `false` on I/O or allocation errors
+ */
+bool crc32_sidecar_update(crc32_sidecar_t* sc, const char* path,
+                          uint64_t offset, uint64_t len);
+
+/**
+ * \brief           Verify a file against its index.
+ *
+ * Every block is re-hashed. Blocks present in only one of the file and the
+ * index count as mismatching.
+ *
+ * \param[in]       sc: Pointer to the index
+ * \param[in]       path: Path of the data file
+ * \param[out]      bad: Indexes of the mismatching blocks, ascending, or NULL
+ * \param[in]       bad_max: Capacity of `bad`
+ * \param[out]      bad_count: Number of mismatching blocks, may exceed
+ *                  `bad_max`
+ * \return          `true` if the file could be read, `false` otherwise
+ */
+bool crc32_sidecar_verify(const crc32_sidecar_t* sc, const char* path,
+                          uint64_t* bad, uint64_t bad_max,
+                          uint64_t* bad_count);
+
+/**
+ * \brief           Derive the CRC32 of the whole file from the index.
+ *
+ * \param[in]       sc: Pointer to the index
+ * \return          CRC32 of the indexed file
+ */
+uint32_t crc32_sidecar_file_crc(const crc32_sidecar_t* sc);
+
+/**
+ * \brief           Save an index to a sidecar file.
+ *
+ * An existing sidecar is only replaced once the new one is on disk.
+ *
+ * \param[in]       sc: Pointer to the index
+ * \param[in]       path: Path of the sidecar file
+ * \return          `true` on success, `false` on I/O errors
+ */
+bool crc32_sidecar_save(const crc32_sidecar_t* sc, const char* path);
+
+/**
+ * \brief           Load an index from a sidecar file.
+ *
+ * \param[out]      sc: Pointer to the index, to be released with
+ *                  `crc32_sidecar_deinit`
+ * \param[in]       path: Path of the sidecar file
+ * \return          `true` on success, `false` on I/O or allocation errors and
+ *                  if the sidecar file is invalid or corrupt
+ */
+bool crc32_sidecar_load(crc32_sidecar_t* sc, const char* path);
+
+/**
+ * \brief           Release the block checksums of an index.
+ *
+ * \param[in,out]   sc: Pointer to the index
+ */
+void crc32_sidecar_deinit(crc32_sidecar_t* sc);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC32_SIDECAR_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
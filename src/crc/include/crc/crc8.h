@@ -87,6 +87,19 @@ typedef struct {
     bool ref_out;    /*!< Whether to reverse the output data bits */
 } crc8_ctx_t;
 
+/**
+ * \brief           CRC8 streaming verification context.
+ *
+ * Tracks a CRC8 over a byte stream so that `crc8_verify_stream` can tell at
+ * any byte boundary whether the bytes seen so far form a frame followed by its
+ * CRC8 trailer, as written by `crc8_pack_buf`.
+ */
+typedef struct {
+    crc8_ctx_t ctx;  /*!< Running CRC8 context over data + trailer */
+    uint8_t residue; /*!< Expected CRC8 over data + trailer */
+    uint32_t len;    /*!< Number of bytes seen */
+} crc8_stream_t;
+
 /* Public functions --------------------------------------------------------- */
 /**
  * \brief           Initializes the CRC8 context with the specified model.
@@ -173,6 +186,82 @@ void crc8_pack_buf(crc8_param_model_e model, uint8_t* buf, uint32_t len);
 bool crc8_verify_buf(crc8_param_model_e model, const uint8_t* buf,
                      uint32_t len);
 
+/**
+ * \brief           Get the residue of a CRC8 model.
+ *
+ * The residue is the CRC8 calculated over data followed by its own CRC8
+ * trailer; it is the same constant for every valid frame.
+ *
+ * \param[in]       model: The CRC8 model
+ * \return          The residue of the model
+ */
+uint8_t crc8_residue(crc8_param_model_e model);
+
+/**
+ * \brief           Initialize a CRC8 streaming verification context.
+ *
+ * \param[out]      stream: Pointer to the streaming context to be initialized
+ * \param[in]       model: The CRC8 model to use for verification
+ */
+void crc8_verify_stream_init(crc8_stream_t* stream, crc8_param_model_e model);
+
+/**
+ * \brief           Feed bytes of a frame to a CRC8 streaming context.
+ *
+ * \param[in,out]   stream: Pointer to the streaming context
+ * \param[in]       buf: Pointer to the received bytes
+ * \param[in]       len: Number of received bytes
+ */
+void crc8_verify_stream_update(crc8_stream_t* stream, const uint8_t* buf,
+                               uint32_t len);
+
+/**
+ * \brief           Check whether the bytes seen so far form a valid frame.
+ *
+ * The frame layout is the one of `crc8_verify_buf`: data followed by the
+ * CRC8 trailer. The check costs the same at any byte boundary and does not
+ * rescan the data.
+ *
+ * \param[in]       stream: Pointer to the streaming context
+ * \return          `true` if the checksum is correct, `false` otherwise
+ */
+bool crc8_verify_stream(const crc8_stream_t* stream);
+
+/**
+ * \brief           Verify an array of frames in one call.
+ *
+ * Each frame has the layout of `crc8_verify_buf`. The model is resolved once
+ * for the whole batch and the CRC chains of several frames are interleaved,
+ * which pays off for large numbers of short frames.
+ *
+ * Bit `i % 64` of `ok_bitmap[i / 64]` is set when frame `i` is valid; all
+ * `(n + 63) / 64` words of the bitmap are written.
+ *
+ * \param[in]       model: The CRC8 model to use for verification
+ * \param[in]       bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ * \param[out]      ok_bitmap: Bitmap of the valid frames
+ * \return          Number of valid frames
+ */
+uint32_t crc8_verify_bufs(crc8_param_model_e model,
+                          const uint8_t* const bufs[], const uint32_t lens[],
+                          uint32_t n, uint64_t* ok_bitmap);
+
+/**
+ * \brief           Pack the CRC8 trailer of an array of frames in one call.
+ *
+ * Each frame is packed as by `crc8_pack_buf`; frames too short to hold the
+ * trailer are left unchanged.
+ *
+ * \param[in]       model: The CRC8 model to use
+ * \param[in,out]   bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ */
+void crc8_pack_bufs(crc8_param_model_e model, uint8_t* const bufs[],
+                    const uint32_t lens[], uint32_t n);
+
 /**
  * \}
  */
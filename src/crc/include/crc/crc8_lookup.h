@@ -43,6 +43,7 @@
 /* includes ----------------------------------------------------------------- */
 #include <stdbool.h>
 #include <stdint.h>
+#include "crc/crc_tier.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,30 @@ extern "C" {
  * \{
  */
 
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Default table tier of `crc8_lookup_init`, a `crc_tier_e`.
+ *
+ * 0, the default, keeps the built-in 16-entry nibble tables. Any other tier
+ * reads as many 256-entry tables of the polynomial and bit order, 256 bytes
+ * each, built on first use. Must not exceed `CRC8_LOOKUP_SLICE_MAX`.
+ */
+#ifndef CRC8_LOOKUP_SLICE
+#define CRC8_LOOKUP_SLICE 0
+#endif
+
+/**
+ * \brief           Largest table tier a CRC8 lookup context can select.
+ *
+ * Bounds the static tables held for the tiers: 2 polynomials by 2 bit orders by
+ * this many 256-entry tables, 8 KiB at 8, 16 KiB at 16 and none at 0, where
+ * only the nibble tier remains. Defaults to the default tier, so slicing is
+ * opt-in: raise it to allow the byte and slicing tiers up to it.
+ */
+#ifndef CRC8_LOOKUP_SLICE_MAX
+#define CRC8_LOOKUP_SLICE_MAX CRC8_LOOKUP_SLICE
+#endif
+
 /* Public typedefs ---------------------------------------------------------- */
 /**
  * \brief           Enumeration of CRC-8 lookup models.
@@ -85,7 +110,8 @@ typedef struct {
                    */
     bool ref_out; /*!< Flag indicating whether output data should be
                      bit-reversed */
-    uint16_t table_len; /*!< Length of the CRC8 lookup table */
+    uint16_t table_len; /*!< Length of the CRC8 lookup table: 16 for a
+                             nibble table, 256 per slice otherwise */
     uint8_t* table;     /*!< Pointer to the lookup table for CRC8 calculation */
 } crc8_lookup_ctx_t;
 
@@ -103,6 +129,18 @@ typedef struct {
  */
 void crc8_lookup_init(crc8_lookup_ctx_t* ctx, crc8_lookup_param_model_e model);
 
+/**
+ * \brief           Select the table tier of a CRC8 lookup context.
+ *
+ * The running CRC is kept, so the tier can change between updates.
+ *
+ * \param[in,out]   ctx: Pointer to an initialized CRC8 lookup context
+ * \param[in]       tier: The table tier
+ * \return          `true` on success, `false` if the tier is invalid or above
+ *                  `CRC8_LOOKUP_SLICE_MAX`, or the context has no table
+ */
+bool crc8_lookup_set_tier(crc8_lookup_ctx_t* ctx, crc_tier_e tier);
+
 /**
  * \brief           Updates the CRC8 checksum with additional data.
  *
@@ -0,0 +1,284 @@
+/**
+ * \file            crc_checkpoint.h
+ * \brief           Checkpoint and resume of streaming CRC state
+ * \date            2026-10-19
+ *
+ * This file provides a versioned, endian-stable serialised form of the
+ * streaming CRC contexts together with the number of bytes they have consumed,
+ * and a file checksum driver built on it. The driver saves its state at
+ * regular intervals; a run interrupted by a crash or a time limit resumes from
+ * the latest saved state instead of from byte 0.
+ *
+ * The serialised state holds the running register, so it must be taken before
+ * `*_final`, which overwrites it. Lookup contexts are imported with the
+ * built-in table of their polynomial.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_CHECKPOINT_H__
+#define __CRC_CHECKPOINT_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc16_lookup.h"
+#include "crc/crc32.h"
+#include "crc/crc32_lookup.h"
+#include "crc/crc8.h"
+#include "crc/crc8_lookup.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_checkpoint_manager CRC Checkpoint
+ * \brief           Saves and restores streaming CRC state.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Version of the serialised state format.
+ */
+#define CRC_STATE_VERSION            1
+
+/**
+ * \brief           Size of the serialised state in bytes.
+ */
+#define CRC_STATE_SIZE               36
+
+/**
+ * \brief           Default number of bytes between two checkpoints.
+ */
+#ifndef CRC_CHECKPOINT_INTERVAL
+#define CRC_CHECKPOINT_INTERVAL      (1024ull * 1024 * 1024)
+#endif
+
+/**
+ * \brief           Size of the checkpoint file in bytes.
+ */
+#define CRC_CHECKPOINT_FILE_SIZE     (CRC_STATE_SIZE + 20)
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           File checksum driver configuration.
+ */
+typedef struct {
+    uint8_t width;               /*!< CRC width in bits: 8, 16 or 32 */
+    uint8_t model;               /*!< `crc8_param_model_e`,
+                                      `crc16_param_model_e` or
+                                      `crc32_param_model_e`, as per `width` */
+    const char* checkpoint_path; /*!< Checkpoint file */
+    uint64_t interval;           /*!< Bytes between two checkpoints, 0 for
+                                      `CRC_CHECKPOINT_INTERVAL` */
+    uint64_t max_bytes;          /*!< Bytes to process in this run, 0 for
+                                      no limit */
+} crc_checkpoint_cfg_t;
+
+/**
+ * \brief           Outcome of a file checksum driver run.
+ */
+typedef struct {
+    bool complete;        /*!< Whether the whole file has been processed */
+    uint32_t crc;         /*!< Checksum of the file, if `complete` */
+    uint64_t offset;      /*!< Number of bytes processed so far */
+    uint64_t resumed_at;  /*!< Offset resumed from, 0 for a fresh start */
+    uint64_t checkpoints; /*!< Checkpoints written in this run */
+} crc_checkpoint_result_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Serialise a CRC8 context.
+ *
+ * \param[in]       ctx: Pointer to the context, not yet finalized
+ * \param[in]       offset: Number of bytes fed to the context
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+void crc8_state_export(const crc8_ctx_t* ctx, uint64_t offset, uint8_t* buf);
+
+/**
+ * \brief           Restore a CRC8 context.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[out]      offset: Number of bytes fed to the context
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is corrupt, of
+ *                  another version or of another context type
+ */
+bool crc8_state_import(crc8_ctx_t* ctx, uint64_t* offset, const uint8_t* buf);
+
+/**
+ * \brief           Serialise a CRC16 context.
+ *
+ * \param[in]       ctx: Pointer to the context, not yet finalized
+ * \param[in]       offset: Number of bytes fed to the context
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+void crc16_state_export(const crc16_ctx_t* ctx, uint64_t offset,
+                        uint8_t* buf);
+
+/**
+ * \brief           Restore a CRC16 context.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[out]      offset: Number of bytes fed to the context
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is corrupt, of
+ *                  another version or of another context type
+ */
+bool crc16_state_import(crc16_ctx_t* ctx, uint64_t* offset,
+                        const uint8_t* buf);
+
+/**
+ * \brief           Serialise a CRC32 context.
+ *
+ * \param[in]       ctx: Pointer to the context, not yet finalized
+ * \param[in]       offset: Number of bytes fed to the context
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+void crc32_state_export(const crc32_ctx_t* ctx, uint64_t offset,
+                        uint8_t* buf);
+
+/**
+ * \brief           Restore a CRC32 context.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[out]      offset: Number of bytes fed to the context
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is corrupt, of
+ *                  another version or of another context type
+ */
+bool crc32_state_import(crc32_ctx_t* ctx, uint64_t* offset,
+                        const uint8_t* buf);
+
+/**
+ * \brief           Serialise a CRC8 lookup context.
+ *
+ * The table pointer is not serialised, only its polynomial and length.
+ *
+ * \param[in]       ctx: Pointer to the context, not yet finalized
+ * \param[in]       offset: Number of bytes fed to the context
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+void crc8_lookup_state_export(const crc8_lookup_ctx_t* ctx, uint64_t offset,
+                              uint8_t* buf);
+
+/**
+ * \brief           Restore a CRC8 lookup context.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[out]      offset: Number of bytes fed to the context
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is invalid or no
+ *                  built-in table matches its polynomial
+ */
+bool crc8_lookup_state_import(crc8_lookup_ctx_t* ctx, uint64_t* offset,
+                              const uint8_t* buf);
+
+/**
+ * \brief           Serialise a CRC16 lookup context.
+ *
+ * The table pointer is not serialised, only its polynomial and length.
+ *
+ * \param[in]       ctx: Pointer to the context, not yet finalized
+ * \param[in]       offset: Number of bytes fed to the context
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+void crc16_lookup_state_export(const crc16_lookup_ctx_t* ctx, uint64_t offset,
+                               uint8_t* buf);
+
+/**
+ * \brief           Restore a CRC16 lookup context.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[out]      offset: Number of bytes fed to the context
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is invalid or no
+ *                  built-in table matches its polynomial
+ */
+bool crc16_lookup_state_import(crc16_lookup_ctx_t* ctx, uint64_t* offset,
+                               const uint8_t* buf);
+
+/**
+ * \brief           Serialise a CRC32 lookup context.
+ *
+ * The table pointer is not serialised, only its polynomial and length.
+ *
+ * \param[in]       ctx: Pointer to the context, not yet finalized
+ * \param[in]       offset: Number of bytes fed to the context
+ * \param[out]      buf: Destination of `CRC_STATE_SIZE` bytes
+ */
+void crc32_lookup_state_export(const crc32_lookup_ctx_t* ctx, uint64_t offset,
+                               uint8_t* buf);
+
+/**
+ * \brief           Restore a CRC32 lookup context.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[out]      offset: Number of bytes fed to the context
+ * \param[in]       buf: Serialised state of `CRC_STATE_SIZE` bytes
+ * \return          `true` on success, `false` if the state is invalid or no
+ *                  built-in table matches its polynomial
+ */
+bool crc32_lookup_state_import(crc32_lookup_ctx_t* ctx, uint64_t* offset,
+                               const uint8_t* buf);
+
+/**
+ * \brief           Checksum a file, resuming from its checkpoint if any.
+ *
+ * A checkpoint is written every `interval` bytes, to a temporary file that is
+ * flushed to disk and renamed over the previous one, so a crash leaves either
+ * the old or the new checkpoint. A checkpoint is only resumed from if the
+ * model, size and modification time of the file still match; otherwise the
+ * run starts from byte 0. The checkpoint file is removed once the file is
+ * complete.
+ *
+ * \param[in]       path: Path of the file
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[out]      result: Pointer to the outcome
+ * \return          `true` on success, including a run stopped by
+ *                  `max_bytes`, `false` on invalid arguments or I/O errors
+ */
+bool crc_checkpoint_file(const char* path, const crc_checkpoint_cfg_t* cfg,
+                         crc_checkpoint_result_t* result);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_CHECKPOINT_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
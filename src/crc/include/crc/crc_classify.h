@@ -0,0 +1,143 @@
+/**
+ * \file            crc_classify.h
+ * \brief           CRC model and trailer layout classification
+ * \date            2026-10-19
+ *
+ * This file provides a classifier that finds which CRC models and trailer
+ * layouts validate a set of sample frames captured from an unknown device. A
+ * layout is the CRC width and byte order, the number of leading bytes left out
+ * of the CRC and the number of bytes following the CRC.
+ *
+ * Models sharing a width, polynomial and input reflection share one raw
+ * register pass per frame, from which every layout of every such model is
+ * derived by CRC linearity. Candidates are dropped as soon as they fail, so the
+ * frames after the first few only run the surviving polynomials.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_CLASSIFY_H__
+#define __CRC_CLASSIFY_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_classify_manager CRC Classifier
+ * \brief           Identifies the CRC model and layout of unknown frames.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Upper bound of `skip_max` and `tail_max`.
+ */
+#ifndef CRC_CLASSIFY_OFFSET_MAX
+#define CRC_CLASSIFY_OFFSET_MAX 16
+#endif
+
+/**
+ * \brief           Maximum number of classifier threads.
+ */
+#ifndef CRC_CLASSIFY_THREADS_MAX
+#define CRC_CLASSIFY_THREADS_MAX 64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Classifier configuration.
+ */
+typedef struct {
+    const crc_model_t* models; /*!< Candidate models, NULL for the catalogue
+                                    of `crc_model_catalog` */
+    uint32_t count;            /*!< Number of candidate models */
+    uint8_t skip_max;          /*!< Most leading bytes left out of the CRC,
+                                    e.g. a sync word */
+    uint8_t tail_max;          /*!< Most bytes after the CRC, e.g. an end
+                                    delimiter */
+    uint32_t max_failures;     /*!< Frames a candidate may fail and still
+                                    match, for captures with errors */
+    uint32_t threads;          /*!< Number of classifier threads, 0 for one
+                                    per CPU */
+} crc_classify_cfg_t;
+
+/**
+ * \brief           Model and trailer layout validating the frames.
+ *
+ * The CRC covers bytes `[skip, len - width / 8 - tail)` of a frame and is
+ * stored right after them.
+ */
+typedef struct {
+    const crc_model_t* model; /*!< The model */
+    uint8_t skip;             /*!< Leading bytes left out of the CRC */
+    uint8_t tail;             /*!< Bytes after the CRC */
+    bool big_endian;          /*!< Whether the CRC is stored big-endian;
+                                   always `false` for 8-bit models */
+    uint32_t matched;         /*!< Number of frames validated */
+} crc_classify_match_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Find the models and layouts that validate sample frames.
+ *
+ * Matches are given in the order of the candidate models, then by skip,
+ * tail and byte order. The models sharing a width, polynomial and bit order
+ * are run over the frames together, in parallel with the other such groups.
+ *
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[in]       bufs: Pointers to the frames
+ * \param[in]       lens: Lengths of the frames in bytes
+ * \param[in]       n: Number of frames
+ * \param[out]      matches: The matches found
+ * \param[in]       max_matches: Capacity of `matches`
+ * \return          Number of matches found, which may exceed `max_matches`;
+ *                  0 on invalid arguments or allocation errors
+ */
+uint32_t crc_classify(const crc_classify_cfg_t* cfg,
+                      const uint8_t* const bufs[], const uint32_t lens[],
+                      uint32_t n, crc_classify_match_t matches[],
+                      uint32_t max_matches);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_CLASSIFY_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,166 @@
+/**
+ * \file            crc_clmul.h
+ * \brief           CRC engine with carry-less multiply folding for any
+ *                  polynomial
+ * \date            2026-10-19
+ *
+ * This file provides a CRC engine for any model of width 1 to 64, custom or
+ * not, that folds the data with carry-less multiplies (PCLMULQDQ) where the CPU
+ * has them. The folding constants x^n mod P of the model's polynomial are
+ * computed when the context is initialized, so custom polynomials run on the
+ * same folding path as the standard ones. Short buffers, the head and the tail
+ * of long ones, and CPUs without the instructions use a byte-wise table.
+ *
+ * The parameters are those of the `crc*_init` models: width, polynomial,
+ * initial value, final XOR and input/output reflection.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_CLMUL_H__
+#define __CRC_CLMUL_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_clmul_manager CRC Carry-less Multiply Engine
+ * \brief           Computes CRCs of any model by carry-less folding.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Smallest update in bytes that is folded; shorter ones
+ *                  use the table.
+ */
+#ifndef CRC_CLMUL_MIN
+#define CRC_CLMUL_MIN 128
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           CRC model parameters of any width up to 64 bits.
+ */
+typedef struct {
+    uint8_t width;    /*!< Width of the CRC in bits, 1 to 64 */
+    uint64_t poly;    /*!< Polynomial, MSB-first without the top bit */
+    uint64_t init;    /*!< Initial value */
+    uint64_t xor_out; /*!< Final XOR value */
+    bool ref_in;      /*!< Whether to reverse the input data bits */
+    bool ref_out;     /*!< Whether to reverse the output data bits */
+} crc_clmul_param_t;
+
+/**
+ * \brief           CRC context of the carry-less multiply engine.
+ *
+ * Reflected models run a reflected register in the low bits, other models
+ * an MSB-first register in the high bits of `reg`.
+ */
+typedef struct {
+    crc_clmul_param_t param; /*!< The model */
+    uint64_t reg;            /*!< Running register */
+    uint64_t fold[4];        /*!< Folding constants: by 4 blocks, by 1 */
+    bool clmul;              /*!< Whether the folding path is used */
+    uint64_t table[256];     /*!< Byte-wise table */
+} crc_clmul_ctx_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize a context for a model.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[in]       param: Pointer to the model parameters
+ * \return          `true` on success, `false` if the parameters are invalid
+ */
+bool crc_clmul_init(crc_clmul_ctx_t* ctx, const crc_clmul_param_t* param);
+
+/**
+ * \brief           Initialize a context for a catalogue model.
+ *
+ * \param[out]      ctx: Pointer to the context
+ * \param[in]       model: The model, e.g. from `crc_model_find`
+ * \return          `true` on success, `false` if the model is invalid
+ */
+bool crc_clmul_init_model(crc_clmul_ctx_t* ctx, const crc_model_t* model);
+
+/**
+ * \brief           Restart the calculation from the initial value.
+ *
+ * \param[in,out]   ctx: Pointer to the context
+ */
+void crc_clmul_reset(crc_clmul_ctx_t* ctx);
+
+/**
+ * \brief           Update the CRC with new data.
+ *
+ * \param[in,out]   ctx: Pointer to the context
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ */
+void crc_clmul_update(crc_clmul_ctx_t* ctx, const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Get the CRC of the data seen so far.
+ *
+ * The context is left unchanged, so the update can go on.
+ *
+ * \param[in]       ctx: Pointer to the context
+ * \return          The CRC
+ */
+uint64_t crc_clmul_final(const crc_clmul_ctx_t* ctx);
+
+/**
+ * \brief           Calculate the CRC of a buffer.
+ *
+ * \param[in]       param: Pointer to the model parameters
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          The CRC, or 0 if the parameters are invalid
+ */
+uint64_t crc_clmul_calculate(const crc_clmul_param_t* param,
+                             const uint8_t* buf, uint32_t len);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_CLMUL_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
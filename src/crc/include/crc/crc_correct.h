@@ -0,0 +1,143 @@
+/**
+ * \file            crc_correct.h
+ * \brief           Single- and double-bit error correction for CRC16 and CRC32
+ *                  frames
+ * \date            2026-10-18
+ *
+ * This file provides an error locator for frames in the `crc16_pack_buf` /
+ * `crc32_pack_buf` layout. The syndrome of a failed frame (calculated CRC XOR
+ * stored CRC) only depends on the error pattern, so it is looked up in a hash
+ * index of the syndromes of every single-bit (and optionally double-bit) error
+ * up to a maximum frame length. The index is built on the first correction.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_CORRECT_H__
+#define __CRC_CORRECT_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_correct_manager CRC Error Correction
+ * \brief           Corrects bit errors of CRC16 and CRC32 protected frames.
+ * \{
+ */
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Entry of the syndrome index.
+ *
+ * Bit locations count from the end of the frame: `byte * 8 + bit`, where
+ * `byte` is the offset from the last byte of the frame and `bit` the bit
+ * number within that byte.
+ */
+typedef struct {
+    uint32_t syndrome; /*!< Calculated CRC XOR stored CRC */
+    uint32_t loc_a;    /*!< First bit location, or a marker */
+    uint32_t loc_b;    /*!< Second bit location of a double-bit error */
+} crc_correct_entry_t;
+
+/**
+ * \brief           Error correction context for one model and frame length.
+ */
+typedef struct {
+    uint8_t width;                /*!< CRC width in bits (16 or 32) */
+    uint8_t model;                /*!< CRC16 or CRC32 model */
+    bool double_bit;              /*!< Whether double-bit errors are indexed */
+    uint32_t max_len;             /*!< Maximum frame length incl. trailer */
+    crc_correct_entry_t* entries; /*!< Syndrome index, NULL until built */
+    uint32_t mask;                /*!< Index capacity - 1 */
+} crc_correct_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize an error correction context for CRC16 frames.
+ *
+ * The syndrome index is built lazily by the first call to
+ * `crc_correct_buf`.
+ *
+ * \param[out]      corr: Pointer to the context to be initialized
+ * \param[in]       model: The CRC16 model of the frames
+ * \param[in]       max_len: Maximum frame length, including the trailer
+ * \param[in]       double_bit: `true` to also correct double-bit errors
+ * \return          `true` on success, `false` if the arguments are invalid
+ */
+bool crc16_correct_init(crc_correct_t* corr, crc16_param_model_e model,
+                        uint32_t max_len, bool double_bit);
+
+/**
+ * \brief           Initialize an error correction context for CRC32 frames.
+ *
+ * \param[out]      corr: Pointer to the context to be initialized
+ * \param[in]       model: The CRC32 model of the frames
+ * \param[in]       max_len: Maximum frame length, including the trailer
+ * \param[in]       double_bit: `true` to also correct double-bit errors
+ * \return          `true` on success, `false` if the arguments are invalid
+ */
+bool crc32_correct_init(crc_correct_t* corr, crc32_param_model_e model,
+                        uint32_t max_len, bool double_bit);
+
+/**
+ * \brief           Verify a frame and correct it in place if possible.
+ *
+ * \param[in,out]   corr: Pointer to the error correction context
+ * \param[in,out]   buf: Pointer to the frame (data followed by the trailer)
+ * \param[in]       len: Length of the frame in bytes, at most `max_len`
+ * \return          Number of bits corrected (0 if the frame was valid), or -1
+ *                  if the error cannot be located unambiguously
+ */
+int crc_correct_buf(crc_correct_t* corr, uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Release the syndrome index of a context.
+ *
+ * \param[in,out]   corr: Pointer to the error correction context
+ */
+void crc_correct_deinit(crc_correct_t* corr);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_CORRECT_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
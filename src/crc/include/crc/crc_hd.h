@@ -0,0 +1,155 @@
+/**
+ * \file            crc_hd.h
+ * \brief           Hamming distance analysis of CRC polynomials
+ * \date            2026-10-19
+ *
+ * This file provides an analysis of the error detection strength of a CRC
+ * polynomial: the Hamming distance (HD) it guarantees, i.e. the smallest weight
+ * of an undetected bit error pattern, as a function of the data length, in the
+ * form of Koopman's published tables.
+ *
+ * An undetected error is a multiple of the generator polynomial. For each
+ * weight in turn, the shortest such multiple is searched for by increasing
+ * top term with the residues x^i mod G, looked up in hash tables of single and
+ * paired residues. The search for a weight stops at the first length where a
+ * lower weight was found, since the HD is already set beyond it; candidate top
+ * terms are shared among several threads.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_HD_H__
+#define __CRC_HD_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_hd_manager CRC Hamming Distance Analysis
+ * \brief           Computes the Hamming distance of CRC polynomials.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Highest error weight that can be searched for.
+ */
+#ifndef CRC_HD_WEIGHT_MAX
+#define CRC_HD_WEIGHT_MAX 16
+#endif
+
+/**
+ * \brief           Error weight searched for by default.
+ */
+#ifndef CRC_HD_WEIGHT_DEFAULT
+#define CRC_HD_WEIGHT_DEFAULT 8
+#endif
+
+/**
+ * \brief           Maximum number of residue pairs kept in the pair table,
+ *                  which speeds up the search at short lengths.
+ */
+#ifndef CRC_HD_PAIRS_MAX
+#define CRC_HD_PAIRS_MAX (1u << 20)
+#endif
+
+/**
+ * \brief           Maximum number of search threads.
+ */
+#ifndef CRC_HD_THREADS_MAX
+#define CRC_HD_THREADS_MAX 64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Analysis configuration.
+ */
+typedef struct {
+    uint8_t width;      /*!< Degree of the polynomial, 2 to 32 */
+    uint32_t poly;      /*!< Polynomial, MSB-first without the top bit; the
+                             x^0 term must be set */
+    uint32_t max_len;   /*!< Longest data length to analyse, in bits */
+    uint8_t weight_max; /*!< Highest error weight to search for, 0 for
+                             `CRC_HD_WEIGHT_DEFAULT` */
+    uint32_t threads;   /*!< Number of search threads, 0 for one per CPU */
+} crc_hd_cfg_t;
+
+/**
+ * \brief           Hamming distance of a polynomial by data length.
+ *
+ * `len[d]` is the longest data length in bits at which the HD is at least
+ * `d`, for `d` from 2 to `weight_max + 1`; it is `max_len` when the HD is at
+ * least `d` over all the lengths analysed.
+ */
+typedef struct {
+    uint32_t max_len;                    /*!< Longest data length analysed */
+    uint8_t weight_max;                  /*!< Highest error weight searched */
+    uint32_t len[CRC_HD_WEIGHT_MAX + 2]; /*!< Longest data length by HD */
+} crc_hd_table_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Compute the Hamming distance table of a polynomial.
+ *
+ * The cost grows with the data length at which the HD drops to each weight
+ * and steeply with the weight, so `max_len` and `weight_max` should not be
+ * larger than needed.
+ *
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[out]      table: Pointer to the table
+ * \return          `true` on success, `false` on invalid arguments or
+ *                  allocation errors
+ */
+bool crc_hd_analyze(const crc_hd_cfg_t* cfg, crc_hd_table_t* table);
+
+/**
+ * \brief           Get the Hamming distance at a data length.
+ *
+ * \param[in]       table: Pointer to the table
+ * \param[in]       len: Data length in bits, at most `max_len`
+ * \return          The HD; `weight_max + 1` means at least that much
+ */
+uint8_t crc_hd_at(const crc_hd_table_t* table, uint32_t len);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_HD_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,176 @@
+/**
+ * \file            crc_manifest.h
+ * \brief           Directory-tree checksum manifest with a persistent
+ *                  mtime/size cache
+ * \date            2026-10-19
+ *
+ * This file provides a `crcsum`-style manifest builder for directory trees.
+ * The tree is walked by several workers sharing a queue of directories to scan
+ * and files to read; every regular file is looked up in a persistent cache
+ * keyed by its inode, size and modification time, and only files missing from
+ * the cache are queued, read and hashed. The walk is POSIX only.
+ * A re-run over an unchanged tree therefore costs one `lstat` per file.
+ *
+ * The manifest lists one file per line, sorted by path:
+ *
+ *     <model> <crc>  <path>
+ *
+ * `<model>` is the model name (e.g. `CRC32`, `CRC16_MODBUS`) and `<crc>` the
+ * checksum in upper-case hexadecimal. As with `sha256sum`, a path containing a
+ * backslash or a newline is escaped (`\\`, `\n`) and its line starts with `\`.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_MANIFEST_H__
+#define __CRC_MANIFEST_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_manifest_manager CRC Manifest
+ * \brief           Builds checksum manifests of directory trees.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Version of the cache file format.
+ */
+#define CRC_MANIFEST_CACHE_VERSION 1
+
+/**
+ * \brief           Maximum number of worker threads.
+ */
+#ifndef CRC_MANIFEST_THREADS_MAX
+#define CRC_MANIFEST_THREADS_MAX   64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Manifest configuration.
+ */
+typedef struct {
+    uint8_t width;          /*!< CRC width in bits: 16 or 32 */
+    uint8_t model;          /*!< `crc16_param_model_e` or
+                                 `crc32_param_model_e`, as per `width` */
+    uint32_t threads;       /*!< Number of workers, 0 for one per CPU */
+    const char* cache_path; /*!< Persistent cache file, NULL for none */
+} crc_manifest_cfg_t;
+
+/**
+ * \brief           Manifest entry of a regular file.
+ */
+typedef struct {
+    char* path;       /*!< Path relative to the root, '/' separated */
+    uint64_t size;    /*!< File size in bytes */
+    int64_t mtime_ns; /*!< Modification time in nanoseconds */
+    uint64_t inode;   /*!< File serial number */
+    uint32_t crc;     /*!< Checksum of the file content */
+} crc_manifest_entry_t;
+
+/**
+ * \brief           Checksum manifest of a directory tree.
+ */
+typedef struct {
+    uint8_t width;                 /*!< CRC width in bits */
+    uint8_t model;                 /*!< CRC model */
+    crc_manifest_entry_t* entries; /*!< Entries sorted by path */
+    uint64_t count;                /*!< Number of entries */
+    uint64_t hashed;               /*!< Files read and hashed */
+    uint64_t cached;               /*!< Files served from the cache */
+    uint64_t errors;               /*!< Files or directories not readable */
+} crc_manifest_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Build the checksum manifest of a directory tree.
+ *
+ * Symbolic links are not followed. Unreadable files and directories are
+ * skipped and counted in `errors`. If `cfg->cache_path` is set, the cache is
+ * read before the walk and rewritten with the entries of the tree after it.
+ *
+ * The walk uses the POSIX directory interface and is not available on
+ * Windows, where this function always fails and leaves `mf` empty.
+ *
+ * \param[out]      mf: Pointer to the manifest, to be released with
+ *                  `crc_manifest_deinit`
+ * \param[in]       root: Root directory of the tree
+ * \param[in]       cfg: Pointer to the manifest configuration
+ * \return          `true` on success, `false` on invalid arguments,
+ *                  allocation errors, if the cache cannot be written or on
+ *                  Windows
+ */
+bool crc_manifest_build(crc_manifest_t* mf, const char* root,
+                        const crc_manifest_cfg_t* cfg);
+
+/**
+ * \brief           Write a manifest file.
+ *
+ * \param[in]       mf: Pointer to the manifest
+ * \param[in]       path: Path of the manifest file
+ * \return          `true` on success, `false` on I/O errors
+ */
+bool crc_manifest_write(const crc_manifest_t* mf, const char* path);
+
+/**
+ * \brief           Get the name of a CRC model, as written in manifests.
+ *
+ * \param[in]       width: CRC width in bits: 16 or 32
+ * \param[in]       model: The CRC16 or CRC32 model
+ * \return          The model name, or NULL if unknown
+ */
+const char* crc_manifest_model_name(uint8_t width, uint8_t model);
+
+/**
+ * \brief           Release the entries of a manifest.
+ *
+ * \param[in,out]   mf: Pointer to the manifest
+ */
+void crc_manifest_deinit(crc_manifest_t* mf);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_MANIFEST_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,160 @@
+/**
+ * \file            crc_model.h
+ * \brief           Generic CRC model descriptor and model catalogue
+ * \date            2026-10-19
+ *
+ * This file provides a width-independent description of a CRC model and a
+ * built-in catalogue of the CRC8, CRC16 and CRC32 models in common use, named
+ * as in the CRC RevEng catalogue. Every model of `crc8.h`, `crc16.h` and
+ * `crc32.h` is in the catalogue and refers back to its library model number.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_MODEL_H__
+#define __CRC_MODEL_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc32.h"
+#include "crc/crc8.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_model_manager CRC Model Catalogue
+ * \brief           Describes CRC models of any width up to 32 bits.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Library model number of catalogue entries that have no
+ *                  `crc*_param_model_e` value.
+ */
+#define CRC_MODEL_NONE 0xFF
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Description of a CRC model.
+ */
+typedef struct {
+    const char* name; /*!< Catalogue name, e.g. "CRC-16/MODBUS" */
+    uint8_t width;    /*!< Width of the CRC in bits: 8, 16 or 32 */
+    uint8_t model;    /*!< `crc*_param_model_e` value of the width, or
+                           `CRC_MODEL_NONE` */
+    uint32_t poly;    /*!< Polynomial, MSB-first without the top bit */
+    uint32_t init;    /*!< Initial value */
+    uint32_t xor_out; /*!< Final XOR value */
+    bool ref_in;      /*!< Whether to reverse the input data bits */
+    bool ref_out;     /*!< Whether to reverse the output data bits */
+    uint32_t check;   /*!< CRC of the ASCII string "123456789" */
+} crc_model_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Get the built-in model catalogue.
+ *
+ * \param[out]      count: Number of models in the catalogue
+ * \return          The models, sorted by width then name
+ */
+const crc_model_t* crc_model_catalog(uint32_t* count);
+
+/**
+ * \brief           Look up a model of the catalogue by name.
+ *
+ * \param[in]       name: Catalogue name, e.g. "CRC-32/ISO-HDLC"
+ * \return          The model, or NULL if the name is unknown
+ */
+const crc_model_t* crc_model_find(const char* name);
+
+/**
+ * \brief           Calculate the checksum of a buffer with any model.
+ *
+ * Meant for occasional use: the table of the model is built on each call.
+ * Models with a library model number are better served by `crc*_calculate`.
+ *
+ * \param[in]       model: Pointer to the model
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \return          The checksum
+ */
+uint32_t crc_model_calculate(const crc_model_t* model, const uint8_t* buf,
+                             uint32_t len);
+
+/**
+ * \brief           Initialize a CRC8 context with any 8-bit model.
+ *
+ * The context can then be used with `crc8_update` and `crc8_final`.
+ *
+ * \param[out]      ctx: Pointer to the context to be initialized
+ * \param[in]       model: Pointer to the model
+ * \return          `true` on success, `false` if the model is not 8 bits wide
+ */
+bool crc8_init_model(crc8_ctx_t* ctx, const crc_model_t* model);
+
+/**
+ * \brief           Initialize a CRC16 context with any 16-bit model.
+ *
+ * The context can then be used with `crc16_update` and `crc16_final`.
+ *
+ * \param[out]      ctx: Pointer to the context to be initialized
+ * \param[in]       model: Pointer to the model
+ * \return          `true` on success, `false` if the model is not 16 bits
+ *                  wide
+ */
+bool crc16_init_model(crc16_ctx_t* ctx, const crc_model_t* model);
+
+/**
+ * \brief           Initialize a CRC32 context with any 32-bit model.
+ *
+ * The context can then be used with `crc32_update` and `crc32_final`.
+ *
+ * \param[out]      ctx: Pointer to the context to be initialized
+ * \param[in]       model: Pointer to the model
+ * \return          `true` on success, `false` if the model is not 32 bits
+ *                  wide
+ */
+bool crc32_init_model(crc32_ctx_t* ctx, const crc_model_t* model);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_MODEL_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,168 @@
+/**
+ * \file            crc_multi.h
+ * \brief           Several CRC models computed in one pass
+ * \date            2026-10-19
+ *
+ * This file provides a context that computes several CRC models over the same
+ * bytes in a single traversal, e.g. a CRC16 header check and a CRC32 payload
+ * check, or `CRC16_MODBUS_MODEL` for legacy readers next to `CRC32_MODEL`.
+ * Every 64-bit word is loaded once and fed to the byte-wise kernel of each
+ * model; the models are independent dependency chains, interleaved byte by
+ * byte so that they overlap in the pipeline.
+ *
+ * Models that only differ in their initial value, final XOR or output
+ * reflection (e.g. the CRC16 models on 0x8005) share a single raw register
+ * run from 0. The contribution of each initial value is added at the end as
+ * init * x^(8 * len), in O(log len), so N candidate models cost one pass per
+ * polynomial plus O(N log len).
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_MULTI_H__
+#define __CRC_MULTI_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc32.h"
+#include "crc/crc8.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_multi_manager CRC Multi-Model Manager
+ * \brief           Computes several CRC models in one pass over the data.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Maximum number of models of a multi-model context.
+ */
+#ifndef CRC_MULTI_MAX
+#define CRC_MULTI_MAX 16
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           CRC model computed by a multi-model context.
+ */
+typedef struct {
+    uint8_t width; /*!< CRC width in bits: 8, 16 or 32 */
+    uint8_t model; /*!< `crc8_param_model_e`, `crc16_param_model_e` or
+                        `crc32_param_model_e`, as per `width` */
+} crc_multi_model_t;
+
+/**
+ * \brief           Multi-model CRC context.
+ */
+typedef struct {
+    uint32_t count; /*!< Number of models */
+    void* state;    /*!< Tables and running registers, private */
+} crc_multi_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize a multi-model context.
+ *
+ * The tables of the models are built once here; the context can then be
+ * reused for any number of messages with `crc_multi_reset`.
+ *
+ * \param[out]      multi: Pointer to the context, to be released with
+ *                  `crc_multi_deinit`
+ * \param[in]       models: The models to compute
+ * \param[in]       n: Number of models, 1 to `CRC_MULTI_MAX`
+ * \return          `true` on success, `false` on invalid models or
+ *                  allocation errors
+ */
+bool crc_multi_init(crc_multi_t* multi, const crc_multi_model_t models[],
+                    uint32_t n);
+
+/**
+ * \brief           Restart all models for a new message.
+ *
+ * \param[in,out]   multi: Pointer to the context
+ */
+void crc_multi_reset(crc_multi_t* multi);
+
+/**
+ * \brief           Feed data to all models.
+ *
+ * \param[in,out]   multi: Pointer to the context
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ */
+void crc_multi_update(crc_multi_t* multi, const uint8_t* buf, uint32_t len);
+
+/**
+ * \brief           Get the checksums of the data fed so far.
+ *
+ * The context is left unchanged and can be fed further.
+ *
+ * \param[in]       multi: Pointer to the context
+ * \param[out]      crcs: The checksum of each model, in the order of
+ *                  `crc_multi_init`
+ */
+void crc_multi_final(const crc_multi_t* multi, uint32_t crcs[]);
+
+/**
+ * \brief           Calculate the checksums of a buffer.
+ *
+ * Shorthand for `crc_multi_reset`, `crc_multi_update` and `crc_multi_final`.
+ *
+ * \param[in,out]   multi: Pointer to the context
+ * \param[in]       buf: Pointer to the data
+ * \param[in]       len: Length of the data in bytes
+ * \param[out]      crcs: The checksum of each model
+ */
+void crc_multi_calculate(crc_multi_t* multi, const uint8_t* buf, uint32_t len,
+                         uint32_t crcs[]);
+
+/**
+ * \brief           Release a multi-model context.
+ *
+ * \param[in,out]   multi: Pointer to the context
+ */
+void crc_multi_deinit(crc_multi_t* multi);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_MULTI_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,148 @@
+/**
+ * \file            crc_reveng.h
+ * \brief           CRC model parameter reverse-engineering
+ * \date            2026-10-19
+ *
+ * This file provides a solver that recovers the parameters of an unknown CRC
+ * model (polynomial, initial value, final XOR and bit reflections) from
+ * captured message/CRC pairs, in the way of CRC RevEng.
+ *
+ * XORing two messages of the same length cancels the initial value and the
+ * final XOR, leaving a multiple of the polynomial: the polynomial divides the
+ * GCD of these multiples over GF(2). When the GCD has a higher degree than the
+ * width, its divisors of the right degree are searched for by several threads,
+ * testing a batch of candidates per pass over the GCD. With the polynomial
+ * known, the initial value and final XOR are the solutions of a linear system
+ * over GF(2), of which a catalogue model is preferred.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_REVENG_H__
+#define __CRC_REVENG_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_reveng_manager CRC Reverse-Engineering
+ * \brief           Recovers CRC model parameters from samples.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Maximum number of equal-length sample pairs used to find
+ *                  the polynomial.
+ */
+#ifndef CRC_REVENG_PAIRS_MAX
+#define CRC_REVENG_PAIRS_MAX 16
+#endif
+
+/**
+ * \brief           Maximum number of candidate polynomials per reflection
+ *                  setting.
+ */
+#ifndef CRC_REVENG_POLYS_MAX
+#define CRC_REVENG_POLYS_MAX 64
+#endif
+
+/**
+ * \brief           Maximum number of search threads.
+ */
+#ifndef CRC_REVENG_THREADS_MAX
+#define CRC_REVENG_THREADS_MAX 64
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Captured message and its CRC.
+ */
+typedef struct {
+    const uint8_t* buf; /*!< The message, without its CRC */
+    uint32_t len;       /*!< Length of the message in bytes */
+    uint32_t crc;       /*!< The CRC of the message */
+} crc_reveng_sample_t;
+
+/**
+ * \brief           Solver configuration.
+ */
+typedef struct {
+    uint8_t width;    /*!< CRC width in bits: 8, 16 or 32 */
+    uint32_t poly;    /*!< Known polynomial, 0 to solve for it */
+    bool exhaustive;  /*!< Whether a 32-bit polynomial may be searched for
+                           exhaustively when the GCD is not conclusive;
+                           narrower widths always are */
+    uint32_t threads; /*!< Number of search threads, 0 for one per CPU */
+} crc_reveng_cfg_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Recover the CRC models that produce the samples.
+ *
+ * The polynomial can only be solved for with at least two samples of the
+ * same length. The initial value and final XOR are only determined up to
+ * what the samples cannot tell apart: all of the initial value when every
+ * sample has the same length, and some of its bits when the polynomial
+ * shares a factor with `x^(8 * d) + 1` for the differences `d` of the
+ * lengths, as polynomials divisible by `x + 1` do. A catalogue model
+ * consistent with the samples is then preferred; otherwise the undetermined
+ * bits of the initial value are given as 0.
+ * Each model found reproduces every sample. Models of the catalogue are
+ * returned with their name and library model number.
+ *
+ * \param[in]       cfg: Pointer to the configuration
+ * \param[in]       samples: The samples
+ * \param[in]       n: Number of samples
+ * \param[out]      models: The models found, usable with `crc*_init_model`
+ * \param[in]       max_models: Capacity of `models`
+ * \return          Number of models found, which may exceed `max_models`;
+ *                  0 on invalid arguments or allocation errors
+ */
+uint32_t crc_reveng(const crc_reveng_cfg_t* cfg,
+                    const crc_reveng_sample_t samples[], uint32_t n,
+                    crc_model_t models[], uint32_t max_models);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_REVENG_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,239 @@
+/**
+ * \file            crc_scrubber.h
+ * \brief           Rate-limited background integrity scrubber
+ * \date            2026-10-19
+ *
+ * This file provides a background integrity scrubber shared by an application:
+ * memory ranges and file ranges are registered with their expected checksum and
+ * a worker re-verifies them continuously, one slice at a time. The worker runs
+ * at the lowest thread priority on Windows and the highest nice value on Linux,
+ * and is throttled by a token bucket (bytes per second) and by a CPU-time
+ * budget (share of one CPU, in thread CPU time), sleeping between slices so
+ * that foreground work is not starved. Mismatches are reported through a
+ * callback.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_SCRUBBER_H__
+#define __CRC_SCRUBBER_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+#include "crc/crc16.h"
+#include "crc/crc32.h"
+#include "crc/crc8.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_scrubber_manager CRC Scrubber
+ * \brief           Re-verifies registered data in the background.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Default number of bytes verified per slice.
+ */
+#ifndef CRC_SCRUBBER_SLICE
+#define CRC_SCRUBBER_SLICE      (256 * 1024)
+#endif
+
+/**
+ * \brief           Longest sleep of the worker in seconds, which bounds the
+ *                  latency of `crc_scrubber_stop`.
+ */
+#ifndef CRC_SCRUBBER_SLEEP_MAX
+#define CRC_SCRUBBER_SLEEP_MAX  0.01
+#endif
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Callback invoked when a region does not match its
+ *                  expected checksum.
+ *
+ * It is called from the worker, or from `crc_scrubber_step`, without any
+ * lock held.
+ *
+ * \param[in]       arg: User argument of the configuration
+ * \param[in]       id: Identifier of the region
+ * \param[in]       expected: Expected checksum
+ * \param[in]       actual: Checksum found
+ */
+typedef void (*crc_scrubber_mismatch_fn)(void* arg, uint32_t id,
+                                         uint32_t expected, uint32_t actual);
+
+/**
+ * \brief           Scrubber configuration.
+ */
+typedef struct {
+    uint64_t bytes_per_sec;               /*!< Bandwidth budget, 0 for none */
+    double cpu_share;                     /*!< Share of one CPU in (0, 1],
+                                               0 for no cap */
+    uint32_t slice;                       /*!< Bytes per slice, 0 for
+                                               `CRC_SCRUBBER_SLICE` */
+    crc_scrubber_mismatch_fn on_mismatch; /*!< Mismatch callback */
+    void* arg;                            /*!< Callback argument */
+} crc_scrubber_cfg_t;
+
+/**
+ * \brief           Region to be scrubbed.
+ *
+ * A memory region is given by `buf`; a file region by `path` and `offset`
+ * when `buf` is NULL. A memory region must stay valid until it is removed.
+ */
+typedef struct {
+    uint8_t width;       /*!< CRC width in bits: 8, 16 or 32 */
+    uint8_t model;       /*!< `crc8_param_model_e`, `crc16_param_model_e` or
+                              `crc32_param_model_e`, as per `width` */
+    const uint8_t* buf;  /*!< Memory to verify, or NULL for a file */
+    const char* path;    /*!< File to verify, copied */
+    uint64_t offset;     /*!< Offset of the range in the file */
+    uint64_t len;        /*!< Length of the range in bytes, non-zero */
+    uint32_t expected;   /*!< Expected `crc*_calculate` value of the range */
+} crc_scrubber_region_t;
+
+/**
+ * \brief           Scrubber statistics.
+ */
+typedef struct {
+    uint64_t bytes;      /*!< Bytes verified */
+    uint64_t passes;     /*!< Regions verified to their end */
+    uint64_t mismatches; /*!< Regions found not matching */
+    uint64_t errors;     /*!< Regions that could not be read */
+    double throttled;    /*!< Seconds slept by the worker for the budgets */
+} crc_scrubber_stats_t;
+
+/**
+ * \brief           Scrubber service.
+ */
+typedef struct {
+    crc_scrubber_cfg_t cfg; /*!< Configuration */
+    void* state;            /*!< Regions, worker and statistics, private */
+} crc_scrubber_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Initialize a scrubber.
+ *
+ * \param[out]      scrubber: Pointer to the scrubber, to be released with
+ *                  `crc_scrubber_deinit`
+ * \param[in]       cfg: Pointer to the configuration
+ * \return          `true` on success, `false` on invalid arguments or
+ *                  allocation errors
+ */
+bool crc_scrubber_init(crc_scrubber_t* scrubber,
+                       const crc_scrubber_cfg_t* cfg);
+
+/**
+ * \brief           Register a region.
+ *
+ * May be called while the worker runs.
+ *
+ * \param[in,out]   scrubber: Pointer to the scrubber
+ * \param[in]       region: Pointer to the region, copied
+ * \param[out]      id: Identifier of the region
+ * \return          `true` on success, `false` on invalid arguments or
+ *                  allocation errors
+ */
+bool crc_scrubber_add(crc_scrubber_t* scrubber,
+                      const crc_scrubber_region_t* region, uint32_t* id);
+
+/**
+ * \brief           Unregister a region.
+ *
+ * May be called while the worker runs, including from the callback. Once
+ * the function returns the region is no longer accessed.
+ *
+ * \param[in,out]   scrubber: Pointer to the scrubber
+ * \param[in]       id: Identifier of the region
+ * \return          `true` on success, `false` if the region is unknown
+ */
+bool crc_scrubber_remove(crc_scrubber_t* scrubber, uint32_t id);
+
+/**
+ * \brief           Verify the next slices, without throttling.
+ *
+ * Regions are verified in turn, a slice at a time. This is what the worker
+ * runs between its sleeps; it can also be called directly by applications
+ * scheduling the work themselves.
+ *
+ * \param[in,out]   scrubber: Pointer to the scrubber
+ * \param[in]       max_bytes: Maximum number of bytes to verify
+ * \return          Number of bytes verified, 0 if no region is registered
+ */
+uint64_t crc_scrubber_step(crc_scrubber_t* scrubber, uint64_t max_bytes);
+
+/**
+ * \brief           Start the background worker.
+ *
+ * \param[in,out]   scrubber: Pointer to the scrubber
+ * \return          `true` on success, `false` if threads are not available
+ *                  or the worker is already running
+ */
+bool crc_scrubber_start(crc_scrubber_t* scrubber);
+
+/**
+ * \brief           Stop the background worker and wait for it.
+ *
+ * \param[in,out]   scrubber: Pointer to the scrubber
+ */
+void crc_scrubber_stop(crc_scrubber_t* scrubber);
+
+/**
+ * \brief           Get the statistics of a scrubber.
+ *
+ * \param[in]       scrubber: Pointer to the scrubber
+ * \param[out]      stats: Pointer to the statistics
+ */
+void crc_scrubber_stats(crc_scrubber_t* scrubber,
+                        crc_scrubber_stats_t* stats);
+
+/**
+ * \brief           Release a scrubber, stopping its worker.
+ *
+ * \param[in,out]   scrubber: Pointer to the scrubber
+ */
+void crc_scrubber_deinit(crc_scrubber_t* scrubber);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_SCRUBBER_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
@@ -0,0 +1,147 @@
+/**
+ * \file            crc_tier.h
+ * \brief           Table-size tiers of the lookup-table CRC engines
+ * \date            2026-10-19
+ *
+ * This file provides the table-size tiers of the lookup-table CRC engines
+ * (`crc8_lookup`, `crc16_lookup` and `crc32_lookup`) and a report of what each
+ * tier costs on the current host. A tier trades table memory, and so data cache
+ * footprint, for bytes taken per step:
+ *
+ * - nibble: a built-in 16-entry table, two lookups per byte;
+ * - byte: one 256-entry table, one lookup per byte;
+ * - slicing-by-4/8/16: as many 256-entry tables, one step per 4/8/16 bytes.
+ *
+ * The default tier of a width is set at build time by `CRC8_LOOKUP_SLICE`,
+ * `CRC16_LOOKUP_SLICE` and `CRC32_LOOKUP_SLICE`, and the largest tier a context
+ * can select by the matching `*_LOOKUP_SLICE_MAX`, which also bounds the static
+ * tables the library holds. Both default to the nibble tier, so the larger
+ * tables are opt-in. Each context can then select its own tier, up to the
+ * largest, with `crc*_lookup_set_tier`.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __CRC_TIER_H__
+#define __CRC_TIER_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        crc_tier_manager CRC Table Tiers
+ * \brief           Selects and reports the table size of lookup engines.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Number of table tiers, the size of a full report.
+ */
+#define CRC_TIER_COUNT 5
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Table-size tier of a lookup engine.
+ *
+ * The value of a table tier is the number of bytes taken per step, which is
+ * also its number of 256-entry tables.
+ */
+typedef enum {
+    CRC_TIER_NIBBLE = 0,   /*!< 16-entry table, half a byte per lookup */
+    CRC_TIER_BYTE = 1,     /*!< 256-entry table, one byte per lookup */
+    CRC_TIER_SLICE4 = 4,   /*!< 4 tables, slicing-by-4 */
+    CRC_TIER_SLICE8 = 8,   /*!< 8 tables, slicing-by-8 */
+    CRC_TIER_SLICE16 = 16, /*!< 16 tables, slicing-by-16 */
+} crc_tier_e;
+
+/**
+ * \brief           Cost of a table tier on the current host.
+ */
+typedef struct {
+    crc_tier_e tier;       /*!< The table tier */
+    uint32_t table_bytes;  /*!< Table bytes read by a context of this tier */
+    uint32_t static_bytes; /*!< Slicing tables reserved by the library for
+                                the width, whatever the tier */
+    double bytes_per_sec;  /*!< Measured throughput, 0 if not measured */
+} crc_tier_report_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Check whether a value is one of the table tiers.
+ *
+ * \param[in]       tier: The value to check
+ * \return          `true` if `tier` is a table tier, `false` otherwise
+ */
+bool crc_tier_is_valid(crc_tier_e tier);
+
+/**
+ * \brief           Get the table bytes read by a context of a tier.
+ *
+ * \param[in]       width: CRC width in bits: 8, 16 or 32
+ * \param[in]       tier: The table tier
+ * \return          Table size in bytes, 0 if the width or tier is invalid
+ */
+uint32_t crc_tier_table_bytes(uint8_t width, crc_tier_e tier);
+
+/**
+ * \brief           Report the tiers a lookup engine can select on this host.
+ *
+ * One entry is written per tier allowed by the `*_LOOKUP_SLICE_MAX` of the
+ * width, from the smallest table up. Besides the table bytes a context of the
+ * tier reads, each entry gives the static tables reserved for all polynomials
+ * and bit orders of the width, the memory cost of allowing the largest tier.
+ * When `seconds` is positive, the time is split among the tiers and each one
+ * is timed over a cache-resident buffer with the first model of the width;
+ * building the slicing tables on first use is not counted.
+ *
+ * \param[in]       width: CRC width in bits: 8, 16 or 32
+ * \param[out]      reports: Array of `CRC_TIER_COUNT` entries
+ * \param[in]       seconds: Total measuring time, 0 to skip the measurement
+ * \return          Number of entries written, 0 if the width is invalid
+ */
+uint32_t crc_tier_report(uint8_t width, crc_tier_report_t reports[],
+                         double seconds);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_TIER_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
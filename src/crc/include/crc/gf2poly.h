@@ -0,0 +1,236 @@
+/**
+ * \file            gf2poly.h
+ * \brief           Polynomial arithmetic over GF(2)
+ * \date            2026-10-19
+ *
+ * This file provides arithmetic on polynomials over GF(2) modulo a polynomial
+ * P of degree 1 to 64, the primitives behind CRC combination, zero extension,
+ * patching and range queries: carry-less multiplication, multiplication and
+ * exponentiation modulo P, and Barrett reduction.
+ *
+ * Polynomials are held MSB-first: bit i holds the coefficient of x^i, and P is
+ * given without its x^width term, as the `poly` of a CRC model. On x86-64 CPUs
+ * with PCLMULQDQ the Barrett reduction runs on carry-less multiplies, selected
+ * at run time; elsewhere a portable shift-and-add path gives the same results.
+ */
+
+/*
+ * Copyright (c) 2024 Vector Qiu
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of the CRC library.
+ *
+ * Author:          Vector Qiu <vetor.qiu@gmail.com>
+ * Version:         v0.0.1
+ */
+#ifndef __GF2POLY_H__
+#define __GF2POLY_H__
+
+/* includes ----------------------------------------------------------------- */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        gf2poly_manager GF(2) Polynomial Arithmetic
+ * \brief           Multiplies and raises polynomials modulo a polynomial.
+ * \{
+ */
+
+/* Public configuration ----------------------------------------------------- */
+/**
+ * \brief           Number of cached squarings, one per bit of an exponent.
+ */
+#define GF2POLY_POWERS 64
+
+/* Public typedefs ---------------------------------------------------------- */
+/**
+ * \brief           Barrett reduction constants of a polynomial.
+ */
+typedef struct {
+    uint64_t poly; /*!< P without its x^width term */
+    uint64_t mu;   /*!< x^(2 width) / P without its x^width term */
+    uint8_t width; /*!< Degree of P, 1 to 64 */
+} gf2poly_barrett_t;
+
+/**
+ * \brief           Cache of the squarings of a base modulo a polynomial.
+ *
+ * Raising the base to any power then takes one multiplication per set bit
+ * of the exponent, and no squaring.
+ */
+typedef struct {
+    gf2poly_barrett_t barrett;     /*!< Reduction constants of P */
+    uint64_t pow[GF2POLY_POWERS]; /*!< base^(2^k) mod P */
+} gf2poly_powers_t;
+
+/* Public functions --------------------------------------------------------- */
+/**
+ * \brief           Check whether the carry-less multiply path is used.
+ *
+ * \return          `true` if the CPU and the build support it
+ */
+bool gf2poly_has_clmul(void);
+
+/**
+ * \brief           Multiply two polynomials without reduction.
+ *
+ * \param[in]       a: First factor
+ * \param[in]       b: Second factor
+ * \param[out]      hi: Coefficients of x^64 to x^126 of the product
+ * \param[out]      lo: Coefficients of x^0 to x^63 of the product
+ */
+void gf2poly_clmul(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo);
+
+/**
+ * \brief           Multiply two polynomials modulo P.
+ *
+ * For many products modulo the same P, `gf2poly_barrett_mulmod` is faster.
+ *
+ * \param[in]       a: First factor, of degree below `width`
+ * \param[in]       b: Second factor, of degree below `width`
+ * \param[in]       poly: P without its x^width term
+ * \param[in]       width: Degree of P, 1 to 64
+ * \return          a * b mod P
+ */
+uint64_t gf2poly_mulmod(uint64_t a, uint64_t b, uint64_t poly, uint8_t width);
+
+/**
+ * \brief           Raise a polynomial to a power modulo P.
+ *
+ * \param[in]       a: The base, of degree below `width`
+ * \param[in]       n: The exponent
+ * \param[in]       poly: P without its x^width term
+ * \param[in]       width: Degree of P, 1 to 64
+ * \return          a^n mod P
+ */
+uint64_t gf2poly_powmod(uint64_t a, uint64_t n, uint64_t poly, uint8_t width);
+
+/**
+ * \brief           Compute x^n modulo P.
+ *
+ * \param[in]       n: The exponent
+ * \param[in]       poly: P without its x^width term
+ * \param[in]       width: Degree of P, 1 to 64
+ * \return          x^n mod P
+ */
+uint64_t gf2poly_xpow(uint64_t n, uint64_t poly, uint8_t width);
+
+/**
+ * \brief           Compute x^(8n) modulo P.
+ *
+ * This is what `n` zero bytes multiply an MSB-first CRC register by.
+ *
+ * \param[in]       n: Number of bytes
+ * \param[in]       poly: P without its x^width term
+ * \param[in]       width: Degree of P, 1 to 64
+ * \return          x^(8n) mod P
+ */
+uint64_t gf2poly_xpow8n(uint64_t n, uint64_t poly, uint8_t width);
+
+/**
+ * \brief           Compute the inverse of x modulo P.
+ *
+ * \param[in]       poly: P without its x^width term, with its x^0 term set
+ * \param[in]       width: Degree of P, 1 to 64
+ * \return          x^-1 mod P, or 0 if x is not invertible
+ */
+uint64_t gf2poly_xinv(uint64_t poly, uint8_t width);
+
+/**
+ * \brief           Compute the Barrett reduction constants of P.
+ *
+ * \param[out]      barrett: Pointer to the constants
+ * \param[in]       poly: P without its x^width term
+ * \param[in]       width: Degree of P, 1 to 64
+ */
+void gf2poly_barrett_init(gf2poly_barrett_t* barrett, uint64_t poly,
+                          uint8_t width);
+
+/**
+ * \brief           Reduce a polynomial of degree below `2 * width` modulo P.
+ *
+ * \param[in]       barrett: Pointer to the constants of P
+ * \param[in]       hi: Coefficients of x^64 and up
+ * \param[in]       lo: Coefficients of x^0 to x^63
+ * \return          The polynomial mod P
+ */
+uint64_t gf2poly_barrett_reduce(const gf2poly_barrett_t* barrett, uint64_t hi,
+                                uint64_t lo);
+
+/**
+ * \brief           Multiply two polynomials modulo P.
+ *
+ * \param[in]       barrett: Pointer to the constants of P
+ * \param[in]       a: First factor, of degree below `width`
+ * \param[in]       b: Second factor, of degree below `width`
+ * \return          a * b mod P
+ */
+uint64_t gf2poly_barrett_mulmod(const gf2poly_barrett_t* barrett, uint64_t a,
+                                uint64_t b);
+
+/**
+ * \brief           Cache the squarings of a base modulo P.
+ *
+ * \param[out]      powers: Pointer to the cache
+ * \param[in]       base: The base, e.g. x^8 for byte shifts of a CRC or
+ *                  `gf2poly_xinv` for shifts backwards
+ * \param[in]       poly: P without its x^width term
+ * \param[in]       width: Degree of P, 1 to 64
+ */
+void gf2poly_powers_init(gf2poly_powers_t* powers, uint64_t base,
+                         uint64_t poly, uint8_t width);
+
+/**
+ * \brief           Raise the cached base to a power.
+ *
+ * \param[in]       powers: Pointer to the cache
+ * \param[in]       n: The exponent
+ * \return          base^n mod P
+ */
+uint64_t gf2poly_powers_get(const gf2poly_powers_t* powers, uint64_t n);
+
+/**
+ * \brief           Multiply a polynomial by a power of the cached base.
+ *
+ * \param[in]       powers: Pointer to the cache
+ * \param[in]       a: The polynomial, of degree below `width`
+ * \param[in]       n: The exponent
+ * \return          a * base^n mod P
+ */
+uint64_t gf2poly_powers_mul(const gf2poly_powers_t* powers, uint64_t a,
+                            uint64_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GF2POLY_H__ */
+
+/* ----------------------------- end of file -------------------------------- */
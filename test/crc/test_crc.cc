@@ -33,16 +33,47 @@
  * Version:         v0.0.1
  */
 /* includes ----------------------------------------------------------------- */
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+#include <vector>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
 
 #include "crc/crc16.h"
 #include "crc/crc16_lookup.h"
+#include "crc/crc16_modbus.h"
+#include "crc/crc16_prefix.h"
 #include "crc/crc32.h"
+#include "crc/crc32_assembler.h"
 #include "crc/crc32_lookup.h"
+#include "crc/crc32_merkle.h"
+#include "crc/crc32_range.h"
+#include "crc/crc32_region.h"
+#include "crc/crc32_scrub.h"
+#include "crc/crc32_sidecar.h"
 #include "crc/crc8.h"
 #include "crc/crc8_lookup.h"
+#include "crc/crc_checkpoint.h"
+#include "crc/crc_classify.h"
+#include "crc/crc_clmul.h"
+#include "crc/crc_correct.h"
+#include "crc/crc_hd.h"
+#include "crc/crc_manifest.h"
+#include "crc/crc_model.h"
+#include "crc/crc_multi.h"
+#include "crc/crc_reveng.h"
+#include "crc/crc_scrubber.h"
+#include "crc/crc_tier.h"
+#include "crc/gf2poly.h"
 
 /* Private configuration ---------------------------------------------------- */
 
@@ -103,6 +134,29 @@ TEST(CRC8LookupTest, LookupCalculate) {
     }
 }
 
+TEST(CRC8LookupTest, SlicedUpdateMatchesBitwise) {
+    uint8_t data[300];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 151 + (i >> 3));
+    }
+
+    for (int m = 0; m < CRC8_NONE_LOOKUP_MODEL; m++) {
+        for (uint32_t len = 0; len < 40; len++) {
+            crc8_lookup_ctx_t lookup;
+            crc8_lookup_init(&lookup, (crc8_lookup_param_model_e)m);
+            crc8_ctx_t ctx = {lookup.init, lookup.xor_out, lookup.poly,
+                              lookup.ref_in, lookup.ref_out};
+
+            // Split so that both calls have a partial step
+            crc8_update(&ctx, data, len);
+            crc8_lookup_update(&lookup, data, len / 3);
+            crc8_lookup_update(&lookup, data + len / 3, len - len / 3);
+            EXPECT_EQ(crc8_lookup_final(&lookup), crc8_final(&ctx))
+                << m << " " << len;
+        }
+    }
+}
+
 TEST(CRC8LookupTest, LookupPackAndVerify) {
     uint8_t data[6] = {0x31, 0x32, 0x33,
                        0x34, 0x35, 0x00}; // Reserve space for CRC
@@ -181,6 +235,35 @@ TEST(CRC16Test, LargeData_PackAndVerify) {
     }
 }
 
+TEST(CRC16Test, FoldedUpdate) {
+    std::vector<uint8_t> data(4099);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 131 + (i >> 5));
+    }
+
+    // Updates shorter than the crossover stay on the bitwise loop
+    for (int i = 0; i < CRC16_NONE_MODEL; i++) {
+        for (uint32_t len : {127u, 128u, 143u, 1000u, 4099u}) {
+            crc16_ctx_t ctx;
+            crc16_lookup_ctx_t lookup;
+            crc16_init(&ctx, (crc16_param_model_e)i);
+            for (uint32_t off = 0; off < len; off += 32) {
+                crc16_update(&ctx, data.data() + off, std::min(32u, len - off));
+            }
+            uint16_t expect = crc16_final(&ctx);
+
+            EXPECT_EQ(crc16_calculate((crc16_param_model_e)i, data.data(), len),
+                      expect)
+                << i << " " << len;
+
+            crc16_lookup_init(&lookup, (crc16_lookup_param_model_e)i);
+            crc16_lookup_update(&lookup, data.data(), 7);
+            crc16_lookup_update(&lookup, data.data() + 7, len - 7);
+            EXPECT_EQ(crc16_lookup_final(&lookup), expect) << i << " " << len;
+        }
+    }
+}
+
 TEST(CRC16LookupTest, LookupCalculate) {
     uint8_t data[] = {0x31, 0x32, 0x33, 0x34, 0x35}; // "12345"
 
@@ -201,6 +284,29 @@ TEST(CRC16LookupTest, LookupCalculate) {
     }
 }
 
+TEST(CRC16LookupTest, SlicedUpdateMatchesBitwise) {
+    uint8_t data[300];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 151 + (i >> 3));
+    }
+
+    for (int m = 0; m < CRC16_NONE_LOOKUP_MODEL; m++) {
+        for (uint32_t len = 0; len < 40; len++) {
+            crc16_lookup_ctx_t lookup;
+            crc16_lookup_init(&lookup, (crc16_lookup_param_model_e)m);
+            crc16_ctx_t ctx = {lookup.init, lookup.xor_out, lookup.poly,
+                               lookup.ref_in, lookup.ref_out};
+
+            // Split so that both calls have a partial step
+            crc16_update(&ctx, data, len);
+            crc16_lookup_update(&lookup, data, len / 3);
+            crc16_lookup_update(&lookup, data + len / 3, len - len / 3);
+            EXPECT_EQ(crc16_lookup_final(&lookup), crc16_final(&ctx))
+                << m << " " << len;
+        }
+    }
+}
+
 TEST(CRC16LookupTest, LookupPackAndVerify) {
     uint8_t data[6] = {0x31, 0x32, 0x33,
                        0x34, 0x35, 0x00}; // Reserve space for CRC
@@ -353,6 +459,1680 @@ TEST(CRC32LookupTest, StepByStepCalculate) {
     EXPECT_EQ(result, 0xCBF53A1C); // 验证结果
 }
 
+TEST(CRC16PrefixTest, ResumeFromSnapshot) {
+    uint8_t frame[] = {0x11, 0x03, 0x00, 0x6B, 0x00, 0x03}; // Modbus request
+    for (int i = 0; i < CRC16_NONE_MODEL; i++) {
+        crc16_prefix_t prefix;
+        crc16_prefix_init(&prefix, (crc16_param_model_e)i, frame, 2);
+        uint16_t result = crc16_prefix_calculate(&prefix, frame + 2,
+                                                 sizeof(frame) - 2);
+        EXPECT_EQ(result, crc16_calculate((crc16_param_model_e)i, frame,
+                                          sizeof(frame)));
+        // The snapshot can be reused
+        EXPECT_EQ(crc16_prefix_calculate(&prefix, frame + 2, 0),
+                  crc16_calculate((crc16_param_model_e)i, frame, 2));
+    }
+}
+
+TEST(CRC16PrefixTest, CacheKeepsHotPrefixes) {
+    crc16_prefix_entry_t entries[4];
+    crc16_prefix_cache_t cache;
+    ASSERT_FALSE(crc16_prefix_cache_init(&cache, entries, 3));
+    ASSERT_TRUE(crc16_prefix_cache_init(&cache, entries, 4));
+
+    uint8_t frame[8] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00};
+    for (int round = 0; round < 4; round++) {
+        for (uint8_t slave = 1; slave <= 3; slave++) {
+            frame[0] = slave;
+            frame[5] = (uint8_t)(round + slave);
+            uint16_t result = crc16_prefix_cache_calculate(
+                &cache, CRC16_MODBUS_MODEL, frame, 6, 2);
+            EXPECT_EQ(result, crc16_calculate(CRC16_MODBUS_MODEL, frame, 6));
+        }
+    }
+    EXPECT_EQ(cache.misses, 3u);
+    EXPECT_EQ(cache.hits, 9u);
+
+    // Prefixes longer than the key size bypass the cache
+    uint8_t long_frame[CRC16_PREFIX_KEY_MAX + 2] = {0};
+    EXPECT_EQ(crc16_prefix_cache_calculate(&cache, CRC16_MODBUS_MODEL,
+                                           long_frame, sizeof(long_frame),
+                                           CRC16_PREFIX_KEY_MAX + 1),
+              crc16_calculate(CRC16_MODBUS_MODEL, long_frame,
+                              sizeof(long_frame)));
+    EXPECT_EQ(cache.misses, 3u);
+}
+
+TEST(CRC8Test, VerifyStream) {
+    uint8_t frame[6] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x00};
+
+    for (int i = 0; i < CRC8_NONE_MODEL; i++) {
+        crc8_param_model_e model = (crc8_param_model_e)i;
+        crc8_pack_buf(model, frame, sizeof(frame));
+        EXPECT_EQ(crc8_calculate(model, frame, sizeof(frame)),
+                  crc8_residue(model));
+
+        crc8_stream_t stream;
+        crc8_verify_stream_init(&stream, model);
+        crc8_verify_stream_update(&stream, frame, 4);
+        crc8_verify_stream_update(&stream, frame + 4, 2);
+        EXPECT_TRUE(crc8_verify_stream(&stream));
+    }
+}
+
+TEST(CRC16Test, VerifyStream) {
+    uint8_t frame[9] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37};
+
+    for (int i = 0; i < CRC16_NONE_MODEL; i++) {
+        crc16_param_model_e model = (crc16_param_model_e)i;
+        crc16_pack_buf(model, frame, sizeof(frame));
+
+        // Feed the frame byte by byte: only the full frame is valid
+        crc16_stream_t stream;
+        crc16_verify_stream_init(&stream, model);
+        for (uint32_t j = 0; j < sizeof(frame); j++) {
+            EXPECT_FALSE(crc16_verify_stream(&stream));
+            crc16_verify_stream_update(&stream, frame + j, 1);
+        }
+        EXPECT_TRUE(crc16_verify_stream(&stream));
+
+        // Same frame in uneven chunks, then corrupted
+        crc16_verify_stream_init(&stream, model);
+        crc16_verify_stream_update(&stream, frame, 5);
+        crc16_verify_stream_update(&stream, frame + 5, 4);
+        EXPECT_TRUE(crc16_verify_stream(&stream));
+        frame[8] ^= 0x01;
+        crc16_verify_stream_init(&stream, model);
+        crc16_verify_stream_update(&stream, frame, sizeof(frame));
+        EXPECT_FALSE(crc16_verify_stream(&stream));
+    }
+}
+
+TEST(CRC16Test, Residue) {
+    uint8_t frame[7] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x00, 0x00};
+
+    for (int i = 0; i < CRC16_NONE_MODEL; i++) {
+        crc16_param_model_e model = (crc16_param_model_e)i;
+        uint16_t crc = crc16_calculate(model, frame, 5);
+        crc16_ctx_t ctx;
+        crc16_init(&ctx, model);
+        if (ctx.ref_in) {
+            frame[5] = crc & 0xFF; // Little-endian trailer
+            frame[6] = crc >> 8;
+        } else {
+            frame[5] = crc >> 8; // Big-endian trailer
+            frame[6] = crc & 0xFF;
+        }
+        EXPECT_EQ(crc16_calculate(model, frame, sizeof(frame)),
+                  crc16_residue(model));
+    }
+}
+
+TEST(CRC32Test, VerifyStream) {
+    uint8_t frame[11] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37};
+
+    for (int i = 0; i < CRC32_NONE_MODEL; i++) {
+        crc32_param_model_e model = (crc32_param_model_e)i;
+        crc32_pack_buf(model, frame, sizeof(frame));
+
+        crc32_stream_t stream;
+        crc32_verify_stream_init(&stream, model);
+        for (uint32_t j = 0; j < sizeof(frame); j += 3) {
+            EXPECT_FALSE(crc32_verify_stream(&stream));
+            uint32_t n = sizeof(frame) - j < 3 ? sizeof(frame) - j : 3;
+            crc32_verify_stream_update(&stream, frame + j, n);
+        }
+        EXPECT_TRUE(crc32_verify_stream(&stream));
+    }
+    EXPECT_EQ(crc32_residue(CRC32_MODEL), 0x2144DF1Cu);
+}
+
+static void collect_modbus_frame(void* arg, const crc16_modbus_frame_t* frame) {
+    auto* frames = static_cast<std::vector<crc16_modbus_frame_t>*>(arg);
+    frames->push_back(*frame);
+}
+
+TEST(CRC16ModbusTest, FramerFindsFramesInNoise) {
+    std::vector<uint8_t> stream;
+    std::vector<std::pair<uint64_t, uint16_t>> expected;
+    uint8_t read_req[8] = {0x11, 0x03, 0x00, 0x6B, 0x00, 0x03};
+    uint8_t write_req[15] = {0x11, 0x10, 0x00, 0x01, 0x00, 0x02, 0x04,
+                             0x00, 0x0A, 0x01, 0x02};
+    crc16_pack_buf(CRC16_MODBUS_MODEL, read_req, sizeof(read_req));
+    crc16_pack_buf(CRC16_MODBUS_MODEL, write_req, 13);
+
+    uint32_t seed = 1;
+    for (int i = 0; i < 50; i++) {
+        // Line noise between frames
+        for (int j = 0; j < i % 7; j++) {
+            seed = seed * 1103515245u + 12345u;
+            stream.push_back((uint8_t)(seed >> 16));
+        }
+        const uint8_t* frame = (i % 3 == 0) ? write_req : read_req;
+        uint16_t len = (i % 3 == 0) ? 13 : sizeof(read_req);
+        expected.emplace_back(stream.size(), len);
+        stream.insert(stream.end(), frame, frame + len);
+    }
+
+    crc16_modbus_framer_t* framer = new crc16_modbus_framer_t;
+    std::vector<crc16_modbus_frame_t> frames;
+    crc16_modbus_framer_init(framer, CRC16_MODBUS_REQUEST,
+                             collect_modbus_frame, &frames);
+    for (size_t off = 0; off < stream.size(); off += 5) {
+        size_t n = stream.size() - off < 5 ? stream.size() - off : 5;
+        crc16_modbus_framer_feed(framer, stream.data() + off, (uint32_t)n);
+    }
+
+    ASSERT_EQ(frames.size(), expected.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        EXPECT_EQ(frames[i].offset, expected[i].first);
+        EXPECT_EQ(frames[i].len, expected[i].second);
+    }
+    EXPECT_EQ(framer->dropped, 0u);
+    delete framer;
+}
+
+TEST(CRC16ModbusTest, FramerResponsesAndZeroCopy) {
+    uint8_t stream[] = {0x01, 0x03, 0x04, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00,
+                        0x01, 0x83, 0x02, 0x00, 0x00};
+    crc16_pack_buf(CRC16_MODBUS_MODEL, stream, 9);
+    crc16_pack_buf(CRC16_MODBUS_MODEL, stream + 9, 5);
+
+    crc16_modbus_framer_t* framer = new crc16_modbus_framer_t;
+    std::vector<crc16_modbus_frame_t> frames;
+    crc16_modbus_framer_init(framer, CRC16_MODBUS_BOTH, collect_modbus_frame,
+                             &frames);
+    crc16_modbus_framer_feed(framer, stream, sizeof(stream));
+
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].len, 9u);
+    EXPECT_EQ(frames[0].data, stream);
+    EXPECT_EQ(frames[1].offset, 9u);
+    EXPECT_EQ(frames[1].len, 5u);
+    EXPECT_EQ(frames[1].data, stream + 9);
+    EXPECT_EQ(framer->skipped, 0u);
+    delete framer;
+}
+
+TEST(CRCCorrectTest, SingleBitErrors) {
+    for (int i = 0; i < CRC16_NONE_MODEL; i++) {
+        crc16_param_model_e model = (crc16_param_model_e)i;
+        crc_correct_t corr;
+        // The DNP polynomial has a period of 151 bits: beyond it single-bit
+        // syndromes repeat, which the index reports as ambiguous
+        uint32_t max_len = model == CRC16_DNP_MODEL ? 18 : 64;
+        ASSERT_TRUE(crc16_correct_init(&corr, model, max_len, false));
+
+        uint8_t frame[18];
+        for (uint32_t j = 0; j < sizeof(frame); j++) {
+            frame[j] = (uint8_t)(j * 37 + i);
+        }
+        crc16_pack_buf(model, frame, sizeof(frame));
+        EXPECT_EQ(crc_correct_buf(&corr, frame, sizeof(frame)), 0);
+
+        for (uint32_t bit = 0; bit < sizeof(frame) * 8; bit++) {
+            uint8_t copy[sizeof(frame)];
+            memcpy(copy, frame, sizeof(frame));
+            copy[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+            EXPECT_EQ(crc_correct_buf(&corr, copy, sizeof(copy)), 1);
+            EXPECT_EQ(memcmp(copy, frame, sizeof(frame)), 0);
+        }
+        crc_correct_deinit(&corr);
+    }
+}
+
+TEST(CRCCorrectTest, DoubleBitErrors) {
+    for (int i = 0; i < CRC32_NONE_MODEL; i++) {
+        crc32_param_model_e model = (crc32_param_model_e)i;
+        crc_correct_t corr;
+        ASSERT_TRUE(crc32_correct_init(&corr, model, 24, true));
+
+        uint8_t frame[16];
+        for (uint32_t j = 0; j < sizeof(frame); j++) {
+            frame[j] = (uint8_t)(j * 11 + 3);
+        }
+        crc32_pack_buf(model, frame, sizeof(frame));
+
+        for (uint32_t a = 0; a < sizeof(frame) * 8; a += 5) {
+            for (uint32_t b = a + 1; b < sizeof(frame) * 8; b += 7) {
+                uint8_t copy[sizeof(frame)];
+                memcpy(copy, frame, sizeof(frame));
+                copy[a / 8] ^= (uint8_t)(1u << (a % 8));
+                copy[b / 8] ^= (uint8_t)(1u << (b % 8));
+                EXPECT_EQ(crc_correct_buf(&corr, copy, sizeof(copy)), 2);
+                EXPECT_EQ(memcmp(copy, frame, sizeof(frame)), 0);
+            }
+        }
+        crc_correct_deinit(&corr);
+    }
+}
+
+TEST(CRC16Test, BatchPackAndVerify) {
+    std::vector<std::vector<uint8_t>> frames(70);
+    std::vector<uint8_t*> bufs(frames.size());
+    std::vector<uint32_t> lens(frames.size());
+
+    for (uint32_t i = 0; i < frames.size(); i++) {
+        frames[i].resize(i % 23);
+        for (uint32_t j = 0; j < frames[i].size(); j++) {
+            frames[i][j] = (uint8_t)(i * 31 + j * 7);
+        }
+        bufs[i] = frames[i].data();
+        lens[i] = (uint32_t)frames[i].size();
+    }
+    bufs[5] = nullptr;
+
+    for (int m = 0; m < CRC16_NONE_MODEL; m++) {
+        crc16_param_model_e model = (crc16_param_model_e)m;
+        uint64_t ok[2];
+
+        crc16_pack_bufs(model, bufs.data(), lens.data(), (uint32_t)bufs.size());
+        for (uint32_t i = 0; i < bufs.size(); i += 3) {
+            if (lens[i] > 2 && bufs[i] != nullptr) {
+                bufs[i][i % (lens[i] - 2)] ^= 0x10; // Corrupt every third frame
+            }
+        }
+
+        uint32_t valid = crc16_verify_bufs(
+            model, (const uint8_t* const*)bufs.data(), lens.data(),
+            (uint32_t)bufs.size(), ok);
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < bufs.size(); i++) {
+            bool bit = (ok[i / 64] >> (i % 64)) & 1;
+            bool ref = crc16_verify_buf(model, bufs[i], lens[i]);
+            EXPECT_EQ(bit, ref);
+            EXPECT_EQ(ref, i % 3 != 0 && i != 5 && lens[i] > 2);
+            expected += ref;
+        }
+        EXPECT_EQ(valid, expected);
+        EXPECT_EQ(ok[1] >> (bufs.size() - 64), 0u);
+    }
+}
+
+TEST(CRC8Test, BatchPackAndVerify) {
+    uint8_t frames[9][12];
+    uint8_t* bufs[9];
+    uint32_t lens[9];
+
+    for (uint32_t i = 0; i < 9; i++) {
+        for (uint32_t j = 0; j < sizeof(frames[i]); j++) {
+            frames[i][j] = (uint8_t)(i + j * 13);
+        }
+        bufs[i] = frames[i];
+        lens[i] = 1 + i;
+    }
+
+    for (int m = 0; m < CRC8_NONE_MODEL; m++) {
+        crc8_param_model_e model = (crc8_param_model_e)m;
+        uint64_t ok;
+
+        crc8_pack_bufs(model, bufs, lens, 9);
+        frames[4][0] ^= 0x01;
+        EXPECT_EQ(crc8_verify_bufs(model, bufs, lens, 9, &ok), 7u);
+        EXPECT_EQ(ok, 0x1EEu);
+        for (uint32_t i = 1; i < 9; i++) {
+            EXPECT_EQ(crc8_verify_buf(model, bufs[i], lens[i]), i != 4);
+        }
+    }
+}
+
+TEST(CRC8Test, BatchManyFrames) {
+    std::vector<std::vector<uint8_t>> frames(300);
+    std::vector<uint8_t*> bufs(frames.size());
+    std::vector<uint32_t> lens(frames.size());
+
+    // Lengths around the 16-byte blocks the frames are transposed in
+    for (uint32_t i = 0; i < frames.size(); i++) {
+        frames[i].resize(20 + (i * 7) % 45);
+        for (uint32_t j = 0; j < frames[i].size(); j++) {
+            frames[i][j] = (uint8_t)(i * 31 + j * 7 + (j >> 3));
+        }
+        bufs[i] = frames[i].data();
+        lens[i] = (uint32_t)frames[i].size();
+    }
+
+    for (int m = 0; m < CRC8_NONE_MODEL; m++) {
+        crc8_param_model_e model = (crc8_param_model_e)m;
+        uint64_t ok[5];
+
+        crc8_pack_bufs(model, bufs.data(), lens.data(), (uint32_t)bufs.size());
+        for (uint32_t i = 0; i < bufs.size(); i++) {
+            uint8_t crc = crc8_calculate(model, bufs[i], lens[i] - 1);
+            ASSERT_EQ(bufs[i][lens[i] - 1], crc) << m << " " << i;
+        }
+        bufs[17][3] ^= 0x40;
+        EXPECT_EQ(crc8_verify_bufs(model, (const uint8_t* const*)bufs.data(),
+                                   lens.data(), (uint32_t)bufs.size(), ok),
+                  (uint32_t)bufs.size() - 1);
+        EXPECT_EQ(ok[0], ~((uint64_t)1 << 17));
+        bufs[17][3] ^= 0x40;
+    }
+
+    // Frames long enough to be folded, mixed with short ones in a group
+    for (uint32_t i = 0; i < frames.size(); i++) {
+        frames[i].resize(i % 3 == 0 ? 150 + i : 20 + i % 45);
+        for (uint32_t j = 0; j < frames[i].size(); j++) {
+            frames[i][j] = (uint8_t)(i * 17 + j * 5 + (j >> 4));
+        }
+        bufs[i] = frames[i].data();
+        lens[i] = (uint32_t)frames[i].size();
+    }
+    crc8_pack_bufs(CRC8_MODEL, bufs.data(), lens.data(),
+                   (uint32_t)bufs.size());
+    for (uint32_t i = 0; i < bufs.size(); i++) {
+        uint8_t crc = crc8_calculate(CRC8_MODEL, bufs[i], lens[i] - 1);
+        ASSERT_EQ(bufs[i][lens[i] - 1], crc) << i;
+    }
+
+    // Long buffers run as parallel segments when they are not folded
+    std::vector<uint8_t> data(5 * 4096 + 77);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 131 + (i >> 9));
+    }
+    uint32_t count;
+    const crc_model_t* models = crc_model_catalog(&count);
+    for (uint32_t m = 0; m < count; m++) {
+        crc_clmul_param_t param = {models[m].width, models[m].poly,
+                                   models[m].init,  models[m].xor_out,
+                                   models[m].ref_in, models[m].ref_out};
+        crc_clmul_ctx_t ctx;
+
+        // Updates below the crossover as the reference
+        crc_clmul_init(&ctx, &param);
+        for (uint32_t off = 0; off < data.size(); off += 100) {
+            crc_clmul_update(&ctx, data.data() + off,
+                             std::min(100u, (uint32_t)data.size() - off));
+        }
+        uint64_t expect = crc_clmul_final(&ctx);
+        EXPECT_EQ(crc_model_calculate(&models[m], data.data(),
+                                      (uint32_t)data.size()),
+                  expect)
+            << models[m].name;
+    }
+}
+
+TEST(CRC32Test, BatchPackAndVerify) {
+    uint8_t frames[6][40];
+    uint8_t* bufs[6];
+    uint32_t lens[6] = {40, 17, 33, 5, 4, 21};
+
+    for (uint32_t i = 0; i < 6; i++) {
+        for (uint32_t j = 0; j < sizeof(frames[i]); j++) {
+            frames[i][j] = (uint8_t)(i * 5 + j * 3);
+        }
+        bufs[i] = frames[i];
+    }
+
+    for (int m = 0; m < CRC32_NONE_MODEL; m++) {
+        crc32_param_model_e model = (crc32_param_model_e)m;
+        uint64_t ok;
+
+        crc32_pack_bufs(model, bufs, lens, 6);
+        for (uint32_t i = 0; i < 6; i++) {
+            if (lens[i] > 4) {
+                EXPECT_EQ(crc32_calculate(model, bufs[i], lens[i] - 4),
+                          (uint32_t)bufs[i][lens[i] - 4]
+                              | (uint32_t)bufs[i][lens[i] - 3] << 8
+                              | (uint32_t)bufs[i][lens[i] - 2] << 16
+                              | (uint32_t)bufs[i][lens[i] - 1] << 24);
+            }
+        }
+        frames[2][32] ^= 0x80;
+        EXPECT_EQ(crc32_verify_bufs(model, bufs, lens, 6, &ok), 4u);
+        EXPECT_EQ(ok, 0x2Bu);
+    }
+}
+
+TEST(CRC32ScrubTest, ReportsCorruptRecords) {
+    const uint32_t record_size = 512;
+    const uint32_t records = 5000;
+    std::vector<uint8_t> data(records * record_size + 100);
+
+    for (uint32_t i = 0; i < records; i++) {
+        uint8_t* record = &data[i * record_size];
+        for (uint32_t j = 0; j < record_size; j++) {
+            record[j] = (uint8_t)(i * 7 + j);
+        }
+        crc32_pack_buf(CRC32_MODEL, record, record_size);
+    }
+    const uint64_t corrupt[] = {0, 17, 2047, 2048, 4999};
+    for (uint64_t index : corrupt) {
+        data[index * record_size + 3] ^= 0x40;
+    }
+
+    crc32_scrub_cfg_t cfg = {CRC32_MODEL, record_size, 4};
+    crc32_scrub_report_t report;
+    ASSERT_TRUE(crc32_scrub_buf(&cfg, data.data(), data.size(), &report));
+    EXPECT_EQ(report.records, records);
+    EXPECT_EQ(report.tail, 100u);
+    ASSERT_EQ(report.bad_count, 5u);
+    for (uint32_t i = 0; i < 5; i++) {
+        EXPECT_EQ(report.bad[i], corrupt[i] * record_size);
+    }
+    crc32_scrub_report_free(&report);
+
+    const char* path = "crc32_scrub_test.bin";
+    FILE* fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+
+    cfg.threads = 0;
+    ASSERT_TRUE(crc32_scrub_file(&cfg, path, &report));
+    EXPECT_EQ(report.bytes, (uint64_t)records * record_size);
+    ASSERT_EQ(report.bad_count, 5u);
+    EXPECT_EQ(report.bad[3], 2048u * record_size);
+    EXPECT_GT(report.records_per_sec, 0.0);
+    crc32_scrub_report_free(&report);
+    remove(path);
+
+    EXPECT_FALSE(crc32_scrub_file(&cfg, "crc32_scrub_missing.bin", &report));
+}
+
+TEST(CRC32Test, Combine) {
+    uint8_t data[300];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    for (int m = 0; m < CRC32_NONE_MODEL; m++) {
+        crc32_param_model_e model = (crc32_param_model_e)m;
+        for (uint32_t split : {0u, 1u, 4u, 150u, 299u, 300u}) {
+            uint32_t crc1 = crc32_calculate(model, data, split);
+            uint32_t crc2 = crc32_calculate(model, data + split,
+                                            sizeof(data) - split);
+            EXPECT_EQ(crc32_combine(model, crc1, crc2, sizeof(data) - split),
+                      crc32_calculate(model, data, sizeof(data)));
+        }
+    }
+}
+
+TEST(CRC32SidecarTest, IncrementalUpdate) {
+    const char* path = "crc32_sidecar_test.bin";
+    const char* index_path = "crc32_sidecar_test.crcs";
+    std::vector<uint8_t> data(10000);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 13 + (i >> 8));
+    }
+    FILE* fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+
+    crc32_sidecar_t sc;
+    ASSERT_TRUE(crc32_sidecar_build(&sc, path, CRC32_MODEL, 1024));
+    EXPECT_EQ(sc.blocks, 10u);
+    EXPECT_FALSE(crc32_sidecar_stale(&sc, path));
+    EXPECT_EQ(crc32_sidecar_file_crc(&sc),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+
+    // Append, then rewrite a range in place
+    data.resize(13000, 0x5A);
+    fp = fopen(path, "ab");
+    fwrite(data.data() + 10000, 1, 3000, fp);
+    fclose(fp);
+    EXPECT_TRUE(crc32_sidecar_stale(&sc, path));
+    ASSERT_TRUE(crc32_sidecar_update(&sc, path, 0, 0));
+    EXPECT_EQ(sc.blocks, 13u);
+    EXPECT_EQ(crc32_sidecar_file_crc(&sc),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+
+    fp = fopen(path, "r+b");
+    fseek(fp, 5000, SEEK_SET);
+    fputc(data[5000] ^ 0xFF, fp);
+    fclose(fp);
+    data[5000] ^= 0xFF;
+    uint64_t bad[4];
+    uint64_t bad_count;
+    ASSERT_TRUE(crc32_sidecar_verify(&sc, path, bad, 4, &bad_count));
+    ASSERT_EQ(bad_count, 1u);
+    EXPECT_EQ(bad[0], 4u);
+    ASSERT_TRUE(crc32_sidecar_update(&sc, path, 5000, 1));
+    ASSERT_TRUE(crc32_sidecar_verify(&sc, path, bad, 4, &bad_count));
+    EXPECT_EQ(bad_count, 0u);
+
+    // Save and load, then corrupt the sidecar
+    ASSERT_TRUE(crc32_sidecar_save(&sc, index_path));
+    crc32_sidecar_t loaded;
+    ASSERT_TRUE(crc32_sidecar_load(&loaded, index_path));
+    EXPECT_EQ(loaded.file_size, 13000u);
+    EXPECT_EQ(loaded.mtime_ns, sc.mtime_ns);
+    EXPECT_EQ(crc32_sidecar_file_crc(&loaded),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    crc32_sidecar_deinit(&loaded);
+
+    fp = fopen(index_path, "r+b");
+    fseek(fp, 40, SEEK_SET);
+    fputc(0xAA, fp);
+    fclose(fp);
+    EXPECT_FALSE(crc32_sidecar_load(&loaded, index_path));
+
+    crc32_sidecar_deinit(&sc);
+    remove(path);
+    remove(index_path);
+}
+
+TEST(CRCManifestTest, CachedRebuild) {
+    namespace fs = std::filesystem;
+    const fs::path root = "crc_manifest_test";
+    const char* cache = "crc_manifest_test.cache";
+    const char* list = "crc_manifest_test.txt";
+    fs::remove_all(root);
+    fs::create_directories(root / "a" / "b");
+    fs::create_directories(root / "c");
+
+    const char* names[] = {"a/b/x.bin", "a/y.bin", "c/z.bin", "top.bin"};
+    std::vector<std::vector<uint8_t>> contents;
+    for (uint32_t i = 0; i < 4; i++) {
+        std::vector<uint8_t> data(1000 * i + 7);
+        for (uint32_t j = 0; j < data.size(); j++) {
+            data[j] = (uint8_t)(j * (i + 3));
+        }
+        FILE* fp = fopen((root / names[i]).string().c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        fwrite(data.data(), 1, data.size(), fp);
+        fclose(fp);
+        contents.push_back(data);
+    }
+
+    crc_manifest_cfg_t cfg = {32, CRC32_MODEL, 3, cache};
+    crc_manifest_t mf;
+    ASSERT_TRUE(crc_manifest_build(&mf, root.string().c_str(), &cfg));
+    ASSERT_EQ(mf.count, 4u);
+    EXPECT_EQ(mf.hashed, 4u);
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_STREQ(mf.entries[i].path, names[i]);
+        EXPECT_EQ(mf.entries[i].crc,
+                  crc32_calculate(CRC32_MODEL, contents[i].data(),
+                                  (uint32_t)contents[i].size()));
+    }
+    crc_manifest_deinit(&mf);
+
+    // Unchanged tree: everything comes from the cache
+    ASSERT_TRUE(crc_manifest_build(&mf, root.string().c_str(), &cfg));
+    EXPECT_EQ(mf.hashed, 0u);
+    EXPECT_EQ(mf.cached, 4u);
+    crc_manifest_deinit(&mf);
+
+    FILE* fp = fopen((root / "c/z.bin").string().c_str(), "ab");
+    fputc(0x42, fp);
+    fclose(fp);
+    contents[2].push_back(0x42);
+    ASSERT_TRUE(crc_manifest_build(&mf, root.string().c_str(), &cfg));
+    EXPECT_EQ(mf.hashed, 1u);
+    EXPECT_EQ(mf.cached, 3u);
+    EXPECT_EQ(mf.entries[2].crc,
+              crc32_calculate(CRC32_MODEL, contents[2].data(),
+                              (uint32_t)contents[2].size()));
+    crc_manifest_deinit(&mf);
+
+    // A cache of another model is ignored
+    cfg = {16, CRC16_MODBUS_MODEL, 0, cache};
+    ASSERT_TRUE(crc_manifest_build(&mf, root.string().c_str(), &cfg));
+    EXPECT_EQ(mf.hashed, 4u);
+    ASSERT_TRUE(crc_manifest_write(&mf, list));
+    char line[64] = {0};
+    fp = fopen(list, "rb");
+    ASSERT_NE(fp, nullptr);
+    ASSERT_NE(fgets(line, sizeof(line), fp), nullptr);
+    fclose(fp);
+    char expected[64];
+    snprintf(expected, sizeof(expected), "CRC16_MODBUS %04X  a/b/x.bin\n",
+             crc16_calculate(CRC16_MODBUS_MODEL, contents[0].data(),
+                             (uint32_t)contents[0].size()));
+    EXPECT_STREQ(line, expected);
+    crc_manifest_deinit(&mf);
+
+    // A record count the cache file cannot hold is not trusted: twice this
+    // one wraps around to 16, which 17 records would overflow
+    uint8_t head[16];
+    fp = fopen(cache, "rb");
+    ASSERT_NE(fp, nullptr);
+    ASSERT_EQ(fread(head, 1, sizeof(head), fp), sizeof(head));
+    fclose(fp);
+    const uint8_t huge[8] = {8, 0, 0, 0, 0, 0, 0, 0x80};
+    memcpy(head + 8, huge, sizeof(huge));
+    std::vector<uint8_t> records(17 * 28 + 4, 0);
+    fp = fopen(cache, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(head, 1, sizeof(head), fp);
+    fwrite(records.data(), 1, records.size(), fp);
+    fclose(fp);
+    ASSERT_TRUE(crc_manifest_build(&mf, root.string().c_str(), &cfg));
+    EXPECT_EQ(mf.hashed, 4u);
+    crc_manifest_deinit(&mf);
+
+    fs::remove_all(root);
+    remove(cache);
+    remove(list);
+}
+
+TEST(CRC32MerkleTest, DiffAndVerify) {
+    const char* path = "crc32_merkle_test.bin";
+    const char* copy_path = "crc32_merkle_test_copy.bin";
+    const char* tree_path = "crc32_merkle_test.crct";
+    std::vector<uint8_t> data(70000);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 29 + (i >> 9));
+    }
+    FILE* fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+    data[41000] ^= 0x10;
+    fp = fopen(copy_path, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+
+    crc32_merkle_t a, b;
+    ASSERT_TRUE(crc32_merkle_build(&a, path, CRC32_MODEL, 512, 4, 3));
+    ASSERT_TRUE(crc32_merkle_build(&b, copy_path, CRC32_MODEL, 512, 4, 0));
+    EXPECT_EQ(a.level_len[0], 137u);
+    EXPECT_EQ(a.levels, 5u);
+    EXPECT_EQ(crc32_merkle_flat_crc(&b),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    EXPECT_NE(crc32_merkle_root(&a), crc32_merkle_root(&b));
+
+    uint64_t blocks[4];
+    uint64_t count;
+    ASSERT_TRUE(crc32_merkle_diff(&a, &b, blocks, 4, &count));
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(blocks[0], 41000u / 512);
+
+    // The corrupt block only shows up in ranges that overlap it
+    ASSERT_TRUE(crc32_merkle_verify_range(&a, copy_path, 40000, 900, blocks,
+                                          4, &count));
+    EXPECT_EQ(count, 0u);
+    ASSERT_TRUE(crc32_merkle_verify_range(&a, copy_path, 40000, 30000,
+                                          blocks, 4, &count));
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(blocks[0], 41000u / 512);
+
+    // Save and load, then corrupt the tree file
+    ASSERT_TRUE(crc32_merkle_save(&a, tree_path));
+    crc32_merkle_t loaded;
+    ASSERT_TRUE(crc32_merkle_load(&loaded, tree_path));
+    EXPECT_EQ(crc32_merkle_root(&loaded), crc32_merkle_root(&a));
+    data[41000] ^= 0x10;
+    EXPECT_EQ(crc32_merkle_flat_crc(&loaded),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    crc32_merkle_deinit(&loaded);
+
+    fp = fopen(tree_path, "r+b");
+    fseek(fp, 100, SEEK_SET);
+    fputc(0xAA, fp);
+    fclose(fp);
+    EXPECT_FALSE(crc32_merkle_load(&loaded, tree_path));
+
+    crc32_merkle_deinit(&b);
+    crc32_merkle_deinit(&a);
+    remove(path);
+    remove(copy_path);
+    remove(tree_path);
+}
+
+TEST(CRCCheckpointTest, StateRoundTrip) {
+    uint8_t data[64];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    uint8_t state[CRC_STATE_SIZE];
+    uint64_t offset;
+
+    crc32_ctx_t ctx;
+    crc32_init(&ctx, CRC32_MODEL);
+    crc32_update(&ctx, data, 20);
+    crc32_state_export(&ctx, 20, state);
+    crc32_ctx_t resumed;
+    ASSERT_TRUE(crc32_state_import(&resumed, &offset, state));
+    EXPECT_EQ(offset, 20u);
+    crc32_update(&resumed, data + offset, sizeof(data) - offset);
+    EXPECT_EQ(crc32_final(&resumed),
+              crc32_calculate(CRC32_MODEL, data, sizeof(data)));
+
+    // The table of a lookup context is re-attached from its polynomial
+    crc16_lookup_ctx_t lookup;
+    crc16_lookup_init(&lookup, CRC16_DNP_LOOKUP_MODEL);
+    crc16_lookup_update(&lookup, data, 33);
+    crc16_lookup_state_export(&lookup, 33, state);
+    crc16_lookup_ctx_t lookup_resumed;
+    ASSERT_TRUE(crc16_lookup_state_import(&lookup_resumed, &offset, state));
+    EXPECT_EQ(lookup_resumed.table, lookup.table);
+    crc16_lookup_update(&lookup_resumed, data + offset, sizeof(data) - offset);
+    EXPECT_EQ(crc16_lookup_final(&lookup_resumed),
+              crc16_lookup_calculate(CRC16_DNP_LOOKUP_MODEL, data,
+                                     sizeof(data)));
+
+    // Wrong context type, then a corrupt state
+    crc16_ctx_t other;
+    EXPECT_FALSE(crc16_state_import(&other, &offset, state));
+    state[9] ^= 0x01;
+    EXPECT_FALSE(crc16_lookup_state_import(&lookup_resumed, &offset, state));
+}
+
+TEST(CRCCheckpointTest, ResumeFile) {
+    const char* path = "crc_checkpoint_test.bin";
+    const char* ckpt = "crc_checkpoint_test.ckpt";
+    std::vector<uint8_t> data(300000);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 31 + (i >> 10));
+    }
+    FILE* fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+    remove(ckpt);
+
+    // Stop early, as a crash after the last checkpoint would
+    crc_checkpoint_cfg_t cfg = {32, CRC32_MODEL, ckpt, 65536, 100000};
+    crc_checkpoint_result_t result;
+    ASSERT_TRUE(crc_checkpoint_file(path, &cfg, &result));
+    EXPECT_FALSE(result.complete);
+    EXPECT_EQ(result.offset, 100000u);
+    EXPECT_EQ(result.checkpoints, 2u);
+
+    // The checkpoint holds a plain context state
+    uint8_t state[CRC_STATE_SIZE];
+    uint64_t offset;
+    crc32_ctx_t ctx;
+    fp = fopen(ckpt, "rb");
+    ASSERT_NE(fp, nullptr);
+    ASSERT_EQ(fread(state, 1, sizeof(state), fp), sizeof(state));
+    fclose(fp);
+    ASSERT_TRUE(crc32_state_import(&ctx, &offset, state));
+    EXPECT_EQ(offset, 100000u);
+    crc32_update(&ctx, data.data() + offset, data.size() - offset);
+    EXPECT_EQ(crc32_final(&ctx),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+
+    cfg.max_bytes = 0;
+    ASSERT_TRUE(crc_checkpoint_file(path, &cfg, &result));
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.resumed_at, 100000u);
+    EXPECT_EQ(result.crc,
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    EXPECT_EQ(fopen(ckpt, "rb"), nullptr);
+
+    // A checkpoint of another model is not resumed from
+    cfg = {16, CRC16_MODBUS_MODEL, ckpt, 65536, 150000};
+    ASSERT_TRUE(crc_checkpoint_file(path, &cfg, &result));
+    cfg = {16, CRC16_X25_MODEL, ckpt, 0, 0};
+    ASSERT_TRUE(crc_checkpoint_file(path, &cfg, &result));
+    EXPECT_EQ(result.resumed_at, 0u);
+    EXPECT_EQ(result.crc,
+              crc16_calculate(CRC16_X25_MODEL, data.data(), data.size()));
+
+    remove(path);
+    remove(ckpt);
+}
+
+TEST(CRC32RangeTest, Query) {
+    const char* path = "crc32_range_test.bin";
+    const char* index_path = "crc32_range_test.crcr";
+    std::vector<uint8_t> data(100000);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 17 + (i >> 7));
+    }
+    FILE* fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+
+    crc32_range_t idx;
+    ASSERT_TRUE(crc32_range_build(&idx, path, CRC32_MODEL, 4096, 3));
+    EXPECT_EQ(idx.count, 100000u / 4096 + 1);
+    EXPECT_FALSE(crc32_range_stale(&idx, path));
+
+    const uint64_t ranges[][2] = {
+        {0, 100000}, {0, 4096},  {4096, 8192}, {1, 99998},
+        {5000, 300}, {4000, 200}, {12345, 0},  {99999, 1},
+    };
+    for (const auto& r : ranges) {
+        uint32_t crc;
+        ASSERT_TRUE(crc32_range_query(&idx, path, r[0], r[1], &crc));
+        EXPECT_EQ(crc, crc32_calculate(CRC32_MODEL, data.data() + r[0],
+                                       (uint32_t)r[1]))
+            << r[0] << "+" << r[1];
+    }
+    uint32_t crc;
+    EXPECT_FALSE(crc32_range_query(&idx, path, 99999, 2, &crc));
+
+    // Save and load, then corrupt the index
+    ASSERT_TRUE(crc32_range_save(&idx, index_path));
+    crc32_range_t loaded;
+    ASSERT_TRUE(crc32_range_load(&loaded, index_path));
+    ASSERT_TRUE(crc32_range_query(&loaded, path, 777, 55555, &crc));
+    EXPECT_EQ(crc, crc32_calculate(CRC32_MODEL, data.data() + 777, 55555));
+    crc32_range_deinit(&loaded);
+
+    fp = fopen(index_path, "r+b");
+    fseek(fp, 50, SEEK_SET);
+    fputc(0xAA, fp);
+    fclose(fp);
+    EXPECT_FALSE(crc32_range_load(&loaded, index_path));
+
+    crc32_range_deinit(&idx);
+    remove(path);
+    remove(index_path);
+}
+
+TEST(CRC32AssemblerTest, OutOfOrderChunks) {
+    std::vector<uint8_t> data(200003);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 37 + (i >> 11));
+    }
+    std::vector<std::pair<uint64_t, uint32_t>> chunks;
+    for (uint64_t at = 0, k = 1; at < data.size(); k++) {
+        uint32_t len = (uint32_t)((k * 7919) % 5000 + 1);
+        len = (uint32_t)std::min<uint64_t>(len, data.size() - at);
+        chunks.push_back({at, len});
+        at += len;
+    }
+    // Deliver in a scrambled order from several threads
+    for (size_t i = 0; i < chunks.size(); i++) {
+        std::swap(chunks[i], chunks[(i * 131 + 17) % chunks.size()]);
+    }
+
+    crc32_assembler_t as;
+    ASSERT_TRUE(
+        crc32_assembler_init(&as, CRC32_MODEL, CRC32_ASSEMBLER_TOTAL_UNKNOWN));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 8; t++) {
+        threads.emplace_back([&, t] {
+            for (size_t i = t; i < chunks.size(); i += 8) {
+                uint64_t at = chunks[i].first;
+                uint32_t len = chunks[i].second;
+                if (i % 2 == 0) {
+                    crc32_assembler_add(&as, at, data.data() + at, len);
+                } else {
+                    crc32_assembler_add_crc(
+                        &as, at, len,
+                        crc32_calculate(CRC32_MODEL, data.data() + at, len));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    uint32_t crc;
+    EXPECT_EQ(crc32_assembler_bytes(&as), data.size());
+    EXPECT_FALSE(crc32_assembler_result(&as, &crc));
+    ASSERT_TRUE(crc32_assembler_set_total(&as, data.size()));
+    ASSERT_TRUE(crc32_assembler_result(&as, &crc));
+    EXPECT_EQ(crc, crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    EXPECT_FALSE(crc32_assembler_add(&as, 0, data.data(), 1));
+    crc32_assembler_deinit(&as);
+
+    // Known length: the CRC is ready when the last gap closes
+    ASSERT_TRUE(crc32_assembler_init(&as, CRC32_MPEG2_MODEL, 1000));
+    ASSERT_TRUE(crc32_assembler_add(&as, 600, data.data() + 600, 400));
+    ASSERT_TRUE(crc32_assembler_add(&as, 0, data.data(), 250));
+    EXPECT_FALSE(crc32_assembler_result(&as, &crc));
+    EXPECT_FALSE(crc32_assembler_add(&as, 900, data.data() + 900, 101));
+    ASSERT_TRUE(crc32_assembler_add(&as, 250, data.data() + 250, 350));
+    ASSERT_TRUE(crc32_assembler_result(&as, &crc));
+    EXPECT_EQ(crc, crc32_calculate(CRC32_MPEG2_MODEL, data.data(), 1000));
+    crc32_assembler_deinit(&as);
+
+    // Long chunks: an overlap far from either start is still seen
+    ASSERT_TRUE(crc32_assembler_init(&as, CRC32_MODEL, data.size()));
+    ASSERT_TRUE(crc32_assembler_add(&as, 150000, data.data() + 150000, 1));
+    EXPECT_FALSE(crc32_assembler_add(&as, 10, data.data() + 10, 190000));
+    ASSERT_TRUE(crc32_assembler_add(&as, 150001, data.data() + 150001,
+                                    (uint32_t)data.size() - 150001));
+    EXPECT_FALSE(crc32_assembler_set_total(&as, 150000));
+    ASSERT_TRUE(crc32_assembler_add(&as, 0, data.data(), 150000));
+    ASSERT_TRUE(crc32_assembler_result(&as, &crc));
+    EXPECT_EQ(crc, crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    crc32_assembler_deinit(&as);
+}
+
+TEST(CRC32AssemblerTest, DuplicateAndGap) {
+    std::vector<uint8_t> data(300);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 29 + 3);
+    }
+    crc32_assembler_t as;
+    uint32_t crc;
+
+    // As many bytes as the stream, but [100, 200) never arrives
+    ASSERT_TRUE(crc32_assembler_init(&as, CRC32_MODEL, data.size()));
+    ASSERT_TRUE(crc32_assembler_add(&as, 0, data.data(), 100));
+    EXPECT_FALSE(crc32_assembler_add(&as, 0, data.data(), 100));
+    EXPECT_FALSE(crc32_assembler_add(&as, 50, data.data() + 50, 100));
+    ASSERT_TRUE(crc32_assembler_add(&as, 200, data.data() + 200, 100));
+    EXPECT_EQ(crc32_assembler_bytes(&as), 200u);
+    EXPECT_FALSE(crc32_assembler_result(&as, &crc));
+
+    // The rejected chunks left no trace in the CRC
+    ASSERT_TRUE(crc32_assembler_add_crc(
+        &as, 100, 100, crc32_calculate(CRC32_MODEL, data.data() + 100, 100)));
+    ASSERT_TRUE(crc32_assembler_result(&as, &crc));
+    EXPECT_EQ(crc, crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    crc32_assembler_deinit(&as);
+}
+
+TEST(CRC32RegionTest, DirtyPages) {
+    std::vector<uint8_t> data(1000003);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 11 + (i >> 12));
+    }
+
+    crc32_region_t region;
+    ASSERT_TRUE(crc32_region_init(&region, CRC32_MODEL, data.data(),
+                                  data.size(), 4096));
+    EXPECT_EQ(region.pages, 245u);
+    EXPECT_EQ(crc32_region_crc(&region),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    EXPECT_EQ(region.rehashed, 0u);
+
+    // Through the API, then in place followed by a mark; the last page is
+    // short
+    const uint8_t patch[] = {1, 2, 3, 4, 5, 6};
+    crc32_region_write(&region, 8190, patch, sizeof(patch));
+    data[999999] ^= 0xFF;
+    crc32_region_mark(&region, 999999, 1);
+    EXPECT_EQ(crc32_region_crc(&region),
+              crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    EXPECT_EQ(region.rehashed, 3u);
+    crc32_region_deinit(&region);
+}
+
+#if !defined(_WIN32)
+TEST(CRC32RegionTest, TrackedWrites) {
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t size = 37 * page;
+    uint8_t* data = (uint8_t*)aligned_alloc(page, size);
+    ASSERT_NE(data, nullptr);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = (uint8_t)(i * 3);
+    }
+
+    crc32_region_t region;
+    ASSERT_TRUE(crc32_region_init(&region, CRC32_MPEG2_MODEL, data, size,
+                                  (uint32_t)page));
+    ASSERT_TRUE(crc32_region_track(&region, true));
+    data[5 * page + 7] = 0x42;
+    data[36 * page] ^= 0x01;
+    data[36 * page + 1] ^= 0x01;
+    EXPECT_EQ(crc32_region_crc(&region),
+              crc32_calculate(CRC32_MPEG2_MODEL, data, (uint32_t)size));
+    EXPECT_EQ(region.rehashed, 2u);
+
+    // Pages are protected again after each refresh
+    data[5 * page + 8] = 0x43;
+    EXPECT_EQ(crc32_region_crc(&region),
+              crc32_calculate(CRC32_MPEG2_MODEL, data, (uint32_t)size));
+    EXPECT_EQ(region.rehashed, 1u);
+
+    crc32_region_deinit(&region);
+    data[0] = 0;
+
+    // A size ending inside a system page would protect bytes past the region
+    ASSERT_TRUE(crc32_region_init(&region, CRC32_MPEG2_MODEL, data, size - 1,
+                                  (uint32_t)page));
+    EXPECT_FALSE(crc32_region_track(&region, true));
+    crc32_region_deinit(&region);
+    free(data);
+}
+#endif
+
+TEST(CRCScrubberTest, Mismatches) {
+    const char* path = "scrubber_test.bin";
+    struct RemoveOnExit {
+        const char* path;
+        ~RemoveOnExit() { std::filesystem::remove(path); }
+    } remove_on_exit{path};
+    std::vector<uint8_t> data(300000);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 7 + (i >> 9));
+    }
+    FILE* fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    ASSERT_EQ(fwrite(data.data(), 1, data.size(), fp), data.size());
+    fclose(fp);
+
+    std::vector<uint32_t> bad;
+    crc_scrubber_cfg_t cfg = {};
+    cfg.slice = 4096;
+    cfg.arg = &bad;
+    cfg.on_mismatch = [](void* arg, uint32_t id, uint32_t, uint32_t) {
+        ((std::vector<uint32_t>*)arg)->push_back(id);
+    };
+    crc_scrubber_t scrubber;
+    ASSERT_TRUE(crc_scrubber_init(&scrubber, &cfg));
+
+    crc_scrubber_region_t mem = {};
+    mem.width = 32;
+    mem.model = CRC32_MODEL;
+    mem.buf = data.data();
+    mem.len = data.size();
+    mem.expected = crc32_calculate(CRC32_MODEL, data.data(), data.size());
+    crc_scrubber_region_t file = {};
+    file.width = 16;
+    file.model = CRC16_MODBUS_MODEL;
+    file.path = path;
+    file.offset = 1000;
+    file.len = 50000;
+    file.expected = crc16_calculate(CRC16_MODBUS_MODEL, &data[1000], 50000);
+    uint32_t mem_id, file_id;
+    ASSERT_TRUE(crc_scrubber_add(&scrubber, &mem, &mem_id));
+    ASSERT_TRUE(crc_scrubber_add(&scrubber, &file, &file_id));
+
+    EXPECT_EQ(crc_scrubber_step(&scrubber, 350000), 350000u);
+    EXPECT_TRUE(bad.empty());
+    data[123456] ^= 0x10;
+    EXPECT_EQ(crc_scrubber_step(&scrubber, 350000), 350000u);
+    ASSERT_EQ(bad.size(), 1u);
+    EXPECT_EQ(bad[0], mem_id);
+
+    crc_scrubber_stats_t stats;
+    crc_scrubber_stats(&scrubber, &stats);
+    EXPECT_EQ(stats.bytes, 700000u);
+    EXPECT_EQ(stats.passes, 4u);
+    EXPECT_EQ(stats.mismatches, 1u);
+    EXPECT_EQ(stats.errors, 0u);
+
+    // The worker keeps finding the corruption within its byte budget
+    ASSERT_TRUE(crc_scrubber_remove(&scrubber, file_id));
+    EXPECT_FALSE(crc_scrubber_remove(&scrubber, file_id));
+    scrubber.cfg.bytes_per_sec = 20000000;
+    scrubber.cfg.cpu_share = 0.5;
+    if (!crc_scrubber_start(&scrubber)) {
+        crc_scrubber_deinit(&scrubber);
+        GTEST_SKIP() << "No worker thread in a build without threads";
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    crc_scrubber_stop(&scrubber);
+    crc_scrubber_stats(&scrubber, &stats);
+    EXPECT_GT(bad.size(), 1u);
+    EXPECT_LT(stats.bytes - 700000u, 20000000u * 2 / 5);
+    EXPECT_GT(stats.throttled, 0.0);
+
+    crc_scrubber_deinit(&scrubber);
+}
+
+TEST(CRCMultiTest, MixedModels) {
+    std::vector<uint8_t> data(10007);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 13 + (i >> 8));
+    }
+
+    const crc_multi_model_t models[] = {
+        {16, CRC16_MODBUS_MODEL}, {32, CRC32_MODEL},
+        {16, CRC16_XMODEM_MODEL}, {8, CRC8_MODEL},
+        {32, CRC32_MPEG2_MODEL},  {8, CRC8_MAXIM_MODEL},
+    };
+    crc_multi_t multi;
+    ASSERT_TRUE(crc_multi_init(&multi, models, 6));
+
+    // Fed in uneven chunks, so words straddle the calls
+    uint32_t crcs[6];
+    for (uint32_t pos = 0, n = 1; pos < data.size(); pos += n, n += 37) {
+        n = std::min<uint32_t>(n, (uint32_t)data.size() - pos);
+        crc_multi_update(&multi, &data[pos], n);
+    }
+    crc_multi_final(&multi, crcs);
+    EXPECT_EQ(crcs[0], crc16_calculate(CRC16_MODBUS_MODEL, data.data(),
+                                       data.size()));
+    EXPECT_EQ(crcs[1], crc32_calculate(CRC32_MODEL, data.data(), data.size()));
+    EXPECT_EQ(crcs[2], crc16_calculate(CRC16_XMODEM_MODEL, data.data(),
+                                       data.size()));
+    EXPECT_EQ(crcs[3], crc8_calculate(CRC8_MODEL, data.data(), data.size()));
+    EXPECT_EQ(crcs[4], crc32_calculate(CRC32_MPEG2_MODEL, data.data(),
+                                       data.size()));
+    EXPECT_EQ(crcs[5], crc8_calculate(CRC8_MAXIM_MODEL, data.data(),
+                                      data.size()));
+
+    crc_multi_calculate(&multi, data.data(), 5, crcs);
+    EXPECT_EQ(crcs[1], crc32_calculate(CRC32_MODEL, data.data(), 5));
+
+    const crc_multi_model_t bad = {16, CRC16_NONE_MODEL};
+    crc_multi_t other;
+    EXPECT_FALSE(crc_multi_init(&other, &bad, 1));
+    crc_multi_deinit(&multi);
+}
+
+TEST(CRCMultiTest, SharedPolynomials) {
+    std::vector<uint8_t> data(4099);
+    for (uint32_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 29 + 3);
+    }
+
+    // Every CRC16 and CRC8 model: 9 + 4 models on 7 raw registers
+    std::vector<crc_multi_model_t> models;
+    for (uint8_t m = 0; m < CRC16_NONE_MODEL; m++) {
+        models.push_back({16, m});
+    }
+    for (uint8_t m = 0; m < CRC8_NONE_MODEL; m++) {
+        models.push_back({8, m});
+    }
+    crc_multi_t multi;
+    ASSERT_TRUE(crc_multi_init(&multi, models.data(), models.size()));
+
+    for (uint32_t len : {0u, 1u, 9u, 4099u}) {
+        uint32_t crcs[CRC_MULTI_MAX];
+        crc_multi_calculate(&multi, data.data(), len, crcs);
+        for (uint8_t m = 0; m < CRC16_NONE_MODEL; m++) {
+            EXPECT_EQ(crcs[m], crc16_calculate((crc16_param_model_e)m,
+                                               data.data(), len))
+                << "CRC16 model " << (int)m << ", length " << len;
+        }
+        // crc8_calculate returns 0 for empty buffers
+        for (uint8_t m = 0; m < CRC8_NONE_MODEL && len != 0; m++) {
+            EXPECT_EQ(crcs[CRC16_NONE_MODEL + m],
+                      crc8_calculate((crc8_param_model_e)m, data.data(), len))
+                << "CRC8 model " << (int)m << ", length " << len;
+        }
+    }
+    crc_multi_deinit(&multi);
+}
+
+TEST(CRCModelTest, Catalog) {
+    uint32_t count;
+    const crc_model_t* models = crc_model_catalog(&count);
+    const uint8_t check[] = "123456789";
+    uint32_t library = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const crc_model_t* m = &models[i];
+
+        EXPECT_EQ(crc_model_calculate(m, check, 9), m->check) << m->name;
+        EXPECT_EQ(crc_model_find(m->name), m);
+        if (m->model == CRC_MODEL_NONE) {
+            continue;
+        }
+        library++;
+        if (m->width == 8) {
+            EXPECT_EQ(crc8_calculate((crc8_param_model_e)m->model, check, 9),
+                      m->check);
+        } else if (m->width == 16) {
+            EXPECT_EQ(crc16_calculate((crc16_param_model_e)m->model, check, 9),
+                      m->check);
+        } else {
+            EXPECT_EQ(crc32_calculate((crc32_param_model_e)m->model, check, 9),
+                      m->check);
+        }
+    }
+    EXPECT_EQ(library, (uint32_t)CRC8_NONE_MODEL + CRC16_NONE_MODEL
+                           + CRC32_NONE_MODEL);
+    EXPECT_EQ(crc_model_find("CRC-16/UNKNOWN"), nullptr);
+}
+
+TEST(CRCClassifyTest, Layouts) {
+    const crc_model_t* genibus = crc_model_find("CRC-16/GENIBUS");
+    const crc_model_t* iscsi = crc_model_find("CRC-32/ISCSI");
+    ASSERT_NE(genibus, nullptr);
+    ASSERT_NE(iscsi, nullptr);
+
+    // Sync byte, payload, big-endian CRC16; payload, little-endian CRC32,
+    // end delimiter
+    std::vector<std::vector<uint8_t>> a, b;
+    for (uint32_t f = 0; f < 200; f++) {
+        std::vector<uint8_t> frame(1 + 5 + f % 23, 0x7E);
+        for (uint32_t i = 1; i < frame.size(); i++) {
+            frame[i] = (uint8_t)(f * 31 + i * 7 + (f >> 3));
+        }
+        uint32_t crc = crc_model_calculate(genibus, &frame[1],
+                                           frame.size() - 1);
+        frame.push_back((uint8_t)(crc >> 8));
+        frame.push_back((uint8_t)crc);
+        a.push_back(frame);
+
+        frame.assign(3 + f % 41, 0);
+        for (uint32_t i = 0; i < frame.size(); i++) {
+            frame[i] = (uint8_t)(f * 13 + i * 5 + 1);
+        }
+        crc = crc_model_calculate(iscsi, frame.data(), frame.size());
+        for (int i = 0; i < 4; i++) {
+            frame.push_back((uint8_t)(crc >> (8 * i)));
+        }
+        frame.push_back(0x0D);
+        b.push_back(frame);
+    }
+
+    crc_classify_cfg_t cfg = {};
+    cfg.skip_max = 2;
+    cfg.tail_max = 2;
+    crc_classify_match_t match[4];
+    for (auto* frames : {&a, &b}) {
+        std::vector<const uint8_t*> bufs;
+        std::vector<uint32_t> lens;
+        for (auto& frame : *frames) {
+            bufs.push_back(frame.data());
+            lens.push_back(frame.size());
+        }
+
+        ASSERT_EQ(crc_classify(&cfg, bufs.data(), lens.data(), bufs.size(),
+                               match, 4),
+                  1u);
+        EXPECT_EQ(match[0].model, frames == &a ? genibus : iscsi);
+        EXPECT_EQ(match[0].skip, frames == &a ? 1 : 0);
+        EXPECT_EQ(match[0].tail, frames == &a ? 0 : 1);
+        EXPECT_EQ(match[0].big_endian, frames == &a);
+        EXPECT_EQ(match[0].matched, 200u);
+
+        // A corrupted frame is tolerated on request only
+        frames->at(7)[2] ^= 1;
+        bufs[7] = frames->at(7).data();
+        EXPECT_EQ(crc_classify(&cfg, bufs.data(), lens.data(), bufs.size(),
+                               match, 4),
+                  0u);
+        cfg.max_failures = 1;
+        EXPECT_EQ(crc_classify(&cfg, bufs.data(), lens.data(), bufs.size(),
+                               match, 4),
+                  1u);
+        EXPECT_EQ(match[0].matched, 199u);
+        cfg.max_failures = 0;
+    }
+}
+
+TEST(CRCRevengTest, RecoverModels) {
+    const crc_model_t custom = {nullptr, 16,   CRC_MODEL_NONE, 0x2F15, 0x1234,
+                                0xBEEF,  true, true,           0};
+    std::vector<std::vector<uint8_t>> msgs;
+    for (uint32_t i = 0; i < 8; i++) {
+        std::vector<uint8_t> msg(i < 4 ? 20 : 9 + i * 3);
+        for (uint32_t k = 0; k < msg.size(); k++) {
+            msg[k] = (uint8_t)(i * 97 + k * 13 + (k >> 2) * i);
+        }
+        msgs.push_back(msg);
+    }
+
+    std::vector<crc_reveng_sample_t> samples;
+    for (auto& msg : msgs) {
+        samples.push_back({msg.data(), (uint32_t)msg.size(),
+                           crc_model_calculate(&custom, msg.data(),
+                                               msg.size())});
+    }
+    crc_reveng_cfg_t cfg = {};
+    cfg.width = 16;
+    crc_model_t found[4];
+    ASSERT_EQ(crc_reveng(&cfg, samples.data(), samples.size(), found, 4), 1u);
+    EXPECT_EQ(found[0].name, nullptr);
+    EXPECT_EQ(found[0].poly, 0x2F15u);
+    EXPECT_EQ(found[0].init, 0x1234u);
+    EXPECT_EQ(found[0].xor_out, 0xBEEFu);
+    EXPECT_TRUE(found[0].ref_in && found[0].ref_out);
+
+    // The descriptor drives the library directly
+    crc16_ctx_t ctx16;
+    ASSERT_TRUE(crc16_init_model(&ctx16, &found[0]));
+    crc16_update(&ctx16, msgs[5].data(), msgs[5].size());
+    EXPECT_EQ(crc16_final(&ctx16), samples[5].crc);
+    EXPECT_FALSE(crc32_init_model(nullptr, &found[0]));
+
+    // Catalogue models come back by name
+    for (auto& sample : samples) {
+        sample.crc = crc32_calculate(CRC32_MODEL, sample.buf, sample.len);
+    }
+    cfg.width = 32;
+    ASSERT_EQ(crc_reveng(&cfg, samples.data(), samples.size(), found, 4), 1u);
+    EXPECT_STREQ(found[0].name, "CRC-32/ISO-HDLC");
+    EXPECT_EQ(found[0].model, CRC32_MODEL);
+
+    // Polynomials divisible by x + 1 leave the init and xor_out ambiguous
+    for (auto& sample : samples) {
+        sample.crc = crc16_calculate(CRC16_MODBUS_MODEL, sample.buf,
+                                     sample.len);
+    }
+    cfg.width = 16;
+    ASSERT_EQ(crc_reveng(&cfg, samples.data(), samples.size(), found, 4), 1u);
+    EXPECT_STREQ(found[0].name, "CRC-16/MODBUS");
+    EXPECT_EQ(found[0].model, CRC16_MODBUS_MODEL);
+    for (auto& sample : samples) {
+        sample.crc = crc16_calculate(CRC16_X25_MODEL, sample.buf, sample.len);
+    }
+    ASSERT_EQ(crc_reveng(&cfg, samples.data(), samples.size(), found, 4), 1u);
+    EXPECT_STREQ(found[0].name, "CRC-16/IBM-SDLC");
+    EXPECT_EQ(found[0].model, CRC16_X25_MODEL);
+
+    // One pair leaves a GCD of high degree: its divisors are searched for
+    const crc_model_t* t10 = crc_model_find("CRC-16/T10-DIF");
+    ASSERT_NE(t10, nullptr);
+    for (auto& sample : samples) {
+        sample.crc = crc_model_calculate(t10, sample.buf, sample.len);
+    }
+    samples.erase(samples.begin() + 2, samples.begin() + 4);
+    cfg.width = 16;
+    uint32_t count = crc_reveng(&cfg, samples.data(), samples.size(), found,
+                                4);
+    ASSERT_GE(count, 1u);
+    bool seen = false;
+    for (uint32_t i = 0; i < std::min(count, 4u); i++) {
+        seen = seen || (found[i].name != nullptr
+                        && strcmp(found[i].name, "CRC-16/T10-DIF") == 0);
+    }
+    EXPECT_TRUE(seen);
+}
+
+TEST(CRCHdTest, PublishedTables) {
+    // Longest data lengths in bits by HD, from Koopman's CRC tables
+    struct {
+        const char* name;
+        uint32_t max_len;
+        uint8_t weight_max;
+        std::vector<uint32_t> len; // HD 3, 4, ...
+    } cases[] = {
+        {"CRC-8/SMBUS", 256, 4, {119, 119, 0}},
+        {"CRC-8/MAXIM-DOW", 256, 4, {119, 119, 0}},
+        {"CRC-16/ARC", 40000, 4, {32751, 32751, 0}},
+        {"CRC-16/XMODEM", 40000, 4, {32751, 32751, 0}},
+        {"CRC-16/DNP", 40000, 6, {135, 135, 135, 135, 6}},
+        {"CRC-32/ISO-HDLC", 100000, 7, {100000, 91607, 2974, 268, 171, 91}},
+    };
+
+    for (const auto& c : cases) {
+        const crc_model_t* model = crc_model_find(c.name);
+        ASSERT_NE(model, nullptr);
+        crc_hd_cfg_t cfg = {};
+        cfg.width = model->width;
+        cfg.poly = model->poly;
+        cfg.max_len = c.max_len;
+        cfg.weight_max = c.weight_max;
+        crc_hd_table_t table;
+        ASSERT_TRUE(crc_hd_analyze(&cfg, &table)) << c.name;
+        EXPECT_EQ(table.len[2], c.max_len);
+        for (uint32_t i = 0; i < c.len.size(); i++) {
+            EXPECT_EQ(table.len[i + 3], c.len[i]) << c.name << " HD" << i + 3;
+        }
+    }
+
+    crc_hd_cfg_t cfg = {};
+    cfg.width = 32;
+    cfg.poly = 0x04C11DB7;
+    cfg.max_len = 12112; // 1514-byte Ethernet frame
+    cfg.weight_max = 5;
+    cfg.threads = 3;
+    crc_hd_table_t table;
+    ASSERT_TRUE(crc_hd_analyze(&cfg, &table));
+    EXPECT_EQ(crc_hd_at(&table, 12112), 4);
+    EXPECT_EQ(crc_hd_at(&table, 2974), 5);
+    EXPECT_EQ(crc_hd_at(&table, 268), 6);
+    EXPECT_EQ(crc_hd_at(&table, 100), 6); // At least 6
+
+    cfg.poly = 0x04C11DB6; // No x^0 term
+    EXPECT_FALSE(crc_hd_analyze(&cfg, &table));
+}
+
+TEST(GF2PolyTest, Arithmetic) {
+    // Reference: a * b by shifting a one power of x at a time
+    auto ref_mulmod = [](uint64_t a, uint64_t b, uint64_t poly, uint8_t w) {
+        uint64_t top = (uint64_t)1 << (w - 1);
+        uint64_t r = 0;
+        for (uint8_t i = 0; i < w; i++) {
+            if ((b >> i) & 1) {
+                r ^= a;
+            }
+            a = (a & top) ? ((a << 1) ^ poly) & (top | (top - 1)) : a << 1;
+        }
+        return r;
+    };
+    uint64_t seed = 0x9E3779B97F4A7C15u;
+    auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+
+    for (uint32_t i = 0; i < 4096; i++) {
+        uint8_t w = (uint8_t)(1 + i % 64);
+        uint64_t mask = w == 64 ? ~(uint64_t)0 : ((uint64_t)1 << w) - 1;
+        uint64_t poly = (next() & mask) | 1;
+        uint64_t a = next() & mask;
+        uint64_t b = next() & mask;
+        uint64_t expect = ref_mulmod(a, b, poly, w);
+        gf2poly_barrett_t barrett;
+        gf2poly_barrett_init(&barrett, poly, w);
+        ASSERT_EQ(gf2poly_mulmod(a, b, poly, w), expect) << (int)w;
+        ASSERT_EQ(gf2poly_barrett_mulmod(&barrett, a, b), expect) << (int)w;
+        uint64_t hi;
+        uint64_t lo;
+        gf2poly_clmul(a, b, &hi, &lo);
+        ASSERT_EQ(gf2poly_barrett_reduce(&barrett, hi, lo), expect) << (int)w;
+
+        uint64_t x = w > 1 ? 2 : 1;
+        ASSERT_EQ(gf2poly_mulmod(gf2poly_xinv(poly, w), x, poly, w), 1u);
+    }
+
+    // Powers of x: cached, uncached and one step at a time
+    gf2poly_powers_t powers;
+    gf2poly_powers_init(&powers, 2, 0x04C11DB7, 32);
+    uint64_t x = 1;
+    for (uint64_t n = 0; n < 1000; n++) {
+        ASSERT_EQ(gf2poly_xpow(n, 0x04C11DB7, 32), x);
+        ASSERT_EQ(gf2poly_powers_get(&powers, n), x);
+        x = ref_mulmod(x, 2, 0x04C11DB7, 32);
+    }
+    EXPECT_EQ(gf2poly_xpow8n(123456789, 0x04C11DB7, 32),
+              crc32_combine_gen(CRC32_MODEL, 123456789));
+    EXPECT_EQ(gf2poly_powers_mul(&powers, 0x1234, 8 * 100),
+              gf2poly_mulmod(0x1234, gf2poly_xpow8n(100, 0x04C11DB7, 32),
+                             0x04C11DB7, 32));
+
+    // x^(2^64 - 1) = 1 modulo an irreducible polynomial of degree 64
+    EXPECT_EQ(gf2poly_xpow(UINT64_MAX, 0x1B, 64), 1u);
+    EXPECT_NE(gf2poly_xpow(UINT64_MAX / 3, 0x1B, 64), 1u);
+}
+
+TEST(CRCClmulTest, CustomModels) {
+    static const char check[] = "123456789";
+    const uint8_t* chk = (const uint8_t*)check;
+    crc_clmul_param_t xz = {64, 0x42F0E1EBA9EA3693u, ~(uint64_t)0,
+                            ~(uint64_t)0, true, true};
+    crc_clmul_param_t openpgp = {24, 0x864CFB, 0xB704CE, 0, false, false};
+    crc_clmul_param_t usb5 = {5, 0x05, 0x1F, 0x1F, true, true};
+    crc_clmul_param_t bad = {65, 0x07, 0, 0, false, false};
+
+    EXPECT_EQ(crc_clmul_calculate(&xz, chk, 9), 0x995DC9BBDF1939FAu);
+    EXPECT_EQ(crc_clmul_calculate(&openpgp, chk, 9), 0x21CF02u);
+    EXPECT_EQ(crc_clmul_calculate(&usb5, chk, 9), 0x19u);
+    EXPECT_EQ(crc_clmul_calculate(&bad, chk, 9), 0u);
+
+    // Reference: bit by bit on an MSB-first register
+    auto reflect = [](uint64_t v, uint8_t w) {
+        uint64_t r = 0;
+        for (uint8_t i = 0; i < w; i++) {
+            r = (r << 1) | ((v >> i) & 1);
+        }
+        return r;
+    };
+    auto ref_crc = [&reflect](const crc_clmul_param_t& p, const uint8_t* buf,
+                              uint32_t len) {
+        uint64_t top = (uint64_t)1 << (p.width - 1);
+        uint64_t mask = top | (top - 1);
+        uint64_t reg = p.init;
+        for (uint32_t i = 0; i < len; i++) {
+            uint8_t b = p.ref_in ? (uint8_t)reflect(buf[i], 8) : buf[i];
+            for (int j = 7; j >= 0; j--) {
+                bool in = ((b >> j) & 1) != ((reg & top) != 0);
+                reg = (reg << 1) & mask;
+                if (in) {
+                    reg ^= p.poly;
+                }
+            }
+        }
+        if (p.ref_out) {
+            reg = reflect(reg, p.width);
+        }
+        return reg ^ p.xor_out;
+    };
+    std::vector<uint8_t> data(4099);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 131 + (i >> 5));
+    }
+
+    // Lengths across the crossover, every fold-by-4 and fold-by-1 remainder
+    for (uint32_t i = 0; i < 64; i++) {
+        uint8_t w = (uint8_t)(1 + (i * 37) % 64);
+        uint64_t mask = w == 64 ? ~(uint64_t)0 : ((uint64_t)1 << w) - 1;
+        crc_clmul_param_t p = {w, (0x9E3779B97F4A7C15u * (i + 1)) & mask,
+                               (0xC2B2AE3D27D4EB4Fu * i) & mask,
+                               (0x165667B19E3779F9u * i) & mask, (i & 1) != 0,
+                               (i & 2) != 0};
+        p.poly |= 1;
+        for (uint32_t len : {0u, 1u, 127u, 128u, 143u, 200u, 1000u, 4099u}) {
+            ASSERT_EQ(crc_clmul_calculate(&p, data.data(), len),
+                      ref_crc(p, data.data(), len))
+                << (int)w << " " << i << " " << len;
+        }
+    }
+
+    // Catalogue models: whole, and in chunks around the crossover
+    uint32_t count;
+    const crc_model_t* models = crc_model_catalog(&count);
+    for (uint32_t m = 0; m < count; m++) {
+        crc_clmul_ctx_t ctx;
+        uint32_t expect = crc_model_calculate(&models[m], data.data(),
+                                              (uint32_t)data.size());
+
+        ASSERT_TRUE(crc_clmul_init_model(&ctx, &models[m]));
+        crc_clmul_update(&ctx, chk, 9);
+        EXPECT_EQ(crc_clmul_final(&ctx), models[m].check) << models[m].name;
+
+        crc_clmul_reset(&ctx);
+        crc_clmul_update(&ctx, data.data(), (uint32_t)data.size());
+        EXPECT_EQ(crc_clmul_final(&ctx), expect) << models[m].name;
+
+        crc_clmul_reset(&ctx);
+        for (uint32_t off = 0, n = 1; off < data.size(); off += n, n += 61) {
+            n = std::min<uint32_t>(n, (uint32_t)data.size() - off);
+            crc_clmul_update(&ctx, data.data() + off, n);
+        }
+        EXPECT_EQ(crc_clmul_final(&ctx), expect) << models[m].name;
+    }
+}
+
+TEST(CRCTierTest, EveryTierMatchesBitwise) {
+    // The tiers allowed for every width
+    crc_tier_report_t reports[CRC_TIER_COUNT];
+    uint32_t count = crc_tier_report(8, reports, 0.0);
+    count = std::min(count, crc_tier_report(16, reports, 0.0));
+    count = std::min(count, crc_tier_report(32, reports, 0.0));
+    ASSERT_GE(count, 1u);
+    uint8_t data[300];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 151 + (i >> 3));
+    }
+
+    for (uint32_t t = 0; t < count; t++) {
+        // Switch tiers mid-stream: the running CRC is kept
+        crc_tier_e tier = reports[t].tier;
+        crc_tier_e next = tier == CRC_TIER_NIBBLE ? reports[count - 1].tier
+                                                  : CRC_TIER_NIBBLE;
+
+        for (uint32_t len = 0; len < 70; len += 3) {
+            for (int m = 0; m < CRC8_NONE_LOOKUP_MODEL; m++) {
+                crc8_lookup_ctx_t lookup;
+                crc8_lookup_init(&lookup, (crc8_lookup_param_model_e)m);
+                crc8_ctx_t ctx = {lookup.init, lookup.xor_out, lookup.poly,
+                                  lookup.ref_in, lookup.ref_out};
+                ASSERT_TRUE(crc8_lookup_set_tier(&lookup, tier));
+                crc8_update(&ctx, data, len);
+                crc8_lookup_update(&lookup, data, len / 2);
+                ASSERT_TRUE(crc8_lookup_set_tier(&lookup, next));
+                crc8_lookup_update(&lookup, data + len / 2, len - len / 2);
+                EXPECT_EQ(crc8_lookup_final(&lookup), crc8_final(&ctx))
+                    << tier << " " << m << " " << len;
+            }
+            for (int m = 0; m < CRC16_NONE_LOOKUP_MODEL; m++) {
+                crc16_lookup_ctx_t lookup;
+                crc16_lookup_init(&lookup, (crc16_lookup_param_model_e)m);
+                crc16_ctx_t ctx = {lookup.init, lookup.xor_out, lookup.poly,
+                                   lookup.ref_in, lookup.ref_out};
+                ASSERT_TRUE(crc16_lookup_set_tier(&lookup, tier));
+                crc16_update(&ctx, data, len);
+                crc16_lookup_update(&lookup, data, len / 2);
+                ASSERT_TRUE(crc16_lookup_set_tier(&lookup, next));
+                crc16_lookup_update(&lookup, data + len / 2, len - len / 2);
+                EXPECT_EQ(crc16_lookup_final(&lookup), crc16_final(&ctx))
+                    << tier << " " << m << " " << len;
+            }
+            for (int m = 0; m < CRC32_NONE_LOOKUP_MODEL; m++) {
+                crc32_lookup_ctx_t lookup;
+                crc32_lookup_init(&lookup, (crc32_lookup_param_model_e)m);
+                crc32_ctx_t ctx = {lookup.init, lookup.xor_out, lookup.poly,
+                                   lookup.ref_in, lookup.ref_out};
+                ASSERT_TRUE(crc32_lookup_set_tier(&lookup, tier));
+                crc32_update(&ctx, data, len);
+                crc32_lookup_update(&lookup, data, len / 2);
+                ASSERT_TRUE(crc32_lookup_set_tier(&lookup, next));
+                crc32_lookup_update(&lookup, data + len / 2, len - len / 2);
+                EXPECT_EQ(crc32_lookup_final(&lookup), crc32_final(&ctx))
+                    << tier << " " << m << " " << len;
+            }
+        }
+    }
+
+    // Not a tier, and a model without a table
+    crc16_lookup_ctx_t lookup;
+    crc16_lookup_init(&lookup, CRC16_IBM_LOOKUP_MODEL);
+    EXPECT_FALSE(crc16_lookup_set_tier(&lookup, (crc_tier_e)2));
+    if (count < CRC_TIER_COUNT) {
+        EXPECT_FALSE(crc16_lookup_set_tier(&lookup, CRC_TIER_SLICE16));
+    }
+    crc16_lookup_init(&lookup, CRC16_NONE_LOOKUP_MODEL);
+    EXPECT_FALSE(crc16_lookup_set_tier(&lookup, CRC_TIER_BYTE));
+}
+
+TEST(CRCTierTest, ReportAndCheckpoint) {
+    crc_tier_report_t reports[CRC_TIER_COUNT];
+
+    EXPECT_EQ(crc_tier_report(24, reports, 0.0), 0u);
+    // Up to the largest tier of the build, the nibble tier by default
+    uint32_t count = crc_tier_report(16, reports, 0.0);
+    ASSERT_EQ(count, 1u + (CRC16_LOOKUP_SLICE_MAX >= 1)
+                         + (CRC16_LOOKUP_SLICE_MAX >= 4)
+                         + (CRC16_LOOKUP_SLICE_MAX >= 8)
+                         + (CRC16_LOOKUP_SLICE_MAX >= 16));
+    EXPECT_EQ(reports[0].tier, CRC_TIER_NIBBLE);
+    EXPECT_EQ(reports[0].table_bytes, 32u);
+    EXPECT_EQ(reports[count - 1].tier, (crc_tier_e)CRC16_LOOKUP_SLICE_MAX);
+    EXPECT_EQ(reports[count - 1].bytes_per_sec, 0.0);
+    if (count > 1) {
+        EXPECT_EQ(reports[1].table_bytes, 512u);
+    }
+    // 3 polynomials by 2 bit orders by as many tables
+    for (uint32_t i = 0; i < count; i++) {
+        EXPECT_EQ(reports[i].static_bytes,
+                  3u * 2 * CRC16_LOOKUP_SLICE_MAX * 512);
+    }
+    EXPECT_EQ(crc_tier_table_bytes(16, CRC_TIER_SLICE8), 4096u);
+    EXPECT_EQ(crc_tier_table_bytes(32, CRC_TIER_SLICE8), 8192u);
+    EXPECT_EQ(crc_tier_table_bytes(32, CRC_TIER_SLICE16), 16384u);
+
+    count = crc_tier_report(32, reports, 0.05);
+    ASSERT_GE(count, 1u);
+    EXPECT_EQ(reports[0].static_bytes, 2u * CRC32_LOOKUP_SLICE_MAX * 1024);
+    for (uint32_t i = 0; i < count; i++) {
+        EXPECT_GT(reports[i].bytes_per_sec, 0.0) << reports[i].tier;
+    }
+
+    // The tier of a lookup context survives a checkpoint
+    uint8_t data[40];
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    uint8_t state[CRC_STATE_SIZE];
+    uint64_t offset;
+    crc32_lookup_ctx_t lookup;
+    crc32_lookup_init(&lookup, CRC32_MPEG2_LOOKUP_MODEL);
+    ASSERT_TRUE(crc32_lookup_set_tier(&lookup, reports[count - 1].tier));
+    crc32_lookup_update(&lookup, data, 13);
+    crc32_lookup_state_export(&lookup, 13, state);
+    crc32_lookup_ctx_t resumed;
+    ASSERT_TRUE(crc32_lookup_state_import(&resumed, &offset, state));
+    EXPECT_EQ(resumed.table, lookup.table);
+    EXPECT_EQ(resumed.table_len, lookup.table_len);
+    crc32_lookup_update(&resumed, data + offset, sizeof(data) - offset);
+    EXPECT_EQ(crc32_lookup_final(&resumed),
+              crc32_lookup_calculate(CRC32_MPEG2_LOOKUP_MODEL, data,
+                                     sizeof(data)));
+}
+
 /* Private functions -------------------------------------------------------- */
 
 /* ----------------------------- end of file -------------------------------- */